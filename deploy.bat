@@ -1,4 +1,5 @@
 @echo off
+python web\gen_web_assets.py
 arduino-cli compile --upload -p COM8 --fqbn adafruit:samd:adafruit_matrixportal_m4 .
 if %errorlevel% equ 0 (
     echo Upload successful! Starting monitor...
@@ -7,7 +7,9 @@ enum AnimationType {
   ANIMATION_SOLID_COLOR = 1,
   ANIMATION_PATTERN = 2,
   ANIMATION_SCROLLING_TEXT = 3,
-  ANIMATION_TRUCK = 4
+  ANIMATION_TRUCK = 4,
+  ANIMATION_STREAM = 5,         // Frames pushed over the network, see frame_stream.h
+  ANIMATION_PIXELS = 6          // DDP / E1.31 from a lighting controller over the whole panel, see pixel_receiver.h
 };
 
 // Legacy enum for compatibility (can be removed later)
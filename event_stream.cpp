@@ -0,0 +1,247 @@
+#include "event_stream.h"
+#include "matrix_display.h"
+#include "widgets.h"
+#include "wifi_manager.h"
+#include "token_manager.h"
+#include "profiler.h"
+#include <FreeRTOS_SAMD51.h>
+
+struct EventStream {
+  bool active;
+  bool needsEverything;         // Opened since the last service
+  WiFiClient client;
+};
+
+// The settings and status the page shows, compared field by field
+struct LiveState {
+  int widget;
+  int animation;
+  String text;
+  bool weatherDebug;
+  String weatherDebugInfo;
+  bool spotifyAuthorized;
+  bool teamsAuthorized;
+  String wifi;
+};
+
+static EventStream streams[EVENT_STREAM_MAX_CLIENTS];
+static LiveState sentState;
+static bool topicPending[EVENT_TOPIC_COUNT];
+static String sentTopic[EVENT_TOPIC_COUNT];    // Last data sent per topic, to skip unchanged refetches
+static uint32_t lastMetrics = 0;
+static uint32_t lastFrameCount = 0;
+static uint32_t lastShownFrameCount = 0;
+
+static const char *const topicNames[EVENT_TOPIC_COUNT] = {"weather", "spotify", "teams"};
+
+static String jsonString(const String &text) {
+  String quoted = "\"";
+  for (unsigned int i = 0; i < text.length(); i++) {
+    char c = text.charAt(i);
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if ((uint8_t)c < 0x20) {
+      char escaped[7];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      quoted += escaped;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+static const char *jsonBool(bool value) {
+  return value ? "true" : "false";
+}
+
+static void readLiveState(LiveState &state) {
+  state.widget = currentWidget;
+  state.animation = currentAnimation;
+  state.text = displayText;
+  state.weatherDebug = isWeatherDebugMode();
+  state.weatherDebugInfo = state.weatherDebug ? getDebugWeatherInfo() : String();
+  state.spotifyAuthorized = tokenConfigured(TOKEN_SPOTIFY);
+  state.teamsAuthorized = tokenConfigured(TOKEN_MS_GRAPH);
+  state.wifi = getWiFiStatusString(wifiStatus);
+}
+
+static void appendKey(String &json, const char *key, const String &value) {
+  json += json.length() > 1 ? ",\"" : "\"";
+  json += key;
+  json += "\":";
+  json += value;
+}
+
+// The fields of state that differ from before, or all of them without one.
+// "{}" when nothing changed.
+static String stateJson(const LiveState &state, const LiveState *before) {
+  String json = "{";
+  if (!before || state.widget != before->widget) appendKey(json, "widget", String(state.widget));
+  if (!before || state.animation != before->animation) appendKey(json, "animation", String(state.animation));
+  if (!before || state.text != before->text) appendKey(json, "text", jsonString(state.text));
+  if (!before || state.weatherDebug != before->weatherDebug) appendKey(json, "weatherDebug", jsonBool(state.weatherDebug));
+  if (!before || state.weatherDebugInfo != before->weatherDebugInfo) appendKey(json, "weatherDebugInfo", jsonString(state.weatherDebugInfo));
+  if (!before || state.spotifyAuthorized != before->spotifyAuthorized) appendKey(json, "spotifyAuthorized", jsonBool(state.spotifyAuthorized));
+  if (!before || state.teamsAuthorized != before->teamsAuthorized) appendKey(json, "teamsAuthorized", jsonBool(state.teamsAuthorized));
+  if (!before || state.wifi != before->wifi) appendKey(json, "wifi", jsonString(state.wifi));
+  return json + "}";
+}
+
+String liveStateJson() {
+  LiveState state;
+  readLiveState(state);
+  return stateJson(state, nullptr);
+}
+
+// The working copies belong to the network task, which is where this runs
+static String topicJson(EventTopic topic) {
+  String json = "{";
+  switch (topic) {
+    case EVENT_TOPIC_WEATHER:
+      appendKey(json, "valid", jsonBool(currentWeather.dataValid));
+      appendKey(json, "location", jsonString(currentWeather.location));
+      appendKey(json, "temperature", String(currentWeather.temperature));
+      appendKey(json, "condition", jsonString(currentWeather.condition));
+      appendKey(json, "humidity", String(currentWeather.humidity));
+      appendKey(json, "wind", jsonString(String(currentWeather.windSpeed) + " " + currentWeather.windDirection));
+      break;
+    case EVENT_TOPIC_SPOTIFY:
+      appendKey(json, "valid", jsonBool(currentSpotifyTrack.dataValid));
+      appendKey(json, "track", jsonString(currentSpotifyTrack.trackName));
+      appendKey(json, "artist", jsonString(currentSpotifyTrack.artistName));
+      appendKey(json, "playing", jsonBool(currentSpotifyTrack.isPlaying));
+      appendKey(json, "progressMs", String(currentSpotifyTrack.progressMs));
+      appendKey(json, "durationMs", String(currentSpotifyTrack.durationMs));
+      break;
+    case EVENT_TOPIC_TEAMS:
+      appendKey(json, "status", jsonString(currentTeams.status));
+      appendKey(json, "details", jsonString(currentTeams.details));
+      break;
+    default:
+      break;
+  }
+  return json + "}";
+}
+
+static String metricsJson(uint32_t now) {
+  uint32_t frames = profileFrameCount();
+  uint32_t shown = profileShownFrameCount();
+  float seconds = lastMetrics ? (now - lastMetrics) / 1000.0f : 0;
+
+  String json = "{";
+  appendKey(json, "fps", String(seconds > 0 ? (frames - lastFrameCount) / seconds : 0.0f, 1));
+  appendKey(json, "shownFps", String(seconds > 0 ? (shown - lastShownFrameCount) / seconds : 0.0f, 1));
+  appendKey(json, "freeHeap", String((unsigned long)xPortGetFreeHeapSize()));
+  appendKey(json, "rssi", String((long)WiFi.RSSI()));
+  appendKey(json, "uptimeMs", String((unsigned long)now));
+
+  lastFrameCount = frames;
+  lastShownFrameCount = shown;
+  return json + "}";
+}
+
+// One event to one stream; a short write means the peer is gone
+static void sendEvent(EventStream &stream, const char *name, const String &data) {
+  String message = "event: ";
+  message += name;
+  message += "\ndata: ";
+  message += data;
+  message += "\n\n";
+  if (stream.client.write((const uint8_t *)message.c_str(), message.length()) != message.length()) {
+    stream.client.stop();
+    stream.active = false;
+  }
+}
+
+static void broadcast(const char *name, const String &data, bool includeNew) {
+  for (EventStream &stream : streams) {
+    if (stream.active && (includeNew || !stream.needsEverything)) sendEvent(stream, name, data);
+  }
+}
+
+void markEventTopic(EventTopic topic) {
+  topicPending[topic] = true;
+}
+
+bool openEventStream(WiFiClient &client) {
+  for (EventStream &stream : streams) {
+    if (stream.active) continue;
+
+    // The browser reconnects by itself after retry ms if the stream drops
+    static const char header[] =
+        "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-store\r\n"
+        "Connection: keep-alive\r\n\r\nretry: 3000\n\n";
+    client.write((const uint8_t *)header, sizeof(header) - 1);
+
+    stream.active = true;
+    stream.needsEverything = true;
+    stream.client = client;
+    Serial.println("Event stream opened");
+    return true;
+  }
+  return false;
+}
+
+bool eventStreamOwns(WiFiClient &client) {
+  for (EventStream &stream : streams) {
+    if (stream.active && stream.client == client) return true;
+  }
+  return false;
+}
+
+void serviceEventStreams() {
+  bool anyOpen = false;
+  bool anyNew = false;
+  for (EventStream &stream : streams) {
+    if (stream.active && !stream.client.connected()) {
+      stream.client.stop();
+      stream.active = false;
+      Serial.println("Event stream closed");
+    }
+    anyOpen |= stream.active;
+    anyNew |= stream.active && stream.needsEverything;
+  }
+
+  // Nothing is built while nobody listens; a new stream starts from everything anyway
+  if (!anyOpen) {
+    for (bool &pending : topicPending) pending = false;
+    return;
+  }
+
+  LiveState state;
+  readLiveState(state);
+  String delta = stateJson(state, &sentState);
+  if (delta.length() > 2) broadcast("state", delta, false);
+  sentState = state;
+
+  for (int topic = 0; topic < EVENT_TOPIC_COUNT; topic++) {
+    if (!topicPending[topic] && !anyNew) continue;
+    topicPending[topic] = false;
+    String data = topicJson((EventTopic)topic);
+    if (data != sentTopic[topic]) {
+      broadcast(topicNames[topic], data, false);
+      sentTopic[topic] = data;
+    }
+  }
+
+  uint32_t now = millis();
+  if (anyNew || now - lastMetrics >= EVENT_METRICS_INTERVAL_MS) {
+    String metrics = metricsJson(now);
+    lastMetrics = now;
+    broadcast("metrics", metrics, false);
+    if (anyNew) {
+      String everything = stateJson(state, nullptr);
+      for (EventStream &stream : streams) {
+        if (!stream.active || !stream.needsEverything) continue;
+        sendEvent(stream, "state", everything);
+        for (int topic = 0; topic < EVENT_TOPIC_COUNT && stream.active; topic++) {
+          sendEvent(stream, topicNames[topic], sentTopic[topic]);
+        }
+        if (stream.active) sendEvent(stream, "metrics", metrics);
+        stream.needsEverything = false;
+      }
+    }
+  }
+}
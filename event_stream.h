@@ -0,0 +1,42 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#include <WiFiNINA.h>
+
+// Server-Sent Events for the control page. GET /events keeps its socket open
+// and the page gets a full picture once, then only what changed:
+//
+//   state    - settings, weather debug and WiFi; only the keys that changed
+//   weather, spotify, teams
+//            - a widget's data, when a fetch published something different
+//   metrics  - frame rates, heap and signal every EVENT_METRICS_INTERVAL_MS,
+//              which also shows a dead peer before long
+//
+// Everything runs on the network task from handleWebClients().
+
+#define EVENT_STREAM_MAX_CLIENTS 2
+#define EVENT_METRICS_INTERVAL_MS 5000
+
+enum EventTopic : uint8_t {
+  EVENT_TOPIC_WEATHER,
+  EVENT_TOPIC_SPOTIFY,
+  EVENT_TOPIC_TEAMS,
+  EVENT_TOPIC_COUNT
+};
+
+// A widget's working copy was published; streams send it on the next service
+void markEventTopic(EventTopic topic);
+
+// Answers GET /events and keeps the socket. False when every slot is taken,
+// with nothing sent.
+bool openEventStream(WiFiClient &client);
+
+bool eventStreamOwns(WiFiClient &client);
+
+// Sends whatever changed since the last call and drops closed streams
+void serviceEventStreams();
+
+// Every state key in one object, as /state.json serves it
+String liveStateJson();
+
+#endif
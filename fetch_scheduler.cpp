@@ -0,0 +1,172 @@
+#include "fetch_scheduler.h"
+#include "http_pool.h"
+#include "ms_graph_auth.h"
+
+// Background fetches may keep the radio busy for this share of wall time,
+// banked up to a cap so a quiet spell can pay for a burst after boot
+#define RADIO_BUDGET_PERCENT 10
+#define RADIO_BUDGET_CAP_MS 20000
+#define FETCH_JITTER_PERCENT 10
+#define FETCH_RETRY_MS 5000         // After an update that couldn't start a request
+
+// Per-source bookkeeping, starting out as never fetched
+struct FetchState {
+  uint32_t nextDue = 0;
+  uint32_t lastFetch = 0;       // When the last response arrived
+  bool scheduled = false;       // nextDue is set
+  bool fetched = false;         // lastFetch is set
+};
+
+struct FetchSource {
+  const char *name;
+  WidgetType widget;
+  uint32_t visibleIntervalMs;
+  uint32_t backgroundIntervalMs;
+  uint32_t ttlMs;               // Older data is refreshed as soon as the widget is shown
+  bool (*configured)();
+  bool (*update)();             // False when it couldn't start a request
+
+  FetchState state;
+};
+
+static bool alwaysConfigured() {
+  return true;
+}
+
+static FetchSource sources[] = {
+  {"weather", WIDGET_WEATHER, 600000, 1200000, 1800000, alwaysConfigured, updateWeatherData, {}},
+  {"teams", WIDGET_TEAMS, 30000, 120000, 300000, isMsGraphConfigured, updateTeamsData, {}},
+  {"spotify", WIDGET_SPOTIFY, 30000, 60000, 120000, isSpotifyConfigured, updateSpotifyData, {}},
+  {"stocks", WIDGET_STOCKS, 60000, 300000, 600000, alwaysConfigured, updateStockData, {}},
+};
+
+static WidgetType visibleWidget = WIDGET_NONE;
+static int32_t radioBudgetMs = RADIO_BUDGET_CAP_MS;
+static uint32_t lastBudgetUpdate = 0;
+static uint32_t lastAirtimeMs = 0;
+
+static bool isDue(const FetchSource &source, uint32_t now) {
+  return !source.state.scheduled || (int32_t)(now - source.state.nextDue) >= 0;
+}
+
+static uint32_t jittered(uint32_t intervalMs) {
+  long spread = intervalMs / 100 * FETCH_JITTER_PERCENT;
+  return intervalMs + random(-spread, spread + 1);
+}
+
+// The data only counts as fresh once fetchSchedulerFetched() reports the
+// response. An update that couldn't start (request still in flight, no token,
+// WiFi down, host backing off) is tried again shortly.
+static void startFetch(FetchSource &source, uint32_t now, bool visible) {
+  bool started = source.update();
+  source.state.scheduled = true;
+  if (started) {
+    source.state.nextDue = now + jittered(visible ? source.visibleIntervalMs : source.backgroundIntervalMs);
+  } else {
+    source.state.nextDue = now + FETCH_RETRY_MS;
+  }
+}
+
+// Earn budget with wall time, pay for the airtime every request actually used
+static void updateRadioBudget(uint32_t now) {
+  uint32_t airtime = httpAirtimeMs();
+  radioBudgetMs -= (int32_t)(airtime - lastAirtimeMs);
+  lastAirtimeMs = airtime;
+
+  uint32_t earned = (now - lastBudgetUpdate) / 100 * RADIO_BUDGET_PERCENT;
+  lastBudgetUpdate = now;
+  radioBudgetMs += (int32_t)min(earned, (uint32_t)RADIO_BUDGET_CAP_MS);
+  if (radioBudgetMs > RADIO_BUDGET_CAP_MS) radioBudgetMs = RADIO_BUDGET_CAP_MS;
+}
+
+void runFetchScheduler(WidgetType visible) {
+  uint32_t now = millis();
+  visibleWidget = visible;
+  updateRadioBudget(now);
+
+  // The visible widget's source is never held back by the budget
+  FetchSource *shown = nullptr;
+  for (FetchSource &source : sources) {
+    if (source.widget == visible) shown = &source;
+  }
+  if (shown && shown->configured() && isDue(*shown, now)) {
+    startFetch(*shown, now, true);
+  }
+
+  if (radioBudgetMs <= 0) return;
+
+  // One background source per call, the longest overdue first
+  FetchSource *next = nullptr;
+  uint32_t mostOverdue = 0;
+  for (FetchSource &source : sources) {
+    if (&source == shown || !source.configured() || !isDue(source, now)) continue;
+    uint32_t overdue = source.state.scheduled ? now - source.state.nextDue : UINT32_MAX;
+    if (!next || overdue > mostOverdue) {
+      next = &source;
+      mostOverdue = overdue;
+    }
+  }
+  if (next) {
+    startFetch(*next, now, false);
+  }
+}
+
+void fetchSchedulerShowWidget(WidgetType widget) {
+  uint32_t now = millis();
+  visibleWidget = widget;
+  for (FetchSource &source : sources) {
+    if (source.widget != widget) continue;
+
+    FetchState &state = source.state;
+    if (!state.fetched || now - state.lastFetch > source.ttlMs) {
+      state.nextDue = now;
+    } else if ((int32_t)(state.nextDue - (state.lastFetch + source.visibleIntervalMs)) > 0) {
+      state.nextDue = state.lastFetch + source.visibleIntervalMs;   // Switch to the visible cadence
+    }
+    state.scheduled = true;
+  }
+}
+
+void fetchSchedulerDueIn(WidgetType widget, uint32_t delayMs) {
+  for (FetchSource &source : sources) {
+    if (source.widget != widget) continue;
+    if (widget != visibleWidget) delayMs = max(delayMs, source.backgroundIntervalMs);
+    source.state.nextDue = millis() + delayMs;
+    source.state.scheduled = true;
+  }
+}
+
+void fetchSchedulerDueNow(WidgetType widget) {
+  for (FetchSource &source : sources) {
+    if (source.widget != widget) continue;
+    source.state.nextDue = millis();
+    source.state.scheduled = true;
+  }
+}
+
+void fetchSchedulerFetched(WidgetType widget) {
+  for (FetchSource &source : sources) {
+    if (source.widget != widget) continue;
+    source.state.lastFetch = millis();
+    source.state.fetched = true;
+  }
+}
+
+void printFetchSchedule(Print &out) {
+  uint32_t now = millis();
+  out.println("# fetch source configured age_ms next_ms");
+  for (const FetchSource &source : sources) {
+    out.print("fetch ");
+    out.print(source.name);
+    out.print(source.configured() ? " 1 " : " 0 ");
+    if (source.state.fetched) {
+      out.print((unsigned long)(now - source.state.lastFetch));
+    } else {
+      out.print('-');
+    }
+    out.print(' ');
+    out.println(source.state.scheduled ? (long)(int32_t)(source.state.nextDue - now) : 0L);
+  }
+  out.print("radio_budget_ms ");
+  out.println((long)radioBudgetMs);
+}
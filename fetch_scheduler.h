@@ -0,0 +1,35 @@
+#ifndef FETCH_SCHEDULER_H
+#define FETCH_SCHEDULER_H
+
+#include <Arduino.h>
+#include "widgets.h"
+
+// Keeps every configured widget data source warm, not just the one on screen,
+// so switching widgets shows recent data straight away. Each source refreshes
+// on its own interval (shorter while visible), with jitter so fetches don't
+// line up. Data older than its TTL is refreshed as soon as its widget is
+// shown. Background refreshes share a radio-time budget, and the visible
+// widget's source always goes first.
+
+// Call from the network task; starts at most one background fetch per call
+void runFetchScheduler(WidgetType visible);
+
+// The widget on screen changed: refresh its source now if the data is stale
+void fetchSchedulerShowWidget(WidgetType widget);
+
+// For sources that know when their data will change next: fetch after delayMs
+// instead of the fixed interval. Off screen the background interval is the floor.
+void fetchSchedulerDueIn(WidgetType widget, uint32_t delayMs);
+
+// Fetch on the next scheduler pass even off screen, e.g. once new tokens
+// arrive. Background fetches still wait for the radio-time budget
+void fetchSchedulerDueNow(WidgetType widget);
+
+// A source's response arrived and was used: its data is fresh as of now.
+// Call from the response handler
+void fetchSchedulerFetched(WidgetType widget);
+
+// One line per source: age of the last fetch and time until the next one
+void printFetchSchedule(Print &out);
+
+#endif
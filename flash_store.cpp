@@ -0,0 +1,324 @@
+#include "flash_store.h"
+#include <Adafruit_SPIFlash.h>
+
+#define STORE_SECTOR_SIZE 4096
+#define STORE_SECTORS 8
+#define STORE_MAGIC 0x5653504D          // "MPSV"
+#define STORE_HEADER_SIZE 8             // Sector and record headers alike
+#define STORE_COPY_CHUNK 64
+
+// First bytes of every sector in use. Sequence numbers only grow, so replaying
+// sectors in sequence order replays the log in write order.
+struct SectorHeader {
+  uint32_t magic;
+  uint32_t sequence;
+};
+
+// Followed by the value, padded to a multiple of 4 bytes. The CRC covers the
+// key, the length and the value.
+struct RecordHeader {
+  uint8_t key;                  // 0xFF: erased, end of the sector's records
+  uint8_t reserved;
+  uint16_t length;
+  uint32_t crc;
+};
+
+struct KeyState {
+  bool stored;
+  uint32_t address;             // Value of the newest valid record
+  uint16_t length;
+  uint32_t crc;
+
+  uint8_t *pending;             // Queued value not written yet
+  uint16_t pendingLength;
+  uint32_t pendingCrc;
+  uint32_t dueAt;
+};
+
+static Adafruit_FlashTransport_QSPI flashTransport;
+static Adafruit_SPIFlash flash(&flashTransport);
+
+static bool ready = false;
+static uint32_t regionStart = 0;
+static uint32_t sequences[STORE_SECTORS];  // 0 for an erased sector
+static int head = -1;                      // Sector being appended to; the one after it is kept erased
+static uint32_t headOffset = 0;
+static KeyState keys[STORE_KEY_LIMIT];
+
+static uint32_t recordsWritten = 0;
+static uint32_t sectorErases = 0;
+static uint32_t writesSaved = 0;
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t length) {
+  crc = ~crc;
+  while (length--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static uint32_t recordCrc(uint8_t key, uint16_t length) {
+  uint8_t prefix[3] = {key, (uint8_t)length, (uint8_t)(length >> 8)};
+  return crc32Update(0, prefix, sizeof(prefix));
+}
+
+static uint32_t recordSize(uint16_t length) {
+  return STORE_HEADER_SIZE + ((length + 3u) & ~3u);
+}
+
+static uint32_t sectorAddress(int sector) {
+  return regionStart + sector * STORE_SECTOR_SIZE;
+}
+
+static void eraseSector(int sector) {
+  flash.eraseSector(sectorAddress(sector) / STORE_SECTOR_SIZE);
+  flash.waitUntilReady();
+  sequences[sector] = 0;
+  sectorErases++;
+}
+
+static bool sectorBlank(int sector) {
+  uint8_t chunk[STORE_COPY_CHUNK];
+  for (uint32_t offset = 0; offset < STORE_SECTOR_SIZE; offset += sizeof(chunk)) {
+    flash.readBuffer(sectorAddress(sector) + offset, chunk, sizeof(chunk));
+    for (uint8_t byte : chunk) {
+      if (byte != 0xFF) return false;
+    }
+  }
+  return true;
+}
+
+// Indexes the valid records of one sector; returns where the next one goes
+static uint32_t scanSector(int sector) {
+  uint32_t base = sectorAddress(sector);
+  uint32_t offset = STORE_HEADER_SIZE;
+
+  while (offset + STORE_HEADER_SIZE <= STORE_SECTOR_SIZE) {
+    RecordHeader record;
+    flash.readBuffer(base + offset, (uint8_t *)&record, sizeof(record));
+    if (record.key == 0xFF) return offset;
+
+    uint32_t size = recordSize(record.length);
+    if (record.length > STORE_VALUE_MAX || offset + size > STORE_SECTOR_SIZE) {
+      return STORE_SECTOR_SIZE;   // Torn header: nothing after it can be trusted
+    }
+
+    uint32_t crc = recordCrc(record.key, record.length);
+    uint8_t chunk[STORE_COPY_CHUNK];
+    for (uint32_t done = 0; done < record.length; done += sizeof(chunk)) {
+      uint32_t n = min((uint32_t)sizeof(chunk), record.length - done);
+      flash.readBuffer(base + offset + STORE_HEADER_SIZE + done, chunk, n);
+      crc = crc32Update(crc, chunk, n);
+    }
+
+    // A record that fails its CRC was cut short; the key keeps its older value
+    if (crc == record.crc && record.key < STORE_KEY_LIMIT) {
+      KeyState &state = keys[record.key];
+      state.stored = true;
+      state.address = base + offset + STORE_HEADER_SIZE;
+      state.length = record.length;
+      state.crc = crc;
+    }
+    offset += size;
+  }
+  return offset;
+}
+
+// Appends a record to the head sector, which must have room for it
+static void writeRecord(uint8_t key, uint16_t length, uint32_t crc, const uint8_t *data, uint32_t sourceAddress) {
+  uint32_t address = sectorAddress(head) + headOffset;
+  RecordHeader record = {key, 0xFF, length, crc};
+  flash.writeBuffer(address, (const uint8_t *)&record, sizeof(record));
+
+  if (data) {
+    flash.writeBuffer(address + STORE_HEADER_SIZE, data, length);
+  } else {
+    // Copy from elsewhere in flash
+    uint8_t chunk[STORE_COPY_CHUNK];
+    for (uint32_t done = 0; done < length; done += sizeof(chunk)) {
+      uint32_t n = min((uint32_t)sizeof(chunk), length - done);
+      flash.readBuffer(sourceAddress + done, chunk, n);
+      flash.writeBuffer(address + STORE_HEADER_SIZE + done, chunk, n);
+    }
+  }
+
+  KeyState &state = keys[key];
+  state.stored = true;
+  state.address = address + STORE_HEADER_SIZE;
+  state.length = length;
+  state.crc = crc;
+  headOffset += recordSize(length);
+  recordsWritten++;
+}
+
+// Moves the values whose newest record is in sector to the head, then erases it
+static void evacuate(int sector) {
+  uint32_t start = sectorAddress(sector);
+  for (uint8_t key = 0; key < STORE_KEY_LIMIT; key++) {
+    KeyState &state = keys[key];
+    if (!state.stored || state.address < start || state.address >= start + STORE_SECTOR_SIZE) continue;
+
+    if (headOffset + recordSize(state.length) > STORE_SECTOR_SIZE) {
+      Serial.print("Flash store full, dropping key ");
+      Serial.println(key);
+      state.stored = false;
+      continue;
+    }
+    writeRecord(key, state.length, state.crc, nullptr, state.address);
+  }
+  eraseSector(sector);
+}
+
+static void startSector(int sector, uint32_t sequence) {
+  SectorHeader header = {STORE_MAGIC, sequence};
+  flash.writeBuffer(sectorAddress(sector), (const uint8_t *)&header, sizeof(header));
+  sequences[sector] = sequence;
+  head = sector;
+  headOffset = STORE_HEADER_SIZE;
+}
+
+// Continue in the spare sector, then free the oldest one to be the next spare
+static void rotate() {
+  startSector((head + 1) % STORE_SECTORS, sequences[head] + 1);
+
+  int oldest = (head + 1) % STORE_SECTORS;
+  if (sequences[oldest] != 0) evacuate(oldest);
+}
+
+static void format() {
+  Serial.println("Formatting flash store");
+  for (int sector = 0; sector < STORE_SECTORS; sector++) {
+    if (!sectorBlank(sector)) eraseSector(sector);
+  }
+  startSector(0, 1);
+}
+
+bool initializeFlashStore() {
+  if (!flash.begin()) {
+    Serial.println("QSPI flash not found - settings and data won't survive a reboot");
+    return false;
+  }
+  regionStart = flash.size() - STORE_SECTORS * STORE_SECTOR_SIZE;
+
+  for (int sector = 0; sector < STORE_SECTORS; sector++) {
+    SectorHeader header;
+    flash.readBuffer(sectorAddress(sector), (uint8_t *)&header, sizeof(header));
+    bool valid = header.magic == STORE_MAGIC && header.sequence != 0 && header.sequence != 0xFFFFFFFF;
+    sequences[sector] = valid ? header.sequence : 0;
+  }
+
+  // Replay oldest first so newer records replace older ones
+  uint32_t replayed = 0;
+  while (true) {
+    int next = -1;
+    for (int sector = 0; sector < STORE_SECTORS; sector++) {
+      if (sequences[sector] > replayed && (next < 0 || sequences[sector] < sequences[next])) next = sector;
+    }
+    if (next < 0) break;
+    headOffset = scanSector(next);
+    head = next;
+    replayed = sequences[next];
+  }
+  ready = true;
+
+  if (head < 0) {
+    format();
+    return true;
+  }
+
+  // A power cut in the middle of rotate() can leave the spare unerased
+  int spare = (head + 1) % STORE_SECTORS;
+  if (sequences[spare] != 0) {
+    evacuate(spare);
+  } else if (!sectorBlank(spare)) {
+    eraseSector(spare);
+  }
+
+  uint8_t found = 0;
+  for (const KeyState &state : keys) found += state.stored;
+  Serial.print("Flash store: ");
+  Serial.print(found);
+  Serial.println(" values restored");
+  return true;
+}
+
+int storeGet(uint8_t key, uint8_t *buffer, size_t size) {
+  if (!ready || key >= STORE_KEY_LIMIT) return -1;
+  const KeyState &state = keys[key];
+
+  if (state.pending) {
+    if (state.pendingLength > size) return -1;
+    memcpy(buffer, state.pending, state.pendingLength);
+    return state.pendingLength;
+  }
+  if (!state.stored || state.length > size) return -1;
+  flash.readBuffer(state.address, buffer, state.length);
+  return state.length;
+}
+
+void storeSet(uint8_t key, const uint8_t *data, size_t length, uint32_t holdMs) {
+  if (!ready || key >= STORE_KEY_LIMIT || length > STORE_VALUE_MAX) return;
+  KeyState &state = keys[key];
+  uint32_t crc = crc32Update(recordCrc(key, length), data, length);
+
+  if (state.pending) {
+    if (state.pendingLength == length && state.pendingCrc == crc) return;
+    // Replaces a value that never reached the flash; keep the original deadline
+    free(state.pending);
+    state.pending = nullptr;
+    writesSaved++;
+    if (state.stored && state.length == length && state.crc == crc) return;  // Changed back
+  } else {
+    if (state.stored && state.length == length && state.crc == crc) return;
+    state.dueAt = millis() + holdMs;
+  }
+
+  state.pending = (uint8_t *)malloc(length > 0 ? length : 1);
+  if (!state.pending) return;
+  memcpy(state.pending, data, length);
+  state.pendingLength = length;
+  state.pendingCrc = crc;
+}
+
+void flushFlashStore(bool force) {
+  if (!ready) return;
+  uint32_t now = millis();
+
+  for (uint8_t key = 0; key < STORE_KEY_LIMIT; key++) {
+    KeyState &state = keys[key];
+    if (!state.pending || (!force && (int32_t)(now - state.dueAt) < 0)) continue;
+
+    // Each rotation frees at least the garbage of one sector
+    uint32_t size = recordSize(state.pendingLength);
+    for (int attempt = 0; headOffset + size > STORE_SECTOR_SIZE && attempt < STORE_SECTORS; attempt++) {
+      rotate();
+    }
+    if (headOffset + size <= STORE_SECTOR_SIZE) {
+      writeRecord(key, state.pendingLength, state.pendingCrc, state.pending, 0);
+    } else {
+      Serial.print("Flash store full, key not saved: ");
+      Serial.println(key);
+    }
+
+    free(state.pending);
+    state.pending = nullptr;
+  }
+}
+
+void printFlashStoreMetrics(Print &out) {
+  uint32_t liveBytes = 0;
+  for (const KeyState &state : keys) {
+    if (state.stored) liveBytes += recordSize(state.length);
+  }
+  out.print("flash_store_records_written ");
+  out.println((unsigned long)recordsWritten);
+  out.print("flash_store_sector_erases ");
+  out.println((unsigned long)sectorErases);
+  out.print("flash_store_writes_coalesced ");
+  out.println((unsigned long)writesSaved);
+  out.print("flash_store_live_bytes ");
+  out.println((unsigned long)liveBytes);
+}
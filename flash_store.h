@@ -0,0 +1,40 @@
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <Arduino.h>
+
+// Small key/value store in the top 32 KB of the MatrixPortal's QSPI flash.
+// Values are appended to a log of CRC-checked records, so a changed value
+// costs one page program, and sectors are only erased as the log wraps
+// around, which spreads wear over the whole region. The newest valid record
+// of a key wins; a record torn by a power cut fails its CRC and the previous
+// one stays in effect.
+//
+// Writes are coalesced: storeSet() only queues the value, and
+// flushFlashStore() writes the newest one once its hold time has passed,
+// however often it changed meanwhile. Setting a value that is already stored
+// costs nothing. Network task only, like the JSON arena.
+//
+// The region is the last 32 KB of the chip. A CircuitPython filesystem left on
+// the same chip would lose those sectors the first time the store formats them.
+
+#define STORE_KEY_LIMIT 16
+#define STORE_VALUE_MAX 2048
+
+// Mount the region and index the log; false when the flash isn't usable
+bool initializeFlashStore();
+
+// Copies the latest value of key into buffer and returns its length, or -1 if
+// the key was never set or the value doesn't fit
+int storeGet(uint8_t key, uint8_t *buffer, size_t size);
+
+// Queue a value to be written no later than holdMs from the first change
+void storeSet(uint8_t key, const uint8_t *data, size_t length, uint32_t holdMs);
+
+// Write the values whose hold time is over; force writes everything queued
+void flushFlashStore(bool force = false);
+
+// Log usage, erases and writes saved by coalescing
+void printFlashStoreMetrics(Print &out);
+
+#endif
@@ -0,0 +1,155 @@
+#include "frame_stream.h"
+#include "matrix_display.h"
+#include "snapshot.h"
+
+// Most bytes read per poll, so a sender pushing faster than the panel can't
+// hold the network task; the rest stays in the socket until the next poll
+#define FRAME_STREAM_READ_BUDGET (4 * (FRAME_HEADER_SIZE + sizeof(StreamFrame)))
+
+struct StreamFrame {
+  uint16_t pixels[ANIMATION_ZONE_HEIGHT * WIDTH];
+};
+
+static WiFiServer frameServer(FRAME_STREAM_PORT);
+static WiFiClient sender;
+static bool senderConnected = false;
+
+// Receive state, network task only
+static uint8_t header[FRAME_HEADER_SIZE];
+static size_t headerUsed = 0;
+static uint8_t regionX, regionY, regionWidth, regionHeight;
+static uint32_t payloadUsed = 0;
+static bool takeZone = false;
+
+// Every frame received so far applied in turn. Rectangles are read into it in
+// place, then the whole zone is published for the display task.
+static StreamFrame zone;
+static Snapshot<StreamFrame> frames;
+
+static uint32_t framesReceived = 0;
+static uint32_t framesShown = 0;
+static uint32_t framesRejected = 0;
+static uint32_t bytesReceived = 0;
+
+void initializeFrameStream() {
+  frameServer.begin();
+  Serial.println("Frame stream listening on port " + String(FRAME_STREAM_PORT));
+}
+
+bool frameStreamConnected() {
+  return senderConnected;
+}
+
+void beginFrameStream() {
+  headerUsed = 0;
+  payloadUsed = 0;
+  takeZone = true;
+}
+
+static void finishFrame() {
+  frames.publish(zone);
+  framesReceived++;
+  headerUsed = 0;
+  payloadUsed = 0;
+
+  if (takeZone) {
+    takeZone = false;
+    setStreamAnimation();
+  }
+}
+
+static bool startFrame() {
+  regionX = header[2];
+  regionY = header[3];
+  regionWidth = header[4];
+  regionHeight = header[5];
+  if (header[0] != 'F' || header[1] != 'R' ||
+      regionX + regionWidth > WIDTH || regionY + regionHeight > ANIMATION_ZONE_HEIGHT) {
+    framesRejected++;
+    return false;
+  }
+
+  payloadUsed = 0;
+  if (regionWidth == 0 || regionHeight == 0) {
+    finishFrame();
+  }
+  return true;
+}
+
+bool receiveFrameStream(WiFiClient &client) {
+  uint32_t budget = FRAME_STREAM_READ_BUDGET;
+  int available = client.available();
+  while (available > 0 && budget > 0) {
+    int count;
+    if (headerUsed < FRAME_HEADER_SIZE) {
+      count = client.read(header + headerUsed, min((size_t)available, FRAME_HEADER_SIZE - headerUsed));
+      if (count <= 0) break;
+      headerUsed += count;
+      if (headerUsed == FRAME_HEADER_SIZE && !startFrame()) return false;
+    } else {
+      // The rest of the rectangle's current row, where it belongs in the zone
+      uint32_t rowBytes = regionWidth * sizeof(uint16_t);
+      uint32_t row = payloadUsed / rowBytes;
+      uint32_t offset = payloadUsed % rowBytes;
+      uint8_t *target = (uint8_t *)(zone.pixels + (regionY + row) * WIDTH + regionX) + offset;
+      count = client.read(target, min((uint32_t)available, min(rowBytes - offset, budget)));
+      if (count <= 0) break;
+      payloadUsed += count;
+      if (payloadUsed == rowBytes * regionHeight) finishFrame();
+    }
+
+    bytesReceived += count;
+    budget -= min((uint32_t)count, budget);
+    available -= count;
+    if (available <= 0) available = client.available();
+  }
+  return true;
+}
+
+static void closeSender() {
+  sender.stop();
+  senderConnected = false;
+}
+
+void pollFrameStream() {
+  // available() returns any socket with unread data, the current sender included
+  WiFiClient client = frameServer.available();
+  if (client && !(senderConnected && sender == client)) {
+    if (senderConnected) closeSender();
+    sender = client;
+    senderConnected = true;
+    beginFrameStream();
+    Serial.println("Frame stream sender connected");
+  }
+  if (!senderConnected) return;
+
+  if (!receiveFrameStream(sender)) {
+    Serial.println("Frame stream: malformed frame header, closing");
+    closeSender();
+  } else if (!sender.connected()) {
+    Serial.println("Frame stream sender disconnected");
+    closeSender();
+  }
+}
+
+bool tickStreamFrame() {
+  bool fresh;
+  frames.read(&fresh);
+  if (fresh) framesShown++;
+  return fresh;
+}
+
+void drawStreamFrame() {
+  memcpy(matrix.getBuffer() + ANIMATION_ZONE_Y * WIDTH, frames.read().pixels, sizeof(StreamFrame));
+}
+
+void printFrameStreamMetrics(Print &out) {
+  out.print("stream_frames_received ");
+  out.println(framesReceived);
+  out.print("stream_frames_shown ");
+  out.println(framesShown);
+  out.print("stream_frames_rejected ");
+  out.println(framesRejected);
+  out.print("stream_bytes ");
+  out.println(bytesReceived);
+}
@@ -0,0 +1,39 @@
+#ifndef FRAME_STREAM_H
+#define FRAME_STREAM_H
+
+#include <WiFiNINA.h>
+
+// Live frames for the animation zone, pushed by a sender on the LAN over one
+// TCP connection to FRAME_STREAM_PORT (host/frame_sender.py is one). Each
+// frame is a 6-byte header followed by the pixels of a rectangle:
+//
+//   'F' 'R' x y width height      zone coordinates, y = 0 is the zone's top row
+//   width * height RGB565 pixels, little-endian, row by row
+//
+// A full frame is 0 0 64 17; anything smaller updates only that rectangle of
+// the previous frame. Pixels are read from the socket straight into the zone
+// image, and the display task only ever takes the newest complete frame, so
+// frames that arrive faster than the panel is shown are dropped there. A
+// malformed header closes the connection. A new connection replaces the old
+// one and switches the animation zone to the stream with its first frame.
+
+#define FRAME_STREAM_PORT 7777
+#define FRAME_HEADER_SIZE 6
+
+void initializeFrameStream();
+void pollFrameStream();                   // Network task: accept the sender and read what has arrived
+bool frameStreamConnected();
+
+// pollFrameStream() runs these for its sender; host/host_stream.cpp feeds
+// them directly
+void beginFrameStream();                  // Forget any partial frame; the next one takes the zone
+bool receiveFrameStream(WiFiClient &client);    // False once a header is malformed
+
+// Display task, for ANIMATION_STREAM
+bool tickStreamFrame();                   // True when a newer frame is waiting
+void drawStreamFrame();
+
+// Frames received, taken by the display, rejected, and bytes read
+void printFrameStreamMetrics(Print &out);
+
+#endif
@@ -0,0 +1,153 @@
+#include <Adafruit_GFX.h>
+#include "host_runtime.h"
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawPixel(i, y, color);
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    for (int16_t j = y; j < y + h; j++) drawPixel(x, j, color);
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t i = x; i < x + w; i++) drawFastVLine(i, y, h, color);
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+    int16_t dx = x1 - x0, dy = abs(y1 - y0);
+    int16_t err = dx / 2, ystep = y0 < y1 ? 1 : -1;
+    for (; x0 <= x1; x0++) {
+        if (steep) drawPixel(y0, x0, color); else drawPixel(x0, y0, color);
+        err -= dy;
+        if (err < 0) { y0 += ystep; err += dx; }
+    }
+}
+
+void Adafruit_GFX::fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int16_t y = -r; y <= r; y++) {
+        for (int16_t x = -r; x <= r; x++) {
+            if (x * x + y * y <= r * r + r) drawPixel(x0 + x, y0 + y, color);
+        }
+    }
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t stride = (w + 7) / 8;
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * stride + i / 8] & (0x80 >> (i & 7))) drawPixel(x + i, y + j, color);
+        }
+    }
+}
+
+// Placeholder glyph: a deterministic 5x7 pattern per character code
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    uint32_t bits = c == ' ' ? 0 : (c * 2654435761u) | 0x01010101u;
+    for (int8_t i = 0; i < 6; i++) {
+        uint8_t column = i < 5 ? (uint8_t)((bits >> (i * 6)) & 0x7F) : 0;
+        for (int8_t j = 0; j < 8; j++, column >>= 1) {
+            if (column & 1) {
+                if (size == 1) drawPixel(x + i, y + j, color);
+                else fillRect(x + i * size, y + j * size, size, size, color);
+            } else if (bg != color) {
+                if (size == 1) drawPixel(x + i, y + j, bg);
+                else fillRect(x + i * size, y + j * size, size, size, bg);
+            }
+        }
+    }
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += textsize * 8;
+    } else if (c != '\r') {
+        if (wrap && cursor_x + textsize * 6 > _width) {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize);
+        cursor_x += textsize * 6;
+    }
+    return 1;
+}
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint8_t *)calloc(((w + 7) / 8) * h, 1);
+}
+
+GFXcanvas1::~GFXcanvas1() { free(buffer); }
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    hostDrawPixelCalls++;
+    if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t *p = &buffer[(x / 8) + y * ((_width + 7) / 8)];
+    if (color) *p |= 0x80 >> (x & 7); else *p &= ~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (!buffer || y < 0 || y >= _height) return;
+    for (int16_t i = max<int16_t>(x, 0); i < min<int16_t>(x + w, _width); i++) {
+        uint8_t *p = &buffer[(i / 8) + y * ((_width + 7) / 8)];
+        if (color) *p |= 0x80 >> (i & 7); else *p &= ~(0x80 >> (i & 7));
+    }
+}
+
+void GFXcanvas1::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (!buffer || x < 0 || x >= _width) return;
+    for (int16_t j = max<int16_t>(y, 0); j < min<int16_t>(y + h, _height); j++) {
+        uint8_t *p = &buffer[(x / 8) + j * ((_width + 7) / 8)];
+        if (color) *p |= 0x80 >> (x & 7); else *p &= ~(0x80 >> (x & 7));
+    }
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+    if (buffer) memset(buffer, color ? 0xFF : 0x00, ((_width + 7) / 8) * _height);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+    if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return buffer[(x / 8) + y * ((_width + 7) / 8)] & (0x80 >> (x & 7));
+}
+
+GFXcanvas16::GFXcanvas16(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+    buffer = (uint16_t *)calloc(w * h, sizeof(uint16_t));
+}
+
+GFXcanvas16::~GFXcanvas16() { free(buffer); }
+
+void GFXcanvas16::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    hostDrawPixelCalls++;
+    if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    buffer[x + y * _width] = color;
+}
+
+void GFXcanvas16::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    if (!buffer || y < 0 || y >= _height) return;
+    for (int16_t i = max<int16_t>(x, 0); i < min<int16_t>(x + w, _width); i++) buffer[i + y * _width] = color;
+}
+
+void GFXcanvas16::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    if (!buffer || x < 0 || x >= _width) return;
+    for (int16_t j = max<int16_t>(y, 0); j < min<int16_t>(y + h, _height); j++) buffer[x + j * _width] = color;
+}
+
+void GFXcanvas16::fillScreen(uint16_t color) {
+    if (!buffer) return;
+    for (uint32_t i = 0; i < (uint32_t)_width * _height; i++) buffer[i] = color;
+}
+
+uint16_t GFXcanvas16::getPixel(int16_t x, int16_t y) const {
+    if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return buffer[x + y * _width];
+}
@@ -0,0 +1,81 @@
+#ifndef ADAFRUIT_GFX_H
+#define ADAFRUIT_GFX_H
+
+// Host stand-in for Adafruit_GFX. Primitives behave like the real library;
+// text is drawn with placeholder 5x7 glyphs (same advance and cell size as the
+// built-in font) so layout and per-frame cost are representative. As in the
+// real library, canvases fill lines and rects without going through drawPixel,
+// so hostDrawPixelCalls counts what the firmware would.
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextSize(uint8_t s) { textsize = s > 0 ? s : 1; }
+    void setTextWrap(bool w) { wrap = w; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+protected:
+    int16_t _width, _height;
+    int16_t cursor_x = 0, cursor_y = 0;
+    uint16_t textcolor = 0xFFFF, textbgcolor = 0xFFFF;
+    uint8_t textsize = 1;
+    bool wrap = true;
+};
+
+class GFXcanvas1 : public Adafruit_GFX {
+public:
+    GFXcanvas1(uint16_t w, uint16_t h);
+    ~GFXcanvas1();
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    bool getPixel(int16_t x, int16_t y) const;
+    uint8_t *getBuffer() const { return buffer; }
+
+private:
+    uint8_t *buffer;
+};
+
+class GFXcanvas16 : public Adafruit_GFX {
+public:
+    GFXcanvas16(uint16_t w, uint16_t h);
+    ~GFXcanvas16();
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+    void fillScreen(uint16_t color) override;
+    uint16_t getPixel(int16_t x, int16_t y) const;
+    uint16_t *getBuffer() const { return buffer; }
+
+private:
+    uint16_t *buffer;
+};
+
+#endif
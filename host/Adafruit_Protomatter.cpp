@@ -0,0 +1,21 @@
+#include <Adafruit_Protomatter.h>
+
+Adafruit_Protomatter::Adafruit_Protomatter(uint16_t bitWidth, uint8_t bitDepth, uint8_t rgbCount, uint8_t *rgbList,
+                                           uint8_t addrCount, uint8_t *addrList, uint8_t clockPin, uint8_t latchPin,
+                                           uint8_t oePin, bool doubleBuffer, int8_t tile, void *timer)
+    : GFXcanvas16(bitWidth, (2 << addrCount) * rgbCount * (tile > 0 ? tile : 1)) {
+    (void)bitDepth; (void)rgbList; (void)addrList; (void)clockPin;
+    (void)latchPin; (void)oePin; (void)doubleBuffer; (void)timer;
+    panelBuffer = (uint16_t *)calloc(width() * height(), sizeof(uint16_t));
+}
+
+Adafruit_Protomatter::~Adafruit_Protomatter() { free(panelBuffer); }
+
+ProtomatterStatus Adafruit_Protomatter::begin() {
+    return (getBuffer() && panelBuffer) ? PROTOMATTER_OK : PROTOMATTER_ERR_MALLOC;
+}
+
+void Adafruit_Protomatter::show() {
+    memcpy(panelBuffer, getBuffer(), width() * height() * sizeof(uint16_t));
+    shows++;
+}
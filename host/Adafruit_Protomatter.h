@@ -0,0 +1,39 @@
+#ifndef ADAFRUIT_PROTOMATTER_H
+#define ADAFRUIT_PROTOMATTER_H
+
+// Host stand-in for Adafruit_Protomatter: a GFXcanvas16 whose show() latches
+// the canvas into a "panel" buffer that host tools can inspect or dump.
+
+#include <Adafruit_GFX.h>
+
+typedef enum {
+    PROTOMATTER_OK,
+    PROTOMATTER_ERR_PINS,
+    PROTOMATTER_ERR_MALLOC,
+    PROTOMATTER_ERR_ARG
+} ProtomatterStatus;
+
+class Adafruit_Protomatter : public GFXcanvas16 {
+public:
+    Adafruit_Protomatter(uint16_t bitWidth, uint8_t bitDepth, uint8_t rgbCount, uint8_t *rgbList,
+                         uint8_t addrCount, uint8_t *addrList, uint8_t clockPin, uint8_t latchPin,
+                         uint8_t oePin, bool doubleBuffer, int8_t tile = 1, void *timer = NULL);
+    ~Adafruit_Protomatter();
+
+    ProtomatterStatus begin();
+    void show();
+
+    static uint16_t color565(uint8_t red, uint8_t green, uint8_t blue) {
+        return ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3);
+    }
+
+    // Host-only introspection
+    const uint16_t *panel() const { return panelBuffer; }
+    uint32_t showCount() const { return shows; }
+
+private:
+    uint16_t *panelBuffer;
+    uint32_t shows = 0;
+};
+
+#endif
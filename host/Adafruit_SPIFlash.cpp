@@ -0,0 +1,64 @@
+#include <Adafruit_SPIFlash.h>
+#include "host_runtime.h"
+
+static uint8_t *image = NULL;
+static const char *imagePath = NULL;
+
+void hostSetFlashFile(const char *path) { imagePath = path; }
+
+bool Adafruit_SPIFlash::begin() {
+    if (!image) {
+        image = (uint8_t *)malloc(HOST_FLASH_SIZE);
+        if (!image) return false;
+        memset(image, 0xFF, HOST_FLASH_SIZE);
+
+        FILE *f = imagePath ? fopen(imagePath, "rb") : NULL;
+        if (f) {
+            size_t got = fread(image, 1, HOST_FLASH_SIZE, f);
+            (void)got;
+            fclose(f);
+        }
+    }
+    return true;
+}
+
+uint32_t Adafruit_SPIFlash::readBuffer(uint32_t address, uint8_t *buffer, uint32_t len) {
+    if (!image || address >= HOST_FLASH_SIZE) return 0;
+    if (len > HOST_FLASH_SIZE - address) len = HOST_FLASH_SIZE - address;
+    memcpy(buffer, image + address, len);
+    return len;
+}
+
+uint32_t Adafruit_SPIFlash::writeBuffer(uint32_t address, const uint8_t *buffer, uint32_t len) {
+    if (!image || address >= HOST_FLASH_SIZE) return 0;
+    if (len > HOST_FLASH_SIZE - address) len = HOST_FLASH_SIZE - address;
+    for (uint32_t i = 0; i < len; i++) {
+        image[address + i] &= buffer[i];
+    }
+    persist(address, len);
+    return len;
+}
+
+bool Adafruit_SPIFlash::eraseSector(uint32_t sectorNumber) {
+    uint32_t address = sectorNumber * SFLASH_SECTOR_SIZE;
+    if (!image || address >= HOST_FLASH_SIZE) return false;
+    memset(image + address, 0xFF, SFLASH_SECTOR_SIZE);
+    persist(address, SFLASH_SECTOR_SIZE);
+    return true;
+}
+
+// Write the changed range through to the image file, creating it at full size
+void Adafruit_SPIFlash::persist(uint32_t address, uint32_t len) {
+    if (!imagePath) return;
+    FILE *f = fopen(imagePath, "r+b");
+    if (!f) {
+        f = fopen(imagePath, "w+b");
+        if (!f) return;
+        fwrite(image, 1, HOST_FLASH_SIZE, f);
+        fclose(f);
+        return;
+    }
+    fseek(f, address, SEEK_SET);
+    fwrite(image + address, 1, len, f);
+    fclose(f);
+}
@@ -0,0 +1,35 @@
+#ifndef ADAFRUIT_SPIFLASH_H
+#define ADAFRUIT_SPIFLASH_H
+
+// Host stand-in for Adafruit_SPIFlash: a 2 MB NOR flash image in memory, with
+// NOR semantics (programming only clears bits, erasing sets a 4 KB sector back
+// to 0xFF). With hostSetFlashFile() the image is loaded from and written
+// through to a file, so state survives between host runs like a reboot.
+
+#include <Arduino.h>
+
+#define HOST_FLASH_SIZE (2 * 1024 * 1024)
+#define SFLASH_SECTOR_SIZE 4096
+
+class Adafruit_FlashTransport_QSPI {
+public:
+    Adafruit_FlashTransport_QSPI() {}
+};
+
+class Adafruit_SPIFlash {
+public:
+    explicit Adafruit_SPIFlash(Adafruit_FlashTransport_QSPI *transport) { (void)transport; }
+
+    bool begin();
+    uint32_t size() { return HOST_FLASH_SIZE; }
+
+    uint32_t readBuffer(uint32_t address, uint8_t *buffer, uint32_t len);
+    uint32_t writeBuffer(uint32_t address, const uint8_t *buffer, uint32_t len);
+    bool eraseSector(uint32_t sectorNumber);
+    void waitUntilReady() {}
+
+private:
+    void persist(uint32_t address, uint32_t len);
+};
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the Arduino core: just enough of String, Serial and the
+// timing functions for the sketch to build and run on a Linux machine.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <strings.h>
+#include <utility>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Heap behaviour follows the Arduino core's WString: the buffer is malloc'd on
+// first use (even for ""), grown with realloc and freed in the destructor, so
+// allocation counts taken on the host match what the firmware would do.
+class String {
+public:
+    String() {}
+    String(const char *s) { if (s) copy(s, strlen(s)); }
+    String(const String &o) { *this = o; }
+    String(String &&o) : buf_(o.buf_), cap_(o.cap_), len_(o.len_) { o.buf_ = nullptr; o.cap_ = o.len_ = 0; }
+    String(char c) { char s[2] = {c, 0}; copy(s, 1); }
+    String(int n) { char s[16]; copyFormatted(s, snprintf(s, sizeof(s), "%d", n)); }
+    String(unsigned int n) { char s[16]; copyFormatted(s, snprintf(s, sizeof(s), "%u", n)); }
+    String(long n) { char s[24]; copyFormatted(s, snprintf(s, sizeof(s), "%ld", n)); }
+    String(unsigned long n) { char s[24]; copyFormatted(s, snprintf(s, sizeof(s), "%lu", n)); }
+    String(float f, unsigned char decimals = 2) { fromDouble(f, decimals); }
+    String(double f, unsigned char decimals = 2) { fromDouble(f, decimals); }
+    ~String() { free(buf_); }
+
+    unsigned int length() const { return len_; }
+    const char *c_str() const { return buf_ ? buf_ : ""; }
+    bool reserve(unsigned int size) {
+        if (buf_ && cap_ >= size) return true;
+        char *grown = (char *)realloc(buf_, size + 1);
+        if (!grown) return false;
+        if (!buf_) grown[0] = 0;
+        buf_ = grown;
+        cap_ = size;
+        return true;
+    }
+    bool isEmpty() const { return len_ == 0; }
+
+    char charAt(unsigned int i) const { return i < len_ ? buf_[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char &operator[](unsigned int i) { static char dummy; return i < len_ ? buf_[i] : dummy; }
+
+    String &operator=(const String &o) {
+        if (this != &o) { if (o.buf_) copy(o.buf_, o.len_); else invalidate(); }
+        return *this;
+    }
+    String &operator=(String &&o) {
+        if (this != &o) {
+            free(buf_);
+            buf_ = o.buf_; cap_ = o.cap_; len_ = o.len_;
+            o.buf_ = nullptr; o.cap_ = o.len_ = 0;
+        }
+        return *this;
+    }
+    String &operator=(const char *s) { if (s) copy(s, strlen(s)); else invalidate(); return *this; }
+    String &operator+=(const String &o) { concat(o); return *this; }
+    String &operator+=(const char *o) { concat(o, o ? strlen(o) : 0); return *this; }
+    String &operator+=(char c) { concat(c); return *this; }
+    String &operator+=(int n) { String s(n); concat(s); return *this; }
+    bool concat(const String &o) { return concat(o.c_str(), o.len_); }
+    bool concat(char c) { char s[2] = {c, 0}; return concat(s, 1); }
+    bool concat(const char *s) { return s ? concat(s, strlen(s)) : false; }
+    bool concat(const char *s, unsigned int n) {
+        if (!s) return false;
+        if (n == 0) return true;
+        // s may point into our own buffer, which reserve() can move
+        bool self = buf_ && s >= buf_ && s < buf_ + len_;
+        size_t offset = self ? s - buf_ : 0;
+        if (!reserve(len_ + n)) return false;
+        memmove(buf_ + len_, self ? buf_ + offset : s, n);
+        len_ += n;
+        buf_[len_] = 0;
+        return true;
+    }
+
+    bool operator==(const String &o) const { return len_ == o.len_ && strcmp(c_str(), o.c_str()) == 0; }
+    bool operator==(const char *o) const { return strcmp(c_str(), o ? o : "") == 0; }
+    bool operator!=(const String &o) const { return !(*this == o); }
+    bool operator!=(const char *o) const { return !(*this == o); }
+    bool equals(const String &o) const { return *this == o; }
+    bool equalsIgnoreCase(const String &o) const {
+        return len_ == o.len_ && strcasecmp(c_str(), o.c_str()) == 0;
+    }
+    bool startsWith(const String &p) const { return p.len_ <= len_ && strncmp(c_str(), p.c_str(), p.len_) == 0; }
+    bool endsWith(const String &p) const {
+        return p.len_ <= len_ && strcmp(c_str() + len_ - p.len_, p.c_str()) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        if (from >= len_) return -1;
+        const char *hit = strchr(buf_ + from, c);
+        return hit ? (int)(hit - buf_) : -1;
+    }
+    int indexOf(const String &s, unsigned int from = 0) const {
+        if (from > len_) return -1;
+        const char *hit = strstr(c_str() + from, s.c_str());
+        return hit ? (int)(hit - c_str()) : -1;
+    }
+    int lastIndexOf(char c) const {
+        for (int i = (int)len_ - 1; i >= 0; i--) if (buf_[i] == c) return i;
+        return -1;
+    }
+    int lastIndexOf(const String &s) const {
+        if (s.len_ > len_) return -1;
+        for (int i = (int)(len_ - s.len_); i >= 0; i--) {
+            if (strncmp(buf_ + i, s.c_str(), s.len_) == 0) return i;
+        }
+        return -1;
+    }
+
+    String substring(unsigned int from) const { return substring(from, len_); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        String out;
+        if (from >= len_) return out;
+        if (to > len_) to = len_;
+        out.copy(buf_ + from, to - from);
+        return out;
+    }
+
+    void replace(const String &from, const String &to) {
+        if (from.len_ == 0 || len_ == 0) return;
+        String out;
+        out.reserve(len_);
+        unsigned int i = 0;
+        while (i < len_) {
+            if (strncmp(buf_ + i, from.c_str(), from.len_) == 0) {
+                out.concat(to);
+                i += from.len_;
+            } else {
+                out.concat(buf_[i++]);
+            }
+        }
+        *this = static_cast<String &&>(out);
+    }
+    void trim() {
+        if (len_ == 0) return;
+        unsigned int b = 0, e = len_;
+        while (b < e && isspace((unsigned char)buf_[b])) b++;
+        while (e > b && isspace((unsigned char)buf_[e - 1])) e--;
+        len_ = e - b;
+        memmove(buf_, buf_ + b, len_);
+        buf_[len_] = 0;
+    }
+    void toLowerCase() { for (unsigned int i = 0; i < len_; i++) buf_[i] = (char)tolower((unsigned char)buf_[i]); }
+    void toUpperCase() { for (unsigned int i = 0; i < len_; i++) buf_[i] = (char)toupper((unsigned char)buf_[i]); }
+
+    long toInt() const { return strtol(c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(c_str(), nullptr); }
+
+    friend String operator+(const String &a, const String &b) { String s(a); s.concat(b); return s; }
+    friend String operator+(const String &a, const char *b) { String s(a); s += b; return s; }
+    friend String operator+(const char *a, const String &b) { String s(a); s.concat(b); return s; }
+    friend String operator+(const String &a, char b) { String s(a); s.concat(b); return s; }
+
+private:
+    void copy(const char *s, unsigned int n) {
+        if (!reserve(n)) { invalidate(); return; }
+        memmove(buf_, s, n);
+        len_ = n;
+        buf_[len_] = 0;
+    }
+    void copyFormatted(const char *s, int n) { copy(s, n > 0 ? (unsigned int)strlen(s) : 0); }
+    void invalidate() { free(buf_); buf_ = nullptr; cap_ = len_ = 0; }
+    void fromDouble(double f, unsigned char decimals) {
+        char s[48];
+        copyFormatted(s, snprintf(s, sizeof(s), "%.*f", decimals, f));
+    }
+
+    char *buf_ = nullptr;
+    unsigned int cap_ = 0;
+    unsigned int len_ = 0;
+};
+
+class IPAddress {
+public:
+    IPAddress() : addr_{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr_{a, b, c, d} {}
+    uint8_t operator[](int index) const { return addr_[index]; }
+
+private:
+    uint8_t addr_[4];
+};
+
+// Minimal Print: everything funnels through write()
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buf++);
+        return n;
+    }
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return printf("%d", n); }
+    size_t print(unsigned int n) { return printf("%u", n); }
+    size_t print(long n) { return printf("%ld", n); }
+    size_t print(unsigned long n) { return printf("%lu", n); }
+    size_t print(double f, int decimals = 2) { return printf("%.*f", decimals, f); }
+    size_t print(const IPAddress &ip) { return printf("%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]); }
+
+    template <typename T>
+    size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(buf, sizeof(buf), format, args);
+        va_end(args);
+        if (len < 0) return 0;
+        return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    void setTimeout(unsigned long timeout) { timeoutMs = timeout; }
+    String readStringUntil(char terminator) {
+        String s;
+        int c;
+        while ((c = read()) >= 0 && c != terminator) s += (char)c;
+        return s;
+    }
+    // What ArduinoJson reads a Stream with. Host streams never wait, so it
+    // stops at the first -1 rather than after the timeout
+    size_t readBytes(char *buffer, size_t length) {
+        size_t count = 0;
+        int c;
+        while (count < length && (c = read()) >= 0) buffer[count++] = (char)c;
+        return count;
+    }
+
+protected:
+    unsigned long timeoutMs = 1000;
+};
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override;
+    using Print::write;
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+long random(long max);
+long random(long min, long max);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef FREERTOS_SAMD51_H
+#define FREERTOS_SAMD51_H
+
+// Host stand-in for FreeRTOS_SAMD51. There is no scheduler on the host: tick
+// count is the host clock and delays advance it.
+
+#include <Arduino.h>
+
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdPASS 1
+#define pdFAIL 0
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define tskIDLE_PRIORITY 0
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint16_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *handle);
+void vTaskStartScheduler();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previousWakeTime, TickType_t increment);
+TickType_t xTaskGetTickCount();
+void taskYIELD();
+size_t xPortGetFreeHeapSize();
+
+#endif
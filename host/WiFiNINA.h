@@ -0,0 +1,63 @@
+#ifndef WIFININA_H
+#define WIFININA_H
+
+// Host stand-in for WiFiNINA. There is no radio on the host: the module
+// reports as connected so the sketch runs its normal paths (unless an outage
+// is set with hostSetWiFiOutage()), but every client connection attempt fails
+// immediately.
+
+#include <Arduino.h>
+
+#define WL_IDLE_STATUS 0
+#define WL_NO_SSID_AVAIL 1
+#define WL_SCAN_COMPLETED 2
+#define WL_CONNECTED 3
+#define WL_CONNECT_FAILED 4
+#define WL_CONNECTION_LOST 5
+#define WL_DISCONNECTED 6
+#define WL_NO_MODULE 255
+
+class WiFiClient : public Stream {
+public:
+    virtual int connect(const char *host, uint16_t port) { (void)host; (void)port; return 0; }
+    virtual void stop() {}
+    virtual uint8_t connected() { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    virtual int read(uint8_t *buf, size_t size) { (void)buf; (void)size; return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    size_t write(const uint8_t *buf, size_t size) override { (void)buf; return size; }
+    using Print::write;
+    operator bool() { return connected(); }
+    virtual bool operator==(const WiFiClient &other) { return this == &other; }
+};
+
+class WiFiSSLClient : public WiFiClient {
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t port) { (void)port; }
+    void begin() {}
+    WiFiClient available() { return WiFiClient(); }
+};
+
+class WiFiClass {
+public:
+    int begin(const char *ssid, const char *pass) { (void)ssid; (void)pass; return status(); }
+    int status();
+    void setTimeout(unsigned long timeout) { (void)timeout; }
+    void disconnect() {}
+    IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+    const char *SSID() { return "host"; }
+    const char *SSID(uint8_t index) { (void)index; return "host"; }
+    int32_t RSSI() { return -40; }
+    int32_t RSSI(uint8_t index) { (void)index; return -40; }
+    const char *firmwareVersion() { return "host"; }
+    int8_t scanNetworks() { return 0; }
+};
+
+extern WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,59 @@
+#include "WiFiUdp.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+uint8_t WiFiUDP::begin(uint16_t port) {
+    stop();
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return 0;
+
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(fd, (sockaddr *)&address, sizeof(address)) < 0) {
+        fprintf(stderr, "UDP port %u: %s\n", port, strerror(errno));
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+void WiFiUDP::stop() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+    length = position = 0;
+}
+
+int WiFiUDP::parsePacket() {
+    length = position = 0;
+    if (fd < 0) return 0;
+
+    sockaddr_in from = {};
+    socklen_t fromLength = sizeof(from);
+    ssize_t received = recvfrom(fd, buffer, sizeof(buffer), 0, (sockaddr *)&from, &fromLength);
+    if (received <= 0) return 0;
+
+    uint32_t ip = ntohl(from.sin_addr.s_addr);
+    remoteAddress = IPAddress(ip >> 24, ip >> 16, ip >> 8, ip);
+    remotePortNumber = ntohs(from.sin_port);
+    length = received;
+    return length;
+}
+
+int WiFiUDP::read(unsigned char *buf, size_t size) {
+    int count = min((int)size, available());
+    if (count <= 0) return -1;
+    memcpy(buf, buffer + position, count);
+    position += count;
+    return count;
+}
@@ -0,0 +1,44 @@
+#ifndef WIFIUDP_H
+#define WIFIUDP_H
+
+// Host stand-in for WiFiNINA's WiFiUDP, on a real datagram socket so a local
+// sender can reach the sketch. Receive only: sending is accepted and dropped.
+
+#include <Arduino.h>
+
+#define HOST_UDP_MAX_PACKET 1500
+
+class WiFiUDP : public Stream {
+public:
+    ~WiFiUDP() { stop(); }
+
+    uint8_t begin(uint16_t port);       // 1 once bound to the port on every interface
+    void stop();
+
+    int parsePacket();                  // Size of the next datagram, 0 if none is waiting
+    int available() override { return length - position; }
+    int read() override { return position < length ? buffer[position++] : -1; }
+    int read(unsigned char *buf, size_t size);
+    int read(char *buf, size_t size) { return read((unsigned char *)buf, size); }
+    int peek() override { return position < length ? buffer[position] : -1; }
+    void flush() {}
+
+    int beginPacket(IPAddress ip, uint16_t port) { (void)ip; (void)port; return 1; }
+    int endPacket() { return 1; }
+    size_t write(uint8_t c) override { (void)c; return 1; }
+    size_t write(const uint8_t *buf, size_t size) override { (void)buf; return size; }
+    using Print::write;
+
+    IPAddress remoteIP() { return remoteAddress; }
+    uint16_t remotePort() { return remotePortNumber; }
+
+private:
+    int fd = -1;
+    uint8_t buffer[HOST_UDP_MAX_PACKET];
+    int length = 0;
+    int position = 0;
+    IPAddress remoteAddress;
+    uint16_t remotePortNumber = 0;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Push generated frames to the matrix's frame stream (see frame_stream.h).
+
+Stands in for a real content source on the LAN: it opens one TCP connection
+to the device, sends frames at a fixed rate and prints the rate it actually
+reached every second. The device's /metrics shows how many it received and
+how many made it to the panel.
+
+    python host/frame_sender.py 192.168.1.50 --fps 30
+    python host/frame_sender.py 192.168.1.50 --mode box --fps 60 --seconds 10
+
+"plasma" sends full frames; "box" sends only the rectangle a bouncing square
+moved through, the way a sender with damage tracking would.
+"""
+
+import argparse
+import math
+import socket
+import struct
+import time
+
+PORT = 7777
+WIDTH = 64
+HEIGHT = 17     # Animation zone rows
+BOX = 6
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def frame(x, y, width, height, pixels):
+    """Header and little-endian RGB565 pixels, row by row."""
+    return b"FR" + bytes((x, y, width, height)) + struct.pack(f"<{len(pixels)}H", *pixels)
+
+
+def plasma(t):
+    pixels = []
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            v = math.sin(x / 6 + t) + math.sin(y / 3 - t * 1.3) + math.sin((x + y) / 9 + t * 0.7)
+            pixels.append(rgb565(int(127 + 127 * math.sin(v)),
+                                 int(127 + 127 * math.sin(v + 2.1)),
+                                 int(127 + 127 * math.sin(v + 4.2))))
+    return frame(0, 0, WIDTH, HEIGHT, pixels)
+
+
+class Box:
+    def __init__(self):
+        self.x, self.y, self.dx, self.dy = 0, 0, 1, 1
+
+    def next(self, n):
+        """The rectangle covering the box's old and new position."""
+        old_x, old_y = self.x, self.y
+        if not 0 <= self.x + self.dx <= WIDTH - BOX:
+            self.dx = -self.dx
+        if not 0 <= self.y + self.dy <= HEIGHT - BOX:
+            self.dy = -self.dy
+        self.x += self.dx
+        self.y += self.dy
+
+        left, top = min(old_x, self.x), min(old_y, self.y)
+        width, height = BOX + abs(self.dx), BOX + abs(self.dy)
+        color = rgb565(255, (n * 4) & 0xFF, 64)
+        pixels = [color if self.x <= left + c < self.x + BOX and self.y <= top + r < self.y + BOX else 0
+                  for r in range(height) for c in range(width)]
+        return frame(left, top, width, height, pixels)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host", help="device IP address")
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--fps", type=float, default=30)
+    parser.add_argument("--seconds", type=float, default=0, help="stop after this long (default: run until ^C)")
+    parser.add_argument("--mode", choices=("plasma", "box"), default="plasma")
+    args = parser.parse_args()
+
+    sock = socket.create_connection((args.host, args.port))
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    box = Box()
+    if args.mode == "box":
+        sock.sendall(frame(0, 0, WIDTH, HEIGHT, [0] * (WIDTH * HEIGHT)))
+
+    period = 1 / args.fps
+    start = next_frame = report = time.monotonic()
+    sent = sent_bytes = 0
+    try:
+        while not args.seconds or time.monotonic() - start < args.seconds:
+            data = plasma(time.monotonic() - start) if args.mode == "plasma" else box.next(sent)
+            sock.sendall(data)
+            sent += 1
+            sent_bytes += len(data)
+
+            now = time.monotonic()
+            if now - report >= 1:
+                print(f"{sent / (now - start):.1f} fps, {sent_bytes / (now - start) / 1024:.1f} KB/s")
+                report = now
+            next_frame += period
+            time.sleep(max(0, next_frame - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
+
+    elapsed = time.monotonic() - start
+    print(f"sent {sent} frames, {sent_bytes} bytes in {elapsed:.1f} s ({sent / elapsed:.1f} fps)")
+
+
+if __name__ == "__main__":
+    main()
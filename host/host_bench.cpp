@@ -0,0 +1,306 @@
+// Frame-time benchmark for the widget and animation draw functions. Each case
+// runs one draw function in isolation against the host framebuffer for N
+// frames of simulated time (16 ms apart, ticking its animation state like the
+// compositor does) and reports per-frame cost, drawPixel calls and heap
+// allocations.
+
+#include <algorithm>
+#include <new>
+#include <chrono>
+#include <vector>
+
+#include "matrix_display.h"
+#include "widgets.h"
+#include "teams_widget.h"
+#include "host_runtime.h"
+
+extern uint16_t colors[];
+
+// Heap allocations since start-up. The link wraps malloc/calloc/realloc, so
+// this sees the sketch's own calls and the Arduino String stand-in, which
+// allocates the way the real core does.
+static uint32_t allocations = 0;
+
+#ifdef HOST_WRAP_MALLOC
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) { allocations++; return __real_malloc(size); }
+void *__wrap_calloc(size_t count, size_t size) { allocations++; return __real_calloc(count, size); }
+void *__wrap_realloc(void *ptr, size_t size) { allocations++; return __real_realloc(ptr, size); }
+}
+
+void *operator new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+#endif
+
+struct BenchCase {
+    String name;
+    void (*setup)(int arg);
+    bool (*tick)();
+    void (*draw)();
+    int arg;
+};
+
+struct BenchResult {
+    String name;
+    int frames;
+    double meanNs;
+    uint64_t p50Ns;
+    uint64_t p99Ns;
+    uint64_t maxNs;
+    double meanDrawPixels;
+    uint32_t maxDrawPixels;
+    double meanAllocations;
+    uint32_t maxAllocations;
+};
+
+// ---- Widgets ----
+
+static bool noTick() { return false; }
+
+static void setupClock(int) { setWidget(WIDGET_CLOCK); }
+static void drawClock() { drawClockWidget(0, 0, WIDTH, WIDGET_ZONE_HEIGHT); }
+
+static int benchWeatherIndex = 0;
+
+static void setupWeather(int index) {
+    setWidget(WIDGET_WEATHER);
+    setWeatherDebugMode(true);
+    benchWeatherIndex = index;
+    selectDebugWeather(index);
+}
+
+static bool tickWeather() {
+    // Hold the condition; selecting it again restarts the debug auto-advance
+    selectDebugWeather(benchWeatherIndex);
+    return tickWeatherWidget();
+}
+
+static void drawWeather() { drawWeatherWidget(0, 0, WIDTH, WIDGET_ZONE_HEIGHT); }
+
+static void setupTeams(int) {
+    setWidget(WIDGET_TEAMS);
+    currentTeams.status = "Available";
+    currentTeams.statusColor = getTeamsStatusColor(currentTeams.status);
+    publishTeamsData();
+}
+
+static void drawTeams() { drawTeamsWidget(0, 0, WIDTH, WIDGET_ZONE_HEIGHT); }
+
+static void setupStocks(int) { setWidget(WIDGET_STOCKS); }
+static void drawStocks() { drawStocksWidget(0, 0, WIDTH, WIDGET_ZONE_HEIGHT); }
+
+static void setupSpotify(int) {
+    setWidget(WIDGET_SPOTIFY);
+    currentSpotifyTrack.trackName = "Bohemian Rhapsody";
+    currentSpotifyTrack.artistName = "Queen";
+    currentSpotifyTrack.albumName = "A Night at the Opera";
+    currentSpotifyTrack.durationMs = 354000;
+    currentSpotifyTrack.progressMs = 60000;
+    currentSpotifyTrack.progressAnchor = millis();
+    currentSpotifyTrack.isPlaying = true;
+    currentSpotifyTrack.dataValid = true;
+    currentSpotifyTrack.lastUpdate = millis();
+    publishSpotifyData();
+}
+
+static void drawSpotify() { drawSpotifyWidget(0, 0, WIDTH, WIDGET_ZONE_HEIGHT); }
+
+// ---- Animations ----
+
+static void setupPattern(int) { setAnimationPattern(); }
+static void setupText(int) { setAnimationText("Hello from the MatrixPortal M4!"); }
+static void setupTruck(int) { setTruckAnimation(); }
+static void setupSolid(int) { setAnimationColor(4); }
+
+static bool tickNone() { return false; }
+
+// The pattern as it was drawn before palette cycling, one drawPixel and
+// color565 per pixel, kept as the reference for the palette-cycled version
+static void drawPatternReference() {
+    for (int x = 0; x < WIDTH; x++) {
+        for (int y = ANIMATION_ZONE_Y; y < HEIGHT; y++) {
+            int colorIndex = ((x + y + patternFrame) / 8) % 6 + 1;  // Skip black
+            uint16_t dimColor = colors[colorIndex];
+            int r = ((dimColor >> 11) & 0x1F) >> 1;  // Half brightness
+            int g = ((dimColor >> 5) & 0x3F) >> 1;
+            int b = (dimColor & 0x1F) >> 1;
+            matrix.drawPixel(x, y, matrix.color565(r << 3, g << 2, b << 3));
+        }
+    }
+}
+
+// Animation draws only paint; clear the zone first like the compositor does
+static void clearAnimationRows() {
+    memset(matrix.getBuffer() + ANIMATION_ZONE_Y * WIDTH, 0,
+           ANIMATION_ZONE_HEIGHT * WIDTH * sizeof(uint16_t));
+}
+
+static void drawScrollText() { clearAnimationRows(); scrollText(); }
+static void drawTruck() { clearAnimationRows(); animateTruck(); }
+
+// ---- Runner ----
+
+static void resetState() {
+    setWeatherDebugMode(false);
+    currentWeather.dataValid = false;
+    currentSpotifyTrack.dataValid = false;
+    publishWeatherData();
+    publishSpotifyData();
+    clearAnimationZone();
+    setWidget(WIDGET_NONE);
+    matrix.fillScreen(0);
+}
+
+static BenchResult runCase(const BenchCase &bench, int frames) {
+    resetState();
+    bench.setup(bench.arg);
+
+    // First draw builds any cached sprites/strips; keep it out of the numbers
+    bench.tick();
+    bench.draw();
+
+    std::vector<uint64_t> ns(frames);
+    BenchResult result = {bench.name, frames, 0, 0, 0, 0, 0, 0, 0, 0};
+    uint64_t totalNs = 0;
+    uint64_t totalPixels = 0;
+    uint64_t totalAllocations = 0;
+
+    for (int i = 0; i < frames; i++) {
+        hostAdvanceMillis(16);
+        uint32_t allocationsBefore = allocations;
+        bench.tick();
+
+        uint32_t pixelsBefore = hostDrawPixelCalls;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bench.draw();
+        ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        uint32_t pixels = hostDrawPixelCalls - pixelsBefore;
+        uint32_t frameAllocations = allocations - allocationsBefore;
+
+        totalNs += ns[i];
+        totalPixels += pixels;
+        totalAllocations += frameAllocations;
+        result.maxDrawPixels = max(result.maxDrawPixels, pixels);
+        result.maxAllocations = max(result.maxAllocations, frameAllocations);
+    }
+
+    std::sort(ns.begin(), ns.end());
+    result.meanNs = frames > 0 ? (double)totalNs / frames : 0;
+    result.p50Ns = frames > 0 ? ns[frames / 2] : 0;
+    result.p99Ns = frames > 0 ? ns[min(frames - 1, (frames * 99) / 100)] : 0;
+    result.maxNs = frames > 0 ? ns[frames - 1] : 0;
+    result.meanDrawPixels = frames > 0 ? (double)totalPixels / frames : 0;
+    result.meanAllocations = frames > 0 ? (double)totalAllocations / frames : 0;
+    return result;
+}
+
+static void writeJSON(FILE *f, const std::vector<BenchResult> &results) {
+    fprintf(f, "[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        fprintf(f, "  {\"name\": \"%s\", \"frames\": %d, \"mean_ns\": %.0f, \"p50_ns\": %llu, "
+                   "\"p99_ns\": %llu, \"max_ns\": %llu, \"mean_draw_pixels\": %.1f, \"max_draw_pixels\": %u, "
+                   "\"mean_allocations\": %.2f, \"max_allocations\": %u}%s\n",
+                r.name.c_str(), r.frames, r.meanNs, (unsigned long long)r.p50Ns,
+                (unsigned long long)r.p99Ns, (unsigned long long)r.maxNs,
+                r.meanDrawPixels, r.maxDrawPixels, r.meanAllocations, r.maxAllocations,
+                i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "]\n");
+}
+
+static void usage(const char *argv0) {
+    printf("Usage: %s [options]\n"
+           "  --frames N      frames per case (default 2000)\n"
+           "  --filter TEXT   only run cases whose name contains TEXT\n"
+           "  --json FILE     write results as JSON (\"-\" for stdout)\n"
+           "  --zero-alloc    fail if any frame (tick + draw) allocates from the heap\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    int frames = 2000;
+    const char *filter = NULL;
+    const char *jsonPath = NULL;
+    bool zeroAlloc = false;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) frames = max(1, atoi(argv[++i]));
+        else if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--json" && hasValue) jsonPath = argv[++i];
+        else if (arg == "--zero-alloc") zeroAlloc = true;
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    hostSetSerialEnabled(false);
+    initializeMatrix();
+    initializeWidgets();
+
+    std::vector<BenchCase> cases;
+    cases.push_back({"widget/clock", setupClock, tickClockWidget, drawClock, 0});
+    for (int i = 0; i < getDebugWeatherCount(); i++) {
+        cases.push_back({"widget/weather/" + getDebugWeatherDescription(i), setupWeather, tickWeather, drawWeather, i});
+    }
+    cases.push_back({"widget/teams", setupTeams, noTick, drawTeams, 0});
+    cases.push_back({"widget/stocks", setupStocks, noTick, drawStocks, 0});
+    cases.push_back({"widget/spotify", setupSpotify, tickSpotifyWidget, drawSpotify, 0});
+    cases.push_back({"animation/pattern", setupPattern, tickPattern, animatePattern, 0});
+    cases.push_back({"animation/pattern_drawpixel_reference", setupPattern, tickPattern, drawPatternReference, 0});
+    cases.push_back({"animation/scroll_text", setupText, tickScrollText, drawScrollText, 0});
+    cases.push_back({"animation/truck", setupTruck, tickTruck, drawTruck, 0});
+    cases.push_back({"animation/solid", setupSolid, tickNone, drawSolidColor, 0});
+
+    std::vector<BenchResult> results;
+    for (const BenchCase &bench : cases) {
+        if (filter && bench.name.indexOf(filter) < 0) continue;
+        results.push_back(runCase(bench, frames));
+    }
+
+    printf("%-44s %10s %10s %10s %12s %8s\n", "case", "mean ns", "p99 ns", "max ns", "drawPixel", "allocs");
+    for (const BenchResult &r : results) {
+        printf("%-44s %10.0f %10llu %10llu %12.1f %8.2f\n", r.name.c_str(), r.meanNs,
+               (unsigned long long)r.p99Ns, (unsigned long long)r.maxNs, r.meanDrawPixels,
+               r.meanAllocations);
+    }
+
+    if (jsonPath) {
+        FILE *f = strcmp(jsonPath, "-") == 0 ? stdout : fopen(jsonPath, "w");
+        if (!f) {
+            fprintf(stderr, "Failed to write %s\n", jsonPath);
+            return 1;
+        }
+        writeJSON(f, results);
+        if (f != stdout) fclose(f);
+    }
+
+    if (zeroAlloc) {
+#ifndef HOST_WRAP_MALLOC
+        fprintf(stderr, "--zero-alloc needs a build with HOST_WRAP_MALLOC\n");
+        return 1;
+#endif
+        int failures = 0;
+        for (const BenchResult &r : results) {
+            if (r.maxAllocations > 0) {
+                fprintf(stderr, "%s: up to %u heap allocations per frame\n", r.name.c_str(), r.maxAllocations);
+                failures++;
+            }
+        }
+        if (failures > 0) return 1;
+        printf("No heap allocations in any frame\n");
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+// Placeholder credentials for the host build - the host has no network access
+
+char ssid[] = "host";
+char wifiPass[] = "";
+char ssid2[] = "";
+
+char weatherApiKey[] = "";
+char timeZone[] = "UTC";
+
+char spotifyClientId[] = "";
+char spotifyClientSecret[] = "";
+
+char msGraphClientId[] = "";
+char msGraphClientSecret[] = "";
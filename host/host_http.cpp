@@ -0,0 +1,350 @@
+// Fuzz and throughput harness for the web server's request handling. Every
+// request in the corpus, and every mutation of one, is parsed twice: whole,
+// and in random fragments the way it arrives from a socket. The two parses
+// must agree, every span must point into the parser's buffer, and a complete
+// request goes on through processRequest(), which must answer with a status
+// line. Each corpus request must also give the result in the .expect file
+// next to it. --bench times parsing and parsing plus dispatch per corpus
+// request.
+
+#include <chrono>
+#include <dirent.h>
+#include <string>
+#include <vector>
+
+#include "web_server.h"
+#include "matrix_display.h"
+#include "widgets.h"
+#include "host_runtime.h"
+
+// Collects what processRequest() sends
+class CaptureClient : public WiFiClient {
+public:
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t size) override {
+        if (head.size() < 16) head.append((const char *)buf, min(size, 16 - head.size()));
+        bytes += size;
+        return size;
+    }
+    using Print::write;
+
+    std::string head;
+    size_t bytes = 0;
+};
+
+// A corpus request's .expect file, one "key value" line each: status is the
+// parser's error status, the status processRequest() answered with, or
+// "incomplete". A request that parses also lists its method, path, query and
+// body, each as the exact bytes of the span (the value may be empty).
+struct Expected {
+    std::string status;
+    std::string method;
+    std::string path;
+    std::string query;
+    std::string body;
+    bool parses;                // The spans are given: the request must parse
+};
+
+struct CorpusEntry {
+    String name;
+    std::string data;
+    Expected expected;
+};
+
+static uint32_t rngState = 1;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static void usage(const char *argv0) {
+    printf("Usage: %s [options]\n"
+           "  --corpus DIR        .http requests to start from, each with its .expect file (default host/http_corpus)\n"
+           "  --mutate N          also run N random mutations of the corpus (default 20000)\n"
+           "  --seed N            mutation seed (default 1)\n"
+           "  --bench N           time N parses of each corpus request instead of fuzzing\n"
+           "  --verbose           keep the sketch's Serial output\n", argv0);
+}
+
+static bool readFile(const std::string &path, std::string &data) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.append(chunk, n);
+    fclose(f);
+    return true;
+}
+
+// Fills expected from an .expect file; false if it is missing or incomplete
+static bool readExpected(const std::string &path, Expected &expected) {
+    std::string text;
+    if (!readFile(path, text)) return false;
+
+    bool hasMethod = false, hasPath = false, hasQuery = false, hasBody = false;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+
+        size_t space = line.find(' ');
+        std::string key = line.substr(0, space);
+        std::string value = space == std::string::npos ? "" : line.substr(space + 1);
+        if (key == "status") expected.status = value;
+        else if (key == "method") { expected.method = value; hasMethod = true; }
+        else if (key == "path") { expected.path = value; hasPath = true; }
+        else if (key == "query") { expected.query = value; hasQuery = true; }
+        else if (key == "body") { expected.body = value; hasBody = true; }
+        else if (!key.empty()) return false;
+    }
+
+    // The spans come all together or not at all
+    expected.parses = hasMethod && hasPath && hasQuery && hasBody;
+    return !expected.status.empty() && (expected.parses || !(hasMethod || hasPath || hasQuery || hasBody));
+}
+
+static bool loadCorpus(const char *dir, std::vector<CorpusEntry> &corpus) {
+    DIR *d = opendir(dir);
+    if (!d) return false;
+    bool complete = true;
+    while (dirent *entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name[0] == '.' || name.size() < 5 || name.compare(name.size() - 5, 5, ".http") != 0) continue;
+        std::string path = std::string(dir) + "/" + name;
+        CorpusEntry item;
+        item.name = name.c_str();
+        if (!readFile(path, item.data)) continue;
+        if (!readExpected(path.substr(0, path.size() - 5) + ".expect", item.expected)) {
+            fprintf(stderr, "%s: missing or incomplete .expect file\n", name.c_str());
+            complete = false;
+        }
+        corpus.push_back(item);
+    }
+    closedir(d);
+    if (!complete) return false;
+    std::sort(corpus.begin(), corpus.end(), [](const CorpusEntry &a, const CorpusEntry &b) {
+        return strcmp(a.name.c_str(), b.name.c_str()) < 0;
+    });
+    return true;
+}
+
+// Flattens a parse for comparison
+static std::string describe(const HttpRequestParser &parser) {
+    const HttpRequest &request = parser.request();
+    std::string text = std::to_string(parser.result()) + " " + std::to_string(parser.errorStatus());
+    if (parser.result() != HTTP_PARSE_COMPLETE) return text;
+
+    const HttpSpan spans[] = {request.method, request.path, request.query, request.body};
+    for (const HttpSpan &span : spans) text += "|" + std::string(span.data ? span.data : "", span.length);
+    for (uint8_t i = 0; i < request.headerCount; i++) {
+        text += "|" + std::string(request.headers[i].name.data, request.headers[i].name.length) +
+                ":" + std::string(request.headers[i].value.data, request.headers[i].value.length);
+    }
+    return text;
+}
+
+static bool insideParser(const HttpRequestParser &parser, const HttpSpan &span) {
+    if (span.length == 0) return true;
+    const char *start = (const char *)&parser;
+    const char *end = start + sizeof(parser);
+    return span.data >= start && span.data + span.length <= end;
+}
+
+static bool spansInside(const HttpRequestParser &parser) {
+    const HttpRequest &request = parser.request();
+    if (!insideParser(parser, request.method) || !insideParser(parser, request.path) ||
+        !insideParser(parser, request.query) || !insideParser(parser, request.body)) return false;
+    for (uint8_t i = 0; i < request.headerCount; i++) {
+        if (!insideParser(parser, request.headers[i].name) || !insideParser(parser, request.headers[i].value)) return false;
+    }
+    return true;
+}
+
+// Feeds the input in random fragments through writePointer()/advance()
+static void parseFragmented(HttpRequestParser &parser, const std::string &data) {
+    parser.reset();
+    size_t offset = 0;
+    while (offset < data.size() && parser.result() == HTTP_PARSE_INCOMPLETE && parser.room() > 0) {
+        size_t count = min((size_t)1 + nextRandom() % 96, min(data.size() - offset, parser.room()));
+        memcpy(parser.writePointer(), data.data() + offset, count);
+        parser.advance(count);
+        offset += count;
+    }
+}
+
+static HttpRequestParser whole;
+static HttpRequestParser fragmented;
+static uint32_t statusCounts[600];
+
+static bool spanIs(const HttpSpan &span, const std::string &text) {
+    return span.length == text.size() && (text.empty() || memcmp(span.data, text.data(), text.size()) == 0);
+}
+
+// False, saying why, if a corpus request's result isn't the one it expects
+static bool matchesExpected(const String &name, const std::string &status, const Expected &expected) {
+    if (status != expected.status) {
+        printf("%s: status %s, expected %s\n", name.c_str(), status.c_str(), expected.status.c_str());
+        return false;
+    }
+    bool parsed = whole.result() == HTTP_PARSE_COMPLETE;
+    if (parsed != expected.parses) {
+        printf("%s: %s, but the .expect file %s spans\n", name.c_str(), parsed ? "parsed" : "didn't parse",
+               expected.parses ? "gives" : "has no");
+        return false;
+    }
+    if (!parsed) return true;
+
+    const HttpRequest &request = whole.request();
+    if (!spanIs(request.method, expected.method) || !spanIs(request.path, expected.path) ||
+        !spanIs(request.query, expected.query) || !spanIs(request.body, expected.body)) {
+        printf("%s: parsed as %s, expected %s %s %s %s\n", name.c_str(), describe(whole).c_str(),
+               expected.method.c_str(), expected.path.c_str(), expected.query.c_str(), expected.body.c_str());
+        return false;
+    }
+    return true;
+}
+
+// False if the two parses disagree, processRequest() didn't answer, or a
+// corpus request (expected not null) gave another result than it expects
+static bool check(const String &name, const std::string &data, const Expected *expected) {
+    whole.reset();
+    whole.feed(data.data(), data.size());
+    parseFragmented(fragmented, data);
+
+    std::string wholeParse = describe(whole);
+    std::string fragmentedParse = describe(fragmented);
+    if (wholeParse != fragmentedParse) {
+        printf("%s: whole and fragmented parses differ\n  %s\n  %s\n", name.c_str(), wholeParse.c_str(),
+               fragmentedParse.c_str());
+        return false;
+    }
+    if (!spansInside(whole)) {
+        printf("%s: span outside the parser buffer\n", name.c_str());
+        return false;
+    }
+
+    std::string status = "incomplete";
+    if (whole.result() == HTTP_PARSE_ERROR) {
+        statusCounts[whole.errorStatus() % 600]++;
+        status = std::to_string(whole.errorStatus());
+    } else if (whole.result() == HTTP_PARSE_COMPLETE) {
+        CaptureClient client;
+        processRequest(client, whole.request());
+        if (client.head.compare(0, 9, "HTTP/1.1 ") != 0) {
+            printf("%s: processRequest sent no status line\n", name.c_str());
+            return false;
+        }
+        statusCounts[atoi(client.head.c_str() + 9) % 600]++;
+        status = std::to_string(atoi(client.head.c_str() + 9));
+    }
+    return !expected || matchesExpected(name, status, *expected);
+}
+
+static void mutate(std::string &data) {
+    static const char *const inserts[] = {
+        "\r\n", "\n", "\r", ":", " ", "?", "%", "&", "\t", "/",
+        "\r\n\r\n", "Content-Length: 5\r\n", "Content-Length: 99999\r\n",
+        "Transfer-Encoding: chunked\r\n", "X-Padding: aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\r\n",
+    };
+    int operations = 1 + nextRandom() % 4;
+    for (int i = 0; i < operations; i++) {
+        size_t at = data.empty() ? 0 : nextRandom() % data.size();
+        switch (nextRandom() % 6) {
+            case 0: if (!data.empty()) data[at] = (char)nextRandom(); break;
+            case 1: data.insert(at, inserts[nextRandom() % (sizeof(inserts) / sizeof(inserts[0]))]); break;
+            case 2: data.erase(at, 1 + nextRandom() % 32); break;
+            case 3: data.insert(at, data.substr(at, 1 + nextRandom() % 256)); break;
+            case 4: data.resize(at); break;
+            case 5: data.insert(at, std::string(1 + nextRandom() % 3000, 'a' + nextRandom() % 26)); break;
+        }
+    }
+}
+
+static void bench(const std::vector<CorpusEntry> &corpus, int iterations) {
+    printf("%-32s %8s %12s %10s %16s\n", "request", "bytes", "parse ns", "MB/s", "+dispatch ns");
+    for (const CorpusEntry &entry : corpus) {
+        whole.reset();
+        if (whole.feed(entry.data.data(), entry.data.size()) != HTTP_PARSE_COMPLETE) continue;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            whole.reset();
+            whole.feed(entry.data.data(), entry.data.size());
+        }
+        double parseNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count() / (double)iterations;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            whole.reset();
+            whole.feed(entry.data.data(), entry.data.size());
+            CaptureClient client;
+            processRequest(client, whole.request());
+        }
+        double dispatchNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count() / (double)iterations;
+
+        printf("%-32s %8zu %12.0f %10.1f %16.0f\n", entry.name.c_str(), entry.data.size(), parseNs,
+               entry.data.size() / parseNs * 1000.0, dispatchNs);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *corpusDir = HOST_HTTP_CORPUS;
+    int mutations = 20000;
+    int benchIterations = 0;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--corpus" && hasValue) corpusDir = argv[++i];
+        else if (arg == "--mutate" && hasValue) mutations = max(0, atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) rngState = max(1, atoi(argv[++i]));
+        else if (arg == "--bench" && hasValue) benchIterations = max(1, atoi(argv[++i]));
+        else if (arg == "--verbose") verbose = true;
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<CorpusEntry> corpus;
+    if (!loadCorpus(corpusDir, corpus) || corpus.empty()) {
+        fprintf(stderr, "No usable requests in %s\n", corpusDir);
+        return 1;
+    }
+
+    hostSetSerialEnabled(verbose);
+    initializeMatrix();
+    initializeWidgets();
+
+    if (benchIterations > 0) {
+        bench(corpus, benchIterations);
+        return 0;
+    }
+
+    int failures = 0;
+    for (const CorpusEntry &entry : corpus) {
+        if (!check(entry.name, entry.data, &entry.expected)) failures++;
+    }
+    for (int i = 0; i < mutations; i++) {
+        const CorpusEntry &entry = corpus[nextRandom() % corpus.size()];
+        std::string data = entry.data;
+        mutate(data);
+        if (!check(entry.name + " mutation " + String(i), data, nullptr)) failures++;
+    }
+
+    printf("%zu corpus requests, %d mutations, %d failures\n", corpus.size(), mutations, failures);
+    printf("responses:");
+    for (int status = 0; status < 600; status++) {
+        if (statusCounts[status]) printf(" %d x%u", status, statusCounts[status]);
+    }
+    printf("\n");
+    return failures > 0 ? 1 : 0;
+}
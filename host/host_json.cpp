@@ -0,0 +1,167 @@
+// Peak memory of the API response parsers. Each recorded response in
+// host/json_payloads goes through the parse function its widget runs on a
+// collected body. The document must fit the JSON arena with room to spare, and
+// the heap may only see the widget's own String fields and log line: a parser
+// that let ArduinoJson fall back to the heap shows up as kilobytes here.
+//
+// Needs the real ArduinoJson (the stand-in doesn't parse) and a Linux link,
+// which wraps malloc to count and size every allocation.
+
+#include <malloc.h>
+#include <new>
+#include <string>
+
+#include "widgets.h"
+#include "teams_widget.h"
+#include "json_arena.h"
+#include "host_runtime.h"
+
+// Parsers the widgets run on a collected response body
+bool parseWeatherJSON(Stream &input);
+bool parseSpotifyResponseFast(Stream &input, uint32_t progressAnchor);
+
+// The arena must keep this much free after the largest response
+#define JSON_ARENA_HEADROOM 1024
+
+static uint32_t allocations = 0;
+static size_t heapLive = 0;
+static size_t heapPeak = 0;
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static void *track(void *p) {
+    if (p) {
+        heapLive += malloc_usable_size(p);
+        if (heapLive > heapPeak) heapPeak = heapLive;
+    }
+    return p;
+}
+
+void *__wrap_malloc(size_t size) { allocations++; return track(__real_malloc(size)); }
+void *__wrap_calloc(size_t count, size_t size) { allocations++; return track(__real_calloc(count, size)); }
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocations++;
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void *p = __real_realloc(ptr, size);
+    if (p || size == 0) {
+        heapLive -= old;
+        track(p);
+    }
+    return p;
+}
+void __wrap_free(void *ptr) {
+    if (ptr) heapLive -= malloc_usable_size(ptr);
+    __real_free(ptr);
+}
+}
+
+void *operator new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+// A recorded body, read the way the parsers read HttpBodyStream
+class PayloadStream : public Stream {
+public:
+    explicit PayloadStream(const std::string &data) : data(data) {}
+
+    int available() override { return (int)(data.size() - position); }
+    int read() override { return position < data.size() ? (uint8_t)data[position++] : -1; }
+    int peek() override { return position < data.size() ? (uint8_t)data[position] : -1; }
+    size_t write(uint8_t c) override { (void)c; return 0; }
+    using Print::write;
+
+private:
+    const std::string &data;
+    size_t position = 0;
+};
+
+static bool parseWeather(Stream &input) {
+    return parseWeatherJSON(input) && currentWeather.location == "Leesburg" && currentWeather.conditionCode == 1006;
+}
+
+static bool parseSpotify(Stream &input) {
+    return parseSpotifyResponseFast(input, millis()) && currentSpotifyTrack.trackName == "Under Pressure" &&
+           currentSpotifyTrack.artistName == "David Bowie" && currentSpotifyTrack.durationMs == 248440;
+}
+
+static bool parseTeams(Stream &input) {
+    return parseTeamsPresence(input) && currentTeams.status == "Busy" && currentTeams.details == "InAMeeting";
+}
+
+struct PayloadCase {
+    const char *file;
+    bool (*parse)(Stream &input);   // Parses and checks the fields the widget kept
+    uint32_t maxAllocations;        // The kept String fields, the snapshot copy and the log line
+    size_t maxHeap;                 // Peak heap above where the parse started, bytes
+};
+
+static const PayloadCase cases[] = {
+    {"weather_current.json", parseWeather, 48, 2048},
+    {"spotify_currently_playing.json", parseSpotify, 24, 1024},
+    {"graph_presence.json", parseTeams, 16, 1024},
+};
+
+static bool loadPayload(const char *name, std::string &data) {
+    std::string path = std::string(HOST_JSON_PAYLOADS) + "/" + name;
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    char chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.append(chunk, n);
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    hostSetSerialEnabled(argc > 1 && strcmp(argv[1], "--verbose") == 0);
+    initializeWidgets();
+
+    printf("%-32s %8s %8s %12s %10s\n", "payload", "bytes", "arena", "allocations", "heap");
+    int failures = 0;
+    for (const PayloadCase &payload : cases) {
+        std::string data;
+        if (!loadPayload(payload.file, data)) {
+            printf("%s: can't read it\n", payload.file);
+            failures++;
+            continue;
+        }
+
+        PayloadStream input(data);
+        uint32_t allocationsBefore = allocations;
+        size_t heapBefore = heapLive;
+        heapPeak = heapLive;
+        bool parsed = payload.parse(input);
+        uint32_t parseAllocations = allocations - allocationsBefore;
+        size_t parseHeap = heapPeak - heapBefore;
+
+        printf("%-32s %8zu %8zu %12u %10zu\n", payload.file, data.size(), jsonArenaHighWater(),
+               parseAllocations, parseHeap);
+        if (!parsed) {
+            printf("  didn't parse, or the widget kept the wrong values\n");
+            failures++;
+        }
+        if (jsonArenaHighWater() > JSON_ARENA_SIZE - JSON_ARENA_HEADROOM) {
+            printf("  arena high water over %d bytes\n", JSON_ARENA_SIZE - JSON_ARENA_HEADROOM);
+            failures++;
+        }
+        if (parseAllocations > payload.maxAllocations) {
+            printf("  over %u heap allocations\n", payload.maxAllocations);
+            failures++;
+        }
+        if (parseHeap > payload.maxHeap) {
+            printf("  over %zu bytes of heap\n", payload.maxHeap);
+            failures++;
+        }
+    }
+
+    printf("%zu payloads, %d failures\n", sizeof(cases) / sizeof(cases[0]), failures);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+// Headless Linux runner for the sketch. Drives the display task's frame loop
+// and the network task's polling on one thread with a simulated clock, and can
+// dump every shown frame as a PPM image.
+
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+
+#include "matrix_display.h"
+#include "widgets.h"
+#include "wifi_manager.h"
+#include "web_server.h"
+#include "profiler.h"
+#include "http_pool.h"
+#include "token_manager.h"
+#include "warm_start.h"
+#include "flash_store.h"
+#include "frame_stream.h"
+#include "pixel_receiver.h"
+#include "host_runtime.h"
+
+static void usage(const char *argv0) {
+    printf("Usage: %s [options]\n"
+           "  --frames N          display ticks to run (16 ms each, default 600)\n"
+           "  --animation NAME    none | solid | pattern | text | truck | pixels\n"
+           "  --color N           color index for the solid animation (0-7)\n"
+           "  --text MESSAGE      scrolling text (implies --animation text)\n"
+           "  --widget N          widget number as in WidgetType (0 = none)\n"
+           "  --weather-debug     cycle through the debug weather conditions\n"
+           "  --out DIR           write each shown frame as DIR/frame_NNNNN.ppm\n"
+           "  --scale N           PPM pixel size (default 8)\n"
+           "  --flash FILE        keep the QSPI flash image in FILE across runs\n"
+           "  --wifi-outage A B   drop the WiFi link from A until B ms after start-up, to watch\n"
+           "                      the reconnection and its \"WiFi OK\" overlay\n"
+           "  --realtime          pace ticks at 16 ms of wall time, for live input such as\n"
+           "                      host/pixel_sender.py with --animation pixels\n"
+           "  --metrics           print the /metrics stage timings at the end\n"
+           "  --verbose           keep the sketch's Serial output\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    int frames = 600;
+    int scale = 8;
+    const char *animation = NULL;
+    const char *text = NULL;
+    const char *outDir = NULL;
+    const char *flashFile = NULL;
+    int color = -1;
+    int widget = -1;
+    bool weatherDebug = false;
+    bool verbose = false;
+    bool metrics = false;
+    bool realtime = false;
+    unsigned long outageFrom = 0;
+    unsigned long outageTo = 0;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) frames = atoi(argv[++i]);
+        else if (arg == "--animation" && hasValue) animation = argv[++i];
+        else if (arg == "--color" && hasValue) color = atoi(argv[++i]);
+        else if (arg == "--text" && hasValue) text = argv[++i];
+        else if (arg == "--widget" && hasValue) widget = atoi(argv[++i]);
+        else if (arg == "--weather-debug") weatherDebug = true;
+        else if (arg == "--out" && hasValue) outDir = argv[++i];
+        else if (arg == "--scale" && hasValue) scale = max(1, atoi(argv[++i]));
+        else if (arg == "--flash" && hasValue) flashFile = argv[++i];
+        else if (arg == "--realtime") realtime = true;
+        else if (arg == "--wifi-outage" && i + 2 < argc) {
+            outageFrom = strtoul(argv[++i], NULL, 10);
+            outageTo = strtoul(argv[++i], NULL, 10);
+        }
+        else if (arg == "--metrics") metrics = true;
+        else if (arg == "--verbose") verbose = true;
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    hostSetSerialEnabled(verbose);
+    hostSetWiFiOutage(outageFrom, outageTo);
+    if (flashFile) hostSetFlashFile(flashFile);
+
+    // Same bring-up as setup(), minus the scheduler
+    initializeProfiler();
+    initializeMatrix();
+    initializeWidgets();
+    restoreWarmStart();
+    initializeWiFi();
+    initializeWebServer();
+
+    if (widget >= 0) setWidget((WidgetType)widget);
+    if (weatherDebug) setWeatherDebugMode(true);
+    if (text) {
+        setAnimationText(text);
+    } else if (animation) {
+        String name = animation;
+        if (name == "none") clearAnimationZone();
+        else if (name == "solid") setAnimationColor(color >= 0 ? color : 1);
+        else if (name == "pattern") setAnimationPattern();
+        else if (name == "text") setAnimationText(displayText);
+        else if (name == "truck") setTruckAnimation();
+        else if (name == "pixels") setPixelAnimation();
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    } else if (color >= 0) {
+        setAnimationColor(color);
+    }
+
+    if (outDir) mkdir(outDir, 0755);
+
+    uint32_t shown = 0;
+    uint64_t displayNs = 0;
+    uint32_t lastNetworkTick = millis();
+
+    std::chrono::steady_clock::time_point nextTick = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; frame++) {
+        // networkTask runs every 500 ms, every 20 ms while a request is in flight,
+        // and on every tick here while frames are coming in
+        uint32_t pause = 500;
+        if (frameStreamConnected() || pixelReceiverListening()) pause = 0;
+        else if (httpRequestsInFlight() || webClientsPending()) pause = 20;
+        if (millis() - lastNetworkTick >= pause) {
+            handleWiFiReconnection();
+            if (isWiFiConnected()) {
+                runTokenRefresh();
+                updateWidgets();
+                handleWebClients();
+                pollFrameStream();
+                pollPixelReceiver();
+            }
+            pollHttpConnections();
+            saveWarmStart();
+            lastNetworkTick = millis();
+        }
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bool frameShown = updateMatrixDisplay();
+        displayNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+        if (frameShown) {
+            shown++;
+            if (outDir) {
+                char path[512];
+                snprintf(path, sizeof(path), "%s/frame_%05d.ppm", outDir, frame);
+                if (!hostWritePPM(path, matrix.panel(), matrix.width(), matrix.height(), scale)) {
+                    fprintf(stderr, "Failed to write %s\n", path);
+                    return 1;
+                }
+            }
+        }
+
+        hostAdvanceMillis(16);
+        if (realtime) {
+            nextTick += std::chrono::milliseconds(16);
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    // Power stays on through the hold times on the device; here the run just ends
+    flushFlashStore(true);
+
+    printf("%d display ticks, %u frames shown (%.1f%%), %.0f ns/tick\n",
+           frames, shown, frames > 0 ? 100.0 * shown / frames : 0.0,
+           frames > 0 ? (double)displayNs / frames : 0.0);
+
+    if (metrics) {
+        hostSetSerialEnabled(true);
+        printProfileMetrics(Serial);
+        printFrameStreamMetrics(Serial);
+        printPixelReceiverMetrics(Serial);
+    }
+    return 0;
+}
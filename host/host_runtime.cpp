@@ -0,0 +1,73 @@
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include <FreeRTOS_SAMD51.h>
+#include "host_runtime.h"
+
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+uint32_t hostDrawPixelCalls = 0;
+
+static unsigned long hostMicros = 0;
+static bool serialEnabled = true;
+static unsigned long outageFrom = 0;
+static unsigned long outageTo = 0;
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialEnabled) fputc(c, stdout);
+    return 1;
+}
+
+unsigned long millis() { return hostMicros / 1000; }
+unsigned long micros() { return hostMicros; }
+void delay(unsigned long ms) { hostMicros += ms * 1000; }
+long random(long max) { return max > 0 ? rand() % max : 0; }
+long random(long min, long max) { return max > min ? min + rand() % (max - min) : min; }
+
+void hostSetMillis(unsigned long ms) { hostMicros = ms * 1000; }
+void hostAdvanceMillis(unsigned long ms) { hostMicros += ms * 1000; }
+void hostSetSerialEnabled(bool enabled) { serialEnabled = enabled; }
+
+void hostSetWiFiOutage(unsigned long fromMs, unsigned long toMs) {
+    outageFrom = fromMs;
+    outageTo = toMs;
+}
+
+int WiFiClass::status() {
+    return millis() >= outageFrom && millis() < outageTo ? WL_CONNECTION_LOST : WL_CONNECTED;
+}
+
+bool hostWritePPM(const char *path, const uint16_t *pixels, int width, int height, int scale) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", width * scale, height * scale);
+    for (int y = 0; y < height * scale; y++) {
+        for (int x = 0; x < width * scale; x++) {
+            uint16_t c = pixels[(y / scale) * width + x / scale];
+            uint8_t rgb[3] = {
+                (uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+                (uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+                (uint8_t)((c & 0x1F) * 255 / 31)
+            };
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+BaseType_t xTaskCreate(void (*task)(void *), const char *name, uint16_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+    (void)task; (void)name; (void)stackDepth; (void)parameters; (void)priority;
+    if (handle) *handle = NULL;
+    return pdPASS;
+}
+
+void vTaskStartScheduler() {}
+void vTaskDelay(TickType_t ticks) { delay(ticks); }
+void vTaskDelayUntil(TickType_t *previousWakeTime, TickType_t increment) {
+    *previousWakeTime += increment;
+    if (millis() < *previousWakeTime) hostSetMillis(*previousWakeTime);
+}
+TickType_t xTaskGetTickCount() { return millis(); }
+void taskYIELD() {}
+size_t xPortGetFreeHeapSize() { return 0; }
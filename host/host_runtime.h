@@ -0,0 +1,24 @@
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <stdint.h>
+
+// Host-only controls for the stand-in Arduino runtime
+
+void hostSetMillis(unsigned long ms);
+void hostAdvanceMillis(unsigned long ms);
+void hostSetSerialEnabled(bool enabled);
+
+// Report the WiFi link as lost from fromMs until toMs of millis()
+void hostSetWiFiOutage(unsigned long fromMs, unsigned long toMs);
+
+// Back the stand-in QSPI flash with a file; without one it starts erased every run
+void hostSetFlashFile(const char *path);
+
+// drawPixel calls made on any canvas (including the matrix) since start-up
+extern uint32_t hostDrawPixelCalls;
+
+// Write an RGB565 buffer as a binary PPM, each pixel scaled up to a scale x scale block
+bool hostWritePPM(const char *path, const uint16_t *pixels, int width, int height, int scale);
+
+#endif
@@ -0,0 +1,177 @@
+// Throughput and correctness check for the frame stream. A sender's byte
+// stream of full frames and rectangle updates is generated up front, then fed
+// to receiveFrameStream() in random socket-sized pieces while the compositor
+// runs every few polls, as the display task would. Every frame the panel shows
+// must be one the sender completed, in order, and the last one must be shown
+// exactly. Reports receive throughput, compositor cost and frames dropped.
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "frame_stream.h"
+#include "matrix_display.h"
+#include "widgets.h"
+#include "host_runtime.h"
+
+#define ZONE_PIXELS (ANIMATION_ZONE_HEIGHT * WIDTH)
+
+static uint32_t rngState = 1;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// Hands out the stream a segment at a time, the way NINA socket reads do
+class FeedClient : public WiFiClient {
+public:
+    FeedClient(const std::string &data, size_t maxSegment) : data(data), maxSegment(maxSegment) {}
+
+    uint8_t connected() override { return 1; }
+    int available() override {
+        if (segment == 0 && position < data.size()) segment = min(data.size() - position, (size_t)1 + nextRandom() % maxSegment);
+        return segment;
+    }
+    int read(uint8_t *buf, size_t size) override {
+        size_t count = min(size, (size_t)available());
+        memcpy(buf, data.data() + position, count);
+        position += count;
+        segment -= count;
+        return count;
+    }
+    using WiFiClient::read;
+
+    bool finished() const { return position == data.size(); }
+
+private:
+    const std::string &data;
+    size_t maxSegment;
+    size_t position = 0;
+    size_t segment = 0;
+};
+
+static void usage(const char *argv0) {
+    printf("Usage: %s [options]\n"
+           "  --frames N          frames to send (default 3000)\n"
+           "  --delta N           percent of them that are rectangle updates (default 50)\n"
+           "  --segment N         largest socket read in bytes (default 1460)\n"
+           "  --display-every N   run the compositor once per N network polls (default 3)\n"
+           "  --seed N            (default 1)\n", argv0);
+}
+
+// Appends one frame to the stream and applies it to the expected zone
+static void addFrame(std::string &stream, std::vector<uint16_t> &zone, bool full) {
+    int x = 0, y = 0, width = WIDTH, height = ANIMATION_ZONE_HEIGHT;
+    if (!full) {
+        width = 1 + nextRandom() % WIDTH;
+        height = 1 + nextRandom() % ANIMATION_ZONE_HEIGHT;
+        x = nextRandom() % (WIDTH - width + 1);
+        y = nextRandom() % (ANIMATION_ZONE_HEIGHT - height + 1);
+    }
+
+    const char header[FRAME_HEADER_SIZE] = {'F', 'R', (char)x, (char)y, (char)width, (char)height};
+    stream.append(header, sizeof(header));
+    uint16_t base = nextRandom();
+    for (int row = 0; row < height; row++) {
+        for (int column = 0; column < width; column++) {
+            uint16_t pixel = base + row * 131 + column * 7;
+            zone[(y + row) * WIDTH + x + column] = pixel;
+            stream.append((const char *)&pixel, sizeof(pixel));
+        }
+    }
+}
+
+static bool zoneMatches(const std::vector<uint16_t> &expected) {
+    return memcmp(matrix.getBuffer() + ANIMATION_ZONE_Y * WIDTH, expected.data(), ZONE_PIXELS * sizeof(uint16_t)) == 0;
+}
+
+int main(int argc, char **argv) {
+    int frameCount = 3000;
+    int deltaPercent = 50;
+    int maxSegment = 1460;
+    int displayEvery = 3;
+
+    for (int i = 1; i < argc; i++) {
+        String arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) frameCount = max(1, atoi(argv[++i]));
+        else if (arg == "--delta" && hasValue) deltaPercent = min(100, max(0, atoi(argv[++i])));
+        else if (arg == "--segment" && hasValue) maxSegment = max(1, atoi(argv[++i]));
+        else if (arg == "--display-every" && hasValue) displayEvery = max(1, atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) rngState = max(1, atoi(argv[++i]));
+        else {
+            usage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    hostSetSerialEnabled(false);
+    initializeMatrix();
+    initializeWidgets();
+    setWidget(WIDGET_NONE);
+
+    // The zone after each frame, to check what the panel shows against
+    std::string stream;
+    std::vector<std::vector<uint16_t>> expected;
+    std::vector<uint16_t> zone(ZONE_PIXELS, 0);
+    for (int i = 0; i < frameCount; i++) {
+        addFrame(stream, zone, i == 0 || (int)(nextRandom() % 100) >= deltaPercent);
+        expected.push_back(zone);
+    }
+
+    FeedClient client(stream, maxSegment);
+    beginFrameStream();
+
+    std::chrono::nanoseconds receiveTime(0);
+    std::chrono::nanoseconds displayTime(0);
+    size_t nextFrame = 0;       // First frame the panel may still show
+    int polls = 0;
+    int shown = 0;
+    int failures = 0;
+
+    while (!client.finished() || polls % displayEvery != 0) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!receiveFrameStream(client)) {
+            printf("Stream rejected at poll %d\n", polls);
+            return 1;
+        }
+        receiveTime += std::chrono::steady_clock::now() - start;
+        polls++;
+        if (polls % displayEvery != 0) continue;
+
+        hostAdvanceMillis(16);
+        start = std::chrono::steady_clock::now();
+        bool frameShown = updateMatrixDisplay();
+        displayTime += std::chrono::steady_clock::now() - start;
+        if (!frameShown) continue;
+        shown++;
+
+        // Frames may be skipped, but never shown out of order or half applied
+        size_t match = nextFrame;
+        while (match < expected.size() && !zoneMatches(expected[match])) match++;
+        if (match == expected.size()) {
+            printf("Shown frame %d matches no frame sent after frame %zu\n", shown, nextFrame);
+            failures++;
+        } else {
+            nextFrame = match + 1;
+        }
+    }
+
+    if (currentAnimation != ANIMATION_STREAM || !zoneMatches(expected.back())) {
+        printf("The panel doesn't end on the last frame sent\n");
+        failures++;
+    }
+
+    double receiveSeconds = receiveTime.count() / 1e9;
+    printf("%d frames (%d%% rectangles), %zu bytes in %d polls, segments up to %d bytes\n",
+           frameCount, deltaPercent, stream.size(), polls, maxSegment);
+    printf("receive: %.1f MB/s, %.0f frames/s, %.2f us per frame\n",
+           stream.size() / receiveSeconds / 1e6, frameCount / receiveSeconds, receiveSeconds * 1e6 / frameCount);
+    printf("display: %d frames shown, %d dropped, %.2f us per shown frame\n",
+           shown, frameCount - shown, shown ? displayTime.count() / 1e3 / shown : 0.0);
+    printf("%d failures\n", failures);
+    return failures > 0 ? 1 : 0;
+}
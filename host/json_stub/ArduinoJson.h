@@ -0,0 +1,81 @@
+#ifndef ARDUINOJSON_H
+#define ARDUINOJSON_H
+
+// Host stand-in for ArduinoJson 7, used when CMake can't find the real library
+// (see ARDUINOJSON_DIR). It has the same surface as the calls the sketch makes
+// but does not parse: every document deserializes as empty. Documents take an
+// allocator and filters are accepted, but neither is used.
+
+#include <Arduino.h>
+
+class JsonVariant;
+
+namespace ArduinoJson {
+class Allocator {
+public:
+    virtual void *allocate(size_t size) = 0;
+    virtual void deallocate(void *ptr) = 0;
+    virtual void *reallocate(void *ptr, size_t newSize) = 0;
+
+protected:
+    ~Allocator() {}
+};
+}
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+    DeserializationError(Code c = Ok) : code_(c) {}
+    explicit operator bool() const { return code_ != Ok; }
+    Code code() const { return code_; }
+    const char *c_str() const {
+        static const char *names[] = {"Ok", "EmptyInput", "IncompleteInput", "InvalidInput", "NoMemory", "TooDeep"};
+        return names[code_];
+    }
+
+private:
+    Code code_;
+};
+
+class JsonVariant {
+public:
+    JsonVariant operator[](const char *key) const { (void)key; return JsonVariant(); }
+    JsonVariant operator[](int index) const { (void)index; return JsonVariant(); }
+    bool isNull() const { return true; }
+    explicit operator bool() const { return false; }
+    size_t size() const { return 0; }
+    template <typename T> T as() const { return T(); }
+    template <typename T> bool is() const { return false; }
+    JsonVariant &operator=(bool) { return *this; }
+};
+
+typedef JsonVariant JsonObject;
+typedef JsonVariant JsonArray;
+
+class JsonDocument : public JsonVariant {
+public:
+    JsonDocument() {}
+    explicit JsonDocument(ArduinoJson::Allocator *allocator) { (void)allocator; }
+    void clear() {}
+};
+
+namespace DeserializationOption {
+class Filter {
+public:
+    explicit Filter(const JsonDocument &filter) { (void)filter; }
+};
+}
+
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &doc, const TInput &input) {
+    (void)doc; (void)input;
+    return DeserializationError::EmptyInput;
+}
+
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &doc, const TInput &input, DeserializationOption::Filter filter) {
+    (void)doc; (void)input; (void)filter;
+    return DeserializationError::EmptyInput;
+}
+
+#endif
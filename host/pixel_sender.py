@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Send DDP or E1.31 frames to the pixel receiver (see pixel_receiver.h).
+
+Stands in for xLights or another lighting controller. Point it at the device,
+or at the host build running
+
+    ./build/matrixportal_host --animation pixels --realtime --frames 600 --out frames
+
+and run, for example
+
+    python host/pixel_sender.py 127.0.0.1 --protocol ddp --fps 40
+    python host/pixel_sender.py 127.0.0.1 --protocol e131 --sync 64000 --stale 10
+
+--stale N resends an old packet of the frame after every Nth frame, with its
+old sequence number, so the receiver's stale-packet count in /metrics (or
+--metrics on the host) should grow by one each time and the image shouldn't
+change. --pattern bars sends one fixed frame, to compare the output with.
+"""
+
+import argparse
+import math
+import socket
+import struct
+import time
+import uuid
+
+WIDTH, HEIGHT = 64, 32
+DDP_PORT = 4048
+E131_PORT = 5568
+DDP_CHUNK = 1440            # Bytes of pixel data per DDP packet, as xLights sends
+E131_PIXELS = 170           # Pixels per universe
+FIRST_UNIVERSE = 1
+CID = uuid.uuid4().bytes
+
+
+def rainbow(t):
+    data = bytearray()
+    for y in range(HEIGHT):
+        for x in range(WIDTH):
+            h = (x / WIDTH + y / (2 * HEIGHT) + t / 4) % 1.0
+            data += bytes(int(127 + 127 * math.sin(2 * math.pi * (h + k / 3))) for k in range(3))
+    return bytes(data)
+
+
+def bars(_t):
+    """Eight vertical color bars, the same every frame."""
+    colors = [(255, 255, 255), (255, 255, 0), (0, 255, 255), (0, 255, 0),
+              (255, 0, 255), (255, 0, 0), (0, 0, 255), (0, 0, 0)]
+    return bytes(c for _ in range(HEIGHT) for x in range(WIDTH) for c in colors[x * 8 // WIDTH])
+
+
+class Ddp:
+    def __init__(self):
+        self.sequence = 0
+
+    def packets(self, pixels, _args):
+        for offset in range(0, len(pixels), DDP_CHUNK):
+            chunk = pixels[offset:offset + DDP_CHUNK]
+            self.sequence = self.sequence % 15 + 1
+            push = 0x01 if offset + DDP_CHUNK >= len(pixels) else 0
+            yield struct.pack(">BBBBIH", 0x40 | push, self.sequence, 0x0B, 1, offset, len(chunk)) + chunk
+
+
+class E131:
+    def __init__(self):
+        self.sequence = {}
+        self.sync_sequence = 0
+
+    def data(self, universe, slots, sync):
+        sequence = self.sequence[universe] = (self.sequence.get(universe, -1) + 1) & 0xFF
+        count = len(slots) + 1
+        root = struct.pack(">HH12sHI16s", 0x0010, 0, b"ASC-E1.17\0\0\0", 0x7000 | (109 + count), 4, CID)
+        framing = struct.pack(">HI64sBHBBH", 0x7000 | (87 + count), 2, b"pixel_sender", 100, sync, sequence, 0, universe)
+        dmp = struct.pack(">HBBHHH", 0x7000 | (10 + count), 0x02, 0xA1, 0, 1, count)
+        return root + framing + dmp + b"\0" + slots
+
+    def sync(self, address):
+        self.sync_sequence = (self.sync_sequence + 1) & 0xFF
+        root = struct.pack(">HH12sHI16s", 0x0010, 0, b"ASC-E1.17\0\0\0", 0x7000 | 33, 8, CID)
+        return root + struct.pack(">HIBHH", 0x7000 | 11, 1, self.sync_sequence, address, 0)
+
+    def packets(self, pixels, args):
+        for index, offset in enumerate(range(0, len(pixels), E131_PIXELS * 3)):
+            yield self.data(FIRST_UNIVERSE + index, pixels[offset:offset + E131_PIXELS * 3], args.sync)
+        if args.sync:
+            yield self.sync(args.sync)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host", help="device IP address, or 127.0.0.1 for the host build")
+    parser.add_argument("--protocol", choices=("ddp", "e131"), default="ddp")
+    parser.add_argument("--port", type=int, help="default 4048 for DDP, 5568 for E1.31")
+    parser.add_argument("--fps", type=float, default=40)
+    parser.add_argument("--seconds", type=float, default=10)
+    parser.add_argument("--sync", type=int, default=0, help="E1.31 sync universe (0: no sync packets)")
+    parser.add_argument("--stale", type=int, default=0, help="resend an old packet after every Nth frame")
+    parser.add_argument("--pattern", choices=("rainbow", "bars"), default="rainbow")
+    args = parser.parse_args()
+
+    port = args.port or (DDP_PORT if args.protocol == "ddp" else E131_PORT)
+    sender = Ddp() if args.protocol == "ddp" else E131()
+    pattern = rainbow if args.pattern == "rainbow" else bars
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    start = next_frame = time.monotonic()
+    frames = packets = stale = 0
+    while time.monotonic() - start < args.seconds:
+        sent = list(sender.packets(pattern(time.monotonic() - start), args))
+        for packet in sent:
+            sock.sendto(packet, (args.host, port))
+        frames += 1
+        packets += len(sent)
+        if args.stale and frames % args.stale == 0:
+            sock.sendto(sent[0], (args.host, port))
+            stale += 1
+
+        next_frame += 1 / args.fps
+        time.sleep(max(0, next_frame - time.monotonic()))
+
+    elapsed = time.monotonic() - start
+    print(f"sent {frames} frames in {packets} {args.protocol} packets over {elapsed:.1f} s "
+          f"({frames / elapsed:.1f} fps), {stale} stale")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,373 @@
+#include "http_pool.h"
+
+#define HTTP_HEAD_TIMEOUT_MS 8000   // Request sent -> end of the response head (server think time)
+#define HTTP_BODY_TIMEOUT_MS 5000   // End of the head -> end of the body
+
+// Whole bodies are collected before the handler parses them. Sized for each
+// API's response with room to spare; a larger one fails as "body too large".
+static char weatherApiBody[2048];     // current.json is about 1.5 KB
+static char spotifyApiBody[8192];     // currently-playing, without the market lists
+static char msGraphBody[1024];        // presence is a few hundred bytes
+static char spotifyAccountsBody[1536];  // access and refresh token, a few hundred bytes each
+static char msLoginBody[6144];        // access token JWT and refresh token, 1.5-2.5 KB each
+
+PooledConnection weatherApiConnection("api.weatherapi.com", 80, PROFILE_FETCH_WEATHER, weatherApiHealth,
+                                      weatherApiBody, sizeof(weatherApiBody));
+PooledConnection spotifyApiConnection("api.spotify.com", 443, PROFILE_FETCH_SPOTIFY, spotifyApiHealth,
+                                      spotifyApiBody, sizeof(spotifyApiBody));
+PooledConnection msGraphConnection("graph.microsoft.com", 443, PROFILE_FETCH_TEAMS, msGraphHealth,
+                                   msGraphBody, sizeof(msGraphBody));
+PooledConnection spotifyAccountsConnection("accounts.spotify.com", 443, PROFILE_FETCH_AUTH, spotifyAccountsHealth,
+                                           spotifyAccountsBody, sizeof(spotifyAccountsBody));
+PooledConnection msLoginConnection("login.microsoftonline.com", 443, PROFILE_FETCH_AUTH, msLoginHealth,
+                                   msLoginBody, sizeof(msLoginBody));
+
+static PooledConnection *connections[] = {
+  &weatherApiConnection,
+  &spotifyApiConnection,
+  &msGraphConnection,
+  &spotifyAccountsConnection,
+  &msLoginConnection,
+};
+
+// Case-insensitive search of a header value
+static bool headerHas(const char *value, const char *word) {
+  size_t wordLength = strlen(word);
+  for (; *value; value++) {
+    if (strncasecmp(value, word, wordLength) == 0) return true;
+  }
+  return false;
+}
+
+PooledConnection::PooledConnection(const char *host, uint16_t port, ProfileStage stage, UpstreamHealth &health,
+                                   char *bodyBuffer, size_t bodyCapacity)
+    : host(host), port(port), stage(stage), health(health),
+      client(port == 443 ? static_cast<WiFiClient &>(sslClient) : plainClient),
+      bodyStream(bodyBuffer, bodyCapacity) {}
+
+bool PooledConnection::begin(const String &path, const String &authorization, HttpResponseHandler handler) {
+  if (busy() || !health.allowRequest()) return false;
+
+  this->path = path;
+  this->authorization = authorization;
+  this->handler = handler;
+  form = "";
+  posting = false;
+  retried = false;
+  requestStart = millis();
+  profileStart = profileNow();
+  state = HTTP_CONNECT;
+  return true;
+}
+
+bool PooledConnection::post(const String &path, const String &authorization, const String &form,
+                            HttpResponseHandler handler) {
+  if (!begin(path, authorization, handler)) return false;
+  this->form = form;
+  posting = true;
+  return true;
+}
+
+void PooledConnection::poll() {
+  switch (state) {
+    case HTTP_IDLE:
+      return;
+
+    case HTTP_CONNECT:
+      reused = client.connected();
+      if (reused && (posting || client.available())) {
+        close();                  // Stray bytes put the stream out of step; a POST never reuses
+        reused = false;
+      }
+      if (reused) {
+        reuses++;
+      } else {
+        if (!client.connect(host, port)) {
+          fail("connection failed");
+          return;
+        }
+        connects++;
+      }
+      state = HTTP_SEND;
+      return;
+
+    case HTTP_SEND:
+      client.print(posting ? "POST " : "GET ");
+      client.print(path);
+      client.print(" HTTP/1.1\r\nHost: ");
+      client.print(host);
+      if (authorization.length() > 0) {
+        client.print("\r\nAuthorization: ");
+        client.print(authorization);
+      }
+      if (posting) {
+        client.print("\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: ");
+        client.print(form.length());
+        client.print("\r\nConnection: close\r\n\r\n");
+        client.print(form);
+      } else {
+        client.print("\r\nConnection: keep-alive\r\n\r\n");
+      }
+
+      statusCode = 0;
+      keepAlive = false;
+      contentLength = -1;
+      chunked = false;
+      retryAfterMs = 0;
+      lineLength = 0;
+      headStarted = false;
+      phaseStart = millis();
+      sentAt = phaseStart;
+      state = HTTP_AWAIT_HEAD;
+      return;
+
+    case HTTP_AWAIT_HEAD:
+      if (readHead()) {
+        if (statusCode <= 0) {
+          fail("malformed response");
+        } else {
+          phaseStart = millis();
+          headAt = phaseStart;
+          state = HTTP_AWAIT_BODY;
+        }
+      } else if (!client.connected() && !client.available()) {
+        // A reused socket the server closed while idle only shows up now
+        if (reused && !retried && !headStarted) {
+          Serial.print(host);
+          Serial.println(": kept-alive connection was closed, reconnecting");
+          close();
+          retried = true;
+          state = HTTP_CONNECT;
+        } else {
+          fail("connection closed");
+        }
+      } else if (millis() - phaseStart > HTTP_HEAD_TIMEOUT_MS) {
+        fail("response timeout");
+      }
+      return;
+
+    case HTTP_AWAIT_BODY:
+      // Collected across ticks; the handler only runs on a complete body
+      if (readBody()) {
+        complete();
+      } else if (bodyError) {
+        fail(bodyError, !bodyOverflow);
+      } else if (!client.connected() && !client.available()) {
+        fail("connection closed");
+      } else if (millis() - phaseStart > HTTP_BODY_TIMEOUT_MS) {
+        fail("body timeout");
+      }
+      return;
+  }
+}
+
+// Consumes whatever part of the response head has arrived; true at its end
+bool PooledConnection::readHead() {
+  while (client.available()) {
+    int c = client.read();
+    if (c < 0) break;
+    headStarted = true;
+
+    if (c == '\n') {
+      if (lineLength == 0) {
+        // Blank line: the head is complete, set up the body framing
+        bodyStream.length = 0;
+        bodyStream.position = 0;
+        bodyRemaining = 0;
+        untilClose = false;
+        bodyError = nullptr;
+        bodyOverflow = false;
+
+        if (statusCode < 200 || statusCode == 204 || statusCode == 304) {
+          bodyState = BODY_DONE;      // These never carry a body
+        } else if (chunked) {
+          bodyState = BODY_CHUNK_SIZE;
+        } else if (contentLength >= 0) {
+          bodyRemaining = contentLength;
+          bodyState = contentLength == 0 ? BODY_DONE : BODY_DATA;
+        } else {
+          untilClose = true;
+          keepAlive = false;
+          bodyState = BODY_DATA;
+        }
+        return true;
+      }
+      line[lineLength] = '\0';
+      headLine();
+      lineLength = 0;
+    } else if (c != '\r' && lineLength < sizeof(line) - 1) {
+      line[lineLength++] = c;
+    }
+  }
+  return false;
+}
+
+// One line of the head; longer lines arrive truncated, which is fine for the
+// few headers that matter
+void PooledConnection::headLine() {
+  if (statusCode == 0) {
+    // Status line: "HTTP/1.1 200 OK"
+    if (lineLength < 12 || strncmp(line, "HTTP/1.", 7) != 0) {
+      statusCode = -1;
+      return;
+    }
+    statusCode = atoi(line + 9);
+    keepAlive = line[7] == '1';   // Persistent by default from HTTP/1.1 on
+  } else if (strncasecmp(line, "Content-Length:", 15) == 0) {
+    contentLength = atol(line + 15);
+  } else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+    chunked = headerHas(line + 18, "chunked");
+  } else if (strncasecmp(line, "Connection:", 11) == 0 && headerHas(line + 11, "close")) {
+    keepAlive = false;
+  } else if (strncasecmp(line, "Retry-After:", 12) == 0) {
+    retryAfterMs = strtoul(line + 12, nullptr, 10) * 1000;  // The HTTP-date form reads as 0
+  }
+}
+
+// Consumes whatever part of the body has arrived into the body buffer; true
+// once all of it is there. Sets bodyError when the body can't be used.
+bool PooledConnection::readBody() {
+  while (bodyState != BODY_DONE) {
+    int ready = client.available();
+    if (ready <= 0) {
+      // A server close is the normal end of an unframed body
+      if (untilClose && !client.connected()) break;
+      return false;
+    }
+
+    if (bodyState == BODY_DATA) {
+      size_t count = untilClose ? ready : min((uint32_t)ready, bodyRemaining);
+      if (count > bodyStream.capacity - bodyStream.length) {
+        bodyError = "body too large";
+        bodyOverflow = true;
+        oversized++;
+        return false;
+      }
+      int got = client.read((uint8_t *)bodyStream.buffer + bodyStream.length, count);
+      if (got <= 0) return false;
+      bodyStream.length += got;
+      if (!untilClose) {
+        bodyRemaining -= got;
+        if (bodyRemaining == 0) bodyState = chunked ? BODY_CHUNK_END : BODY_DONE;
+      }
+      continue;
+    }
+
+    // Chunk framing, a line at a time
+    int c = client.read();
+    if (c < 0) return false;
+    if (c == '\n') {
+      line[lineLength] = '\0';
+      if (!bodyLine()) {
+        bodyError = "malformed chunk";
+        return false;
+      }
+      lineLength = 0;
+    } else if (c != '\r' && lineLength < sizeof(line) - 1) {
+      line[lineLength++] = c;
+    }
+  }
+  bodyState = BODY_DONE;
+  return true;
+}
+
+// One line of chunk framing; false if it isn't what the framing expects
+bool PooledConnection::bodyLine() {
+  switch (bodyState) {
+    case BODY_CHUNK_END:
+      bodyState = BODY_CHUNK_SIZE;
+      return lineLength == 0;
+
+    case BODY_CHUNK_SIZE:
+      if (lineLength == 0) return false;
+      bodyRemaining = strtoul(line, nullptr, 16);     // Ignores chunk extensions
+      bodyState = bodyRemaining > 0 ? BODY_DATA : BODY_TRAILERS;
+      return true;
+
+    case BODY_TRAILERS:
+      if (lineLength == 0) bodyState = BODY_DONE;
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void PooledConnection::complete() {
+  // The whole response is here; the handler may still find it unusable
+  handlerFailed = false;
+  handler(*this);
+
+  // The host is up, but a rejected request would only be rejected again at
+  // full rate, so it backs off like an outage
+  if (statusCode == 429 || statusCode >= 500) {
+    health.recordFailure(statusCode, retryAfterMs);
+  } else if (statusCode >= 400 || handlerFailed) {
+    health.recordFailure(statusCode);
+  } else {
+    health.recordSuccess(statusCode);
+  }
+
+  if (!keepAlive || posting) close();
+  airtimeMs += millis() - requestStart;
+  profileRecord(stage, profileNow() - profileStart);
+  state = HTTP_IDLE;
+}
+
+// upstreamFault is false for our own limits, which say nothing about the host
+void PooledConnection::fail(const char *reason, bool upstreamFault) {
+  Serial.print(host);
+  Serial.print(": ");
+  Serial.println(reason);
+
+  close();
+  statusCode = 0;
+  bodyStream.length = 0;
+  bodyStream.position = 0;
+  if (upstreamFault) health.recordFailure(0);
+  handler(*this);
+  airtimeMs += millis() - requestStart;
+  profileRecord(stage, profileNow() - profileStart);
+  state = HTTP_IDLE;
+}
+
+void PooledConnection::close() {
+  client.stop();
+  bodyState = BODY_DONE;
+  keepAlive = false;
+}
+
+void pollHttpConnections() {
+  for (PooledConnection *connection : connections) {
+    connection->poll();
+  }
+}
+
+bool httpRequestsInFlight() {
+  for (PooledConnection *connection : connections) {
+    if (connection->busy()) return true;
+  }
+  return false;
+}
+
+uint32_t httpAirtimeMs() {
+  uint32_t total = 0;
+  for (PooledConnection *connection : connections) {
+    total += connection->airtime();
+  }
+  return total;
+}
+
+void printConnectionPoolMetrics(Print &out) {
+  out.println("# pool host connects reuses oversized");
+  for (PooledConnection *connection : connections) {
+    out.print("pool ");
+    out.print(connection->hostName());
+    out.print(' ');
+    out.print((unsigned long)connection->connectCount());
+    out.print(' ');
+    out.print((unsigned long)connection->reuseCount());
+    out.print(' ');
+    out.println((unsigned long)connection->oversizedCount());
+  }
+}
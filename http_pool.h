@@ -0,0 +1,185 @@
+#ifndef HTTP_POOL_H
+#define HTTP_POOL_H
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include "profiler.h"
+#include "upstream_health.h"
+
+// Keep-alive HTTP(S) connections for the APIs the widgets poll. A TLS
+// handshake on the NINA co-processor costs far more than the request itself,
+// so each host keeps one socket open and reuses it with HTTP/1.1 keep-alive.
+// Responses are framed by Content-Length or chunked encoding; when the server
+// has closed an idle socket the request is retried once on a fresh connection.
+// Form POSTs (the OAuth token grants) are never retried: each goes out once on
+// a fresh socket, which is closed again with the response.
+//
+// Requests are cooperative: begin() only queues one, and pollHttpConnections()
+// moves every connection through connect -> send -> await head -> await body
+// as far as it can without waiting, so several requests can be in flight
+// across network task ticks. Each phase has its own deadline. The body is
+// collected into the connection's fixed buffer as it arrives, and the handler
+// only runs once all of it is there, so parsing never waits on the network.
+// The one step that still blocks is connect(), which WiFiNINA runs to
+// completion.
+//
+// Every outcome is reported to the host's UpstreamHealth: a failed connect or
+// timeout, 429 and 5xx count against it (honoring Retry-After), and so do other
+// 4xx and responses the handler marks as unusable, since sending the same
+// request again would get the same answer. begin() refuses requests while the
+// host is backing off. A body too large for the connection's buffer is our
+// limit, not the host's fault: it fails the request but is only counted in the
+// pool metrics.
+
+class PooledConnection;
+
+// Called once per request: with the whole response received, or with
+// status() == 0 when the request failed, timed out or the body didn't fit.
+typedef void (*HttpResponseHandler)(PooledConnection &connection);
+
+// Body of the current response with the framing removed, read back from the
+// connection's buffer. Never waits; read() returns -1 at the end.
+class HttpBodyStream : public Stream {
+public:
+  HttpBodyStream(char *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+  int available() override { return length - position; }
+  int read() override { return position < length ? (uint8_t)buffer[position++] : -1; }
+  int peek() override { return position < length ? (uint8_t)buffer[position] : -1; }
+  size_t write(uint8_t c) override { (void)c; return 0; }
+  using Print::write;
+
+  size_t size() const { return length; }
+
+private:
+  friend class PooledConnection;
+
+  char *buffer;
+  size_t capacity;
+  size_t length = 0;
+  size_t position = 0;
+};
+
+// Where the body framing is, as bytes arrive
+enum HttpBodyState {
+  BODY_DATA,                    // Body or chunk data, bodyRemaining bytes of it
+  BODY_CHUNK_SIZE,              // Chunk-size line
+  BODY_CHUNK_END,               // CRLF after a chunk's data
+  BODY_TRAILERS,                // Trailer lines up to the blank one
+  BODY_DONE
+};
+
+enum HttpState {
+  HTTP_IDLE,
+  HTTP_CONNECT,
+  HTTP_SEND,
+  HTTP_AWAIT_HEAD,
+  HTTP_AWAIT_BODY
+};
+
+class PooledConnection {
+public:
+  // bodyBuffer holds the largest response body this host is expected to send
+  PooledConnection(const char *host, uint16_t port, ProfileStage stage, UpstreamHealth &health,
+                   char *bodyBuffer, size_t bodyCapacity);
+
+  // Queue a GET. authorization is the full header value (e.g. "Bearer ...")
+  // or empty. Returns false if this connection already has a request in
+  // flight or the host is backing off. A request may be sent twice when a reused socket turns out to be
+  // closed, so only send idempotent ones.
+  bool begin(const String &path, const String &authorization, HttpResponseHandler handler);
+
+  // Queue a POST of an application/x-www-form-urlencoded body. Sent once on a
+  // fresh connection and not retried, since it need not be idempotent.
+  bool post(const String &path, const String &authorization, const String &form, HttpResponseHandler handler);
+
+  // Advance the request without waiting; runs the handler when it completes
+  void poll();
+  bool busy() const { return state != HTTP_IDLE; }
+
+  int status() const { return statusCode; }
+
+  // From the handler: the response arrived but can't be used (an error in the
+  // body, a rejected grant), so it counts against the host like a 4xx
+  void markFailed() { handlerFailed = true; }
+
+  // millis() halfway between sending the request and the end of the response
+  // head: the best local estimate of when the server produced the response
+  uint32_t responseTime() const { return sentAt + (headAt - sentAt) / 2; }
+  HttpBodyStream &body() { return bodyStream; }
+
+  const char *hostName() const { return host; }
+  uint32_t connectCount() const { return connects; }
+  uint32_t reuseCount() const { return reuses; }
+  uint32_t oversizedCount() const { return oversized; }   // Bodies that didn't fit the buffer
+  uint32_t airtime() const { return airtimeMs; }   // Total ms spent with a request in flight
+
+private:
+  bool readHead();
+  void headLine();
+  bool readBody();
+  bool bodyLine();
+  void complete();
+  void fail(const char *reason, bool upstreamFault = true);
+  void close();
+
+  const char *host;
+  uint16_t port;
+  ProfileStage stage;
+  UpstreamHealth &health;
+  WiFiSSLClient sslClient;
+  WiFiClient plainClient;
+  WiFiClient &client;
+
+  HttpState state = HTTP_IDLE;
+  String path;
+  String authorization;
+  String form;
+  bool posting = false;         // A POST of form: fresh socket, no retry, closed after
+  HttpResponseHandler handler = nullptr;
+  uint32_t phaseStart = 0;
+  uint32_t requestStart = 0;
+  uint32_t profileStart = 0;
+  uint32_t sentAt = 0;
+  uint32_t headAt = 0;
+  bool reused = false;
+  bool retried = false;
+
+  // Response head, parsed a line at a time as bytes arrive
+  char line[96];
+  size_t lineLength = 0;
+  bool headStarted = false;
+  long contentLength = -1;
+  bool chunked = false;
+  uint32_t retryAfterMs = 0;
+
+  HttpBodyStream bodyStream;
+  HttpBodyState bodyState = BODY_DONE;
+  uint32_t bodyRemaining = 0;
+  bool untilClose = false;      // No length given: body ends when the server closes
+  const char *bodyError = nullptr;
+  bool bodyOverflow = false;    // bodyError is our buffer's limit, not a bad response
+  bool handlerFailed = false;
+  int statusCode = 0;
+  bool keepAlive = false;
+  uint32_t connects = 0;
+  uint32_t reuses = 0;
+  uint32_t oversized = 0;
+  uint32_t airtimeMs = 0;
+};
+
+extern PooledConnection weatherApiConnection;
+extern PooledConnection spotifyApiConnection;
+extern PooledConnection msGraphConnection;
+extern PooledConnection spotifyAccountsConnection;
+extern PooledConnection msLoginConnection;
+
+// Give every connection with a request in flight a turn; call from the network task
+void pollHttpConnections();
+bool httpRequestsInFlight();
+uint32_t httpAirtimeMs();      // Sum of airtime() over all connections
+
+// One line per pooled host: handshakes made and requests that reused a socket
+void printConnectionPoolMetrics(Print &out);
+
+#endif
@@ -0,0 +1,287 @@
+#include "http_request.h"
+
+// Headers the server reads; any other header line is dropped on arrival
+static const char *const keptHeaders[] = {
+  "host",
+  "content-length",
+  "content-type",
+  "transfer-encoding",
+  "connection",
+  "accept-encoding",
+  "if-none-match",
+};
+
+static bool spanEqualsIgnoreCase(const char *data, size_t length, const char *text) {
+  size_t textLength = strlen(text);
+  if (length != textLength) return false;
+  for (size_t i = 0; i < length; i++) {
+    if (tolower((unsigned char)data[i]) != tolower((unsigned char)text[i])) return false;
+  }
+  return true;
+}
+
+// RFC 7230 tchar: what a method or header name may contain
+static bool isTokenChar(char c) {
+  return isalnum((unsigned char)c) || (c && strchr("!#$%&'*+-.^_`|~", c));
+}
+
+static bool isKeptHeader(const char *name, size_t length) {
+  for (const char *kept : keptHeaders) {
+    if (spanEqualsIgnoreCase(name, length, kept)) return true;
+  }
+  return false;
+}
+
+bool HttpSpan::equals(const char *text) const {
+  return strlen(text) == length && (length == 0 || memcmp(data, text, length) == 0);
+}
+
+bool HttpSpan::equalsIgnoreCase(const char *text) const {
+  return spanEqualsIgnoreCase(data, length, text);
+}
+
+String HttpSpan::toString() const {
+  String text;
+  text.reserve(length);
+  for (uint16_t i = 0; i < length; i++) text += data[i];
+  return text;
+}
+
+HttpSpan HttpRequest::header(const char *name) const {
+  for (uint8_t i = 0; i < headerCount; i++) {
+    if (headers[i].name.equalsIgnoreCase(name)) return headers[i].value;
+  }
+  HttpSpan none = {nullptr, 0};
+  return none;
+}
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+int httpQueryParam(const HttpSpan &query, const char *name, char *buffer, size_t size) {
+  size_t nameLength = strlen(name);
+  const char *position = query.data;
+  const char *end = query.data + query.length;
+
+  while (position < end) {
+    const char *pairEnd = (const char *)memchr(position, '&', end - position);
+    if (!pairEnd) pairEnd = end;
+
+    const char *equals = (const char *)memchr(position, '=', pairEnd - position);
+    const char *keyEnd = equals ? equals : pairEnd;
+    if ((size_t)(keyEnd - position) != nameLength || memcmp(position, name, nameLength) != 0) {
+      if (pairEnd == end) break;
+      position = pairEnd + 1;
+      continue;
+    }
+
+    // A malformed escape is kept as it is, like browsers do
+    size_t length = 0;
+    for (const char *c = equals ? equals + 1 : pairEnd; c < pairEnd; c++) {
+      if (length + 1 >= size) return -1;
+      if (*c == '+') {
+        buffer[length++] = ' ';
+      } else if (*c == '%' && pairEnd - c > 2 && hexDigit(c[1]) >= 0 && hexDigit(c[2]) >= 0) {
+        buffer[length++] = (char)(hexDigit(c[1]) << 4 | hexDigit(c[2]));
+        c += 2;
+      } else {
+        buffer[length++] = *c;
+      }
+    }
+    if (size == 0) return -1;
+    buffer[length] = '\0';
+    return length;
+  }
+  return -1;
+}
+
+bool httpQueryInt(const HttpSpan &query, const char *name, long &value) {
+  char digits[16];
+  if (httpQueryParam(query, name, digits, sizeof(digits)) <= 0) return false;
+
+  char *end;
+  value = strtol(digits, &end, 10);
+  return *end == '\0';
+}
+
+void HttpRequestParser::reset() {
+  used = 0;
+  lineStart = 0;
+  scanned = 0;
+  bodyStart = 0;
+  contentLength = 0;
+  hasContentLength = false;
+  state = REQUEST_LINE;
+  status = 0;
+  parsed = HttpRequest();
+}
+
+HttpParseResult HttpRequestParser::advance(size_t count) {
+  if (state == DONE || state == FAILED) return result();
+  used += min(count, room());
+  return parse();
+}
+
+HttpParseResult HttpRequestParser::feed(const char *data, size_t length) {
+  while (length > 0 && result() == HTTP_PARSE_INCOMPLETE && room() > 0) {
+    size_t count = min(length, room());
+    memcpy(writePointer(), data, count);
+    data += count;
+    length -= count;
+    advance(count);
+  }
+  return result();
+}
+
+HttpParseResult HttpRequestParser::fail(uint16_t errorStatus) {
+  state = FAILED;
+  status = errorStatus;
+  return HTTP_PARSE_ERROR;
+}
+
+bool HttpRequestParser::reject(uint16_t errorStatus) {
+  fail(errorStatus);
+  return false;
+}
+
+// Removes the current line, up to next, from the buffer
+void HttpRequestParser::dropLine(size_t next) {
+  memmove(buffer + lineStart, buffer + next, used - next);
+  used -= next - lineStart;
+  scanned = lineStart;
+}
+
+HttpParseResult HttpRequestParser::parse() {
+  while (state != DONE && state != FAILED) {
+    if (state == BODY) {
+      if (used - bodyStart < contentLength) return HTTP_PARSE_INCOMPLETE;
+      parsed.body.data = buffer + bodyStart;
+      parsed.body.length = contentLength;
+      state = DONE;
+      break;
+    }
+
+    const char *newline = (const char *)memchr(buffer + scanned, '\n', used - scanned);
+    if (!newline) {
+      scanned = used;
+      if (state == SKIP_HEADER) {
+        used = scanned = lineStart;
+        return HTTP_PARSE_INCOMPLETE;
+      }
+      if (used < sizeof(buffer)) return HTTP_PARSE_INCOMPLETE;
+
+      // The buffer is full and the line still hasn't ended
+      if (state == REQUEST_LINE) return fail(414);
+      const char *colon = (const char *)memchr(buffer + lineStart, ':', used - lineStart);
+      if (!colon || isKeptHeader(buffer + lineStart, colon - (buffer + lineStart))) return fail(431);
+      state = SKIP_HEADER;
+      used = scanned = lineStart;
+      return HTTP_PARSE_INCOMPLETE;
+    }
+
+    size_t next = newline - buffer + 1;
+    size_t end = next - 1;
+    if (end > lineStart && buffer[end - 1] == '\r') end--;
+
+    if (state == SKIP_HEADER) {
+      dropLine(next);
+      state = HEADERS;
+    } else if (state == REQUEST_LINE) {
+      if (end == lineStart) {
+        dropLine(next);       // A stray CRLF ahead of the request line is allowed
+      } else if (parseRequestLine(end)) {
+        lineStart = scanned = next;
+        state = HEADERS;
+      }
+    } else if (end > lineStart) {
+      parseHeader(end, next);
+    } else {
+      // Blank line: end of the headers
+      lineStart = scanned = next;
+      if (contentLength > sizeof(buffer) - next) return fail(413);
+      bodyStart = next;
+      state = BODY;
+    }
+  }
+  return result();
+}
+
+// METHOD SP request-target SP HTTP-version, origin-form targets only
+bool HttpRequestParser::parseRequestLine(size_t end) {
+  size_t position = lineStart;
+  while (position < end && isTokenChar(buffer[position])) position++;
+  if (position == lineStart || position == end || buffer[position] != ' ') return reject(400);
+  parsed.method.data = buffer + lineStart;
+  parsed.method.length = position - lineStart;
+
+  size_t target = ++position;
+  if (position == end || buffer[position] != '/') return reject(400);
+  while (position < end && buffer[position] != ' ') {
+    unsigned char c = buffer[position];
+    if (c < 0x21 || c == 0x7F) return reject(400);
+    position++;
+  }
+  if (position == end) return reject(400);
+
+  const char *question = (const char *)memchr(buffer + target, '?', position - target);
+  size_t pathEnd = question ? question - buffer : position;
+  parsed.path.data = buffer + target;
+  parsed.path.length = pathEnd - target;
+  parsed.query.data = buffer + min(pathEnd + 1, position);
+  parsed.query.length = question ? position - pathEnd - 1 : 0;
+
+  HttpSpan version = {buffer + position + 1, (uint16_t)(end - position - 1)};
+  if (version.equals("HTTP/1.1") || version.equals("HTTP/1.0")) return true;
+  return reject(version.length > 5 && memcmp(version.data, "HTTP/", 5) == 0 ? 505 : 400);
+}
+
+// name ":" OWS value OWS; keeps the line only if the server reads that header
+bool HttpRequestParser::parseHeader(size_t end, size_t next) {
+  // Folded continuation lines are obsolete and may be rejected
+  if (buffer[lineStart] == ' ' || buffer[lineStart] == '\t') return reject(400);
+
+  size_t colon = lineStart;
+  while (colon < end && isTokenChar(buffer[colon])) colon++;
+  if (colon == lineStart || colon == end || buffer[colon] != ':') return reject(400);
+
+  const char *name = buffer + lineStart;
+  size_t nameLength = colon - lineStart;
+  if (!isKeptHeader(name, nameLength)) {
+    dropLine(next);
+    return true;
+  }
+
+  size_t valueStart = colon + 1;
+  size_t valueEnd = end;
+  while (valueStart < valueEnd && (buffer[valueStart] == ' ' || buffer[valueStart] == '\t')) valueStart++;
+  while (valueEnd > valueStart && (buffer[valueEnd - 1] == ' ' || buffer[valueEnd - 1] == '\t')) valueEnd--;
+
+  if (parsed.headerCount == HTTP_MAX_HEADERS) return reject(431);
+  HttpHeader &header = parsed.headers[parsed.headerCount++];
+  header.name.data = name;
+  header.name.length = nameLength;
+  header.value.data = buffer + valueStart;
+  header.value.length = valueEnd - valueStart;
+
+  if (header.name.equalsIgnoreCase("transfer-encoding")) return reject(501);
+  if (header.name.equalsIgnoreCase("content-length")) {
+    if (header.value.length == 0) return reject(400);
+    uint32_t length = 0;
+    for (uint16_t i = 0; i < header.value.length; i++) {
+      char c = header.value.data[i];
+      if (c < '0' || c > '9') return reject(400);
+      if (length > HTTP_REQUEST_BUFFER) return reject(413);
+      length = length * 10 + (c - '0');
+    }
+    if (hasContentLength && length != contentLength) return reject(400);
+    hasContentLength = true;
+    contentLength = length;
+  }
+
+  lineStart = scanned = next;
+  return true;
+}
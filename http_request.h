@@ -0,0 +1,104 @@
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <Arduino.h>
+
+// Incremental HTTP/1.1 request parser for the control page server. Bytes are
+// read from the socket straight into the parser's fixed buffer and parsed as
+// each line completes, so a request can arrive over any number of calls and
+// nothing waits for the rest of it. The parsed request points into that
+// buffer; nothing is copied or allocated.
+//
+// Only the headers the server acts on are kept. Everything else a browser
+// sends (user agent, cookies, accept lists) is dropped as it arrives, which
+// leaves the buffer to the request line and the body.
+
+#define HTTP_REQUEST_BUFFER 2048
+#define HTTP_MAX_HEADERS 8
+
+// A piece of the request buffer. Not NUL-terminated.
+struct HttpSpan {
+  const char *data;
+  uint16_t length;
+
+  bool equals(const char *text) const;
+  bool equalsIgnoreCase(const char *text) const;
+  String toString() const;
+};
+
+struct HttpHeader {
+  HttpSpan name;
+  HttpSpan value;
+};
+
+struct HttpRequest {
+  HttpSpan method;
+  HttpSpan path;                // Request target up to the '?'
+  HttpSpan query;               // After the '?', empty when there is none
+  HttpSpan body;                // Content-Length bytes, empty without one
+  HttpHeader headers[HTTP_MAX_HEADERS];
+  uint8_t headerCount;
+
+  // Value of a kept header (case-insensitive name), empty when absent
+  HttpSpan header(const char *name) const;
+};
+
+// Query strings and form bodies (name=value&name=value). The value of name is
+// percent-decoded into buffer and NUL-terminated, '+' becoming a space.
+// Returns the decoded length, or -1 if the parameter is missing or doesn't
+// fit. Names are matched as sent, without decoding.
+int httpQueryParam(const HttpSpan &query, const char *name, char *buffer, size_t size);
+
+// Same, for a parameter that must be a whole number
+bool httpQueryInt(const HttpSpan &query, const char *name, long &value);
+
+enum HttpParseResult {
+  HTTP_PARSE_INCOMPLETE,
+  HTTP_PARSE_COMPLETE,
+  HTTP_PARSE_ERROR              // Answer with errorStatus() and close
+};
+
+class HttpRequestParser {
+public:
+  HttpRequestParser() { reset(); }
+
+  void reset();
+
+  // Read up to room() bytes from the socket into writePointer(), then
+  // advance() by the count actually read
+  char *writePointer() { return buffer + used; }
+  size_t room() const { return sizeof(buffer) - used; }
+  HttpParseResult advance(size_t count);
+
+  // Same, for bytes that are already in memory
+  HttpParseResult feed(const char *data, size_t length);
+
+  HttpParseResult result() const { return state == DONE ? HTTP_PARSE_COMPLETE : state == FAILED ? HTTP_PARSE_ERROR : HTTP_PARSE_INCOMPLETE; }
+  const HttpRequest &request() const { return parsed; }
+
+  // 400, 413, 414, 431, 501 or 505 once the request failed
+  uint16_t errorStatus() const { return status; }
+
+private:
+  enum State { REQUEST_LINE, HEADERS, SKIP_HEADER, BODY, DONE, FAILED };
+
+  HttpParseResult parse();
+  bool parseRequestLine(size_t end);
+  bool parseHeader(size_t end, size_t next);
+  void dropLine(size_t next);
+  HttpParseResult fail(uint16_t errorStatus);
+  bool reject(uint16_t errorStatus);
+
+  char buffer[HTTP_REQUEST_BUFFER];
+  size_t used;
+  size_t lineStart;             // Start of the line being received
+  size_t scanned;               // Bytes of that line already searched for '\n'
+  size_t bodyStart;
+  uint32_t contentLength;
+  bool hasContentLength;
+  State state;
+  uint16_t status;
+  HttpRequest parsed;
+};
+
+#endif
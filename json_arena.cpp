@@ -0,0 +1,64 @@
+#include "json_arena.h"
+
+// Each block is preceded by its size so a moved block knows how much to copy
+#define JSON_ARENA_ALIGN 8
+#define JSON_ARENA_HEADER JSON_ARENA_ALIGN
+#define JSON_ARENA_NO_BLOCK ((size_t)-1)
+
+alignas(JSON_ARENA_ALIGN) static uint8_t arenaBuffer[JSON_ARENA_SIZE];
+static size_t highWater = 0;
+
+static size_t alignedSize(size_t size) {
+  return (size + JSON_ARENA_ALIGN - 1) & ~(size_t)(JSON_ARENA_ALIGN - 1);
+}
+
+static size_t &blockSize(size_t offset) {
+  return *reinterpret_cast<size_t *>(arenaBuffer + offset);
+}
+
+// A new arena starts from an empty buffer; everything the previous one handed
+// out is released at once when it goes out of scope
+JsonArena::JsonArena() : used(0), lastBlock(JSON_ARENA_NO_BLOCK) {}
+
+void *JsonArena::allocate(size_t size) {
+  size_t need = JSON_ARENA_HEADER + alignedSize(size);
+  if (need > JSON_ARENA_SIZE - used) return nullptr;
+
+  lastBlock = used;
+  blockSize(lastBlock) = size;
+  used += need;
+  if (used > highWater) highWater = used;
+  return arenaBuffer + lastBlock + JSON_ARENA_HEADER;
+}
+
+void JsonArena::deallocate(void *ptr) {
+  // Only the newest block can be given back; the rest goes with the arena
+  if (ptr && ptr == arenaBuffer + lastBlock + JSON_ARENA_HEADER) {
+    used = lastBlock;
+    lastBlock = JSON_ARENA_NO_BLOCK;
+  }
+}
+
+void *JsonArena::reallocate(void *ptr, size_t newSize) {
+  if (!ptr) return allocate(newSize);
+
+  size_t offset = (uint8_t *)ptr - arenaBuffer - JSON_ARENA_HEADER;
+  if (offset == lastBlock) {
+    // Grow or shrink in place (string building and shrinkToFit hit this)
+    size_t need = JSON_ARENA_HEADER + alignedSize(newSize);
+    if (need > JSON_ARENA_SIZE - lastBlock) return nullptr;
+    blockSize(lastBlock) = newSize;
+    used = lastBlock + need;
+    if (used > highWater) highWater = used;
+    return ptr;
+  }
+
+  size_t oldSize = blockSize(offset);
+  void *moved = allocate(newSize);
+  if (moved) memcpy(moved, ptr, min(oldSize, newSize));
+  return moved;
+}
+
+size_t jsonArenaHighWater() {
+  return highWater;
+}
@@ -0,0 +1,33 @@
+#ifndef JSON_ARENA_H
+#define JSON_ARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+// Fixed-size home for the API response documents. The fetchers deserialize
+// the response body through a filter, so a document only holds the
+// handful of fields a widget shows; giving it a bump allocator over a static
+// buffer keeps every refresh off the heap and caps it at JSON_ARENA_SIZE. A
+// response that would need more fails with DeserializationError::NoMemory.
+
+#define JSON_ARENA_SIZE 8192    // Microsoft's token response keeps two ~2 KB tokens
+
+// All arenas share one buffer, so only one may exist at a time. That holds as
+// long as documents are only parsed on the network task.
+class JsonArena : public ArduinoJson::Allocator {
+public:
+  JsonArena();
+
+  void *allocate(size_t size) override;
+  void deallocate(void *ptr) override;
+  void *reallocate(void *ptr, size_t newSize) override;
+
+private:
+  size_t used;
+  size_t lastBlock;   // Offset of the newest block, which can grow or be freed in place
+};
+
+// Most of the buffer any document has needed since boot
+size_t jsonArenaHighWater();
+
+#endif
@@ -1,6 +1,12 @@
 #include "matrix_display.h"
 #include "widgets.h"
 #include "config.h"
+#include "sprites.h"
+#include "text_strip.h"
+#include "profiler.h"
+#include "frame_stream.h"
+#include "pixel_receiver.h"
+#include "overlay.h"
 
 // Color definitions
 uint16_t colors[] = {
@@ -19,38 +25,173 @@ const char* colorNames[] = {
 };
 
 int truckPosition = WIDTH;
+static bool truckSmokeOn = false;   // Smoke phase, sampled once per frame by tickTruck()
+
+// Frame compositor state. Each bit of a row mask is one panel row (HEIGHT == 32).
+static volatile bool widgetZoneInvalid = true;
+static volatile bool animationZoneInvalid = true;
+static volatile bool displayInvalid = true;
+static uint32_t lastAnimationRows = 0;
+static uint16_t shownFrame[WIDTH * HEIGHT]; // Copy of the last frame handed to show()
+
+static uint32_t rowSpan(int y, int h) {
+  if (h <= 0) return 0;
+  uint32_t rows = (h >= 32) ? 0xFFFFFFFFu : ((1u << h) - 1u);
+  return rows << y;
+}
 
-void updateMatrixDisplay() {
-  static uint32_t lastDebugOutput = 0;
-  static uint32_t lastFrameUpdate = 0;
+static const uint32_t WIDGET_ZONE_ROWS = rowSpan(0, WIDGET_ZONE_HEIGHT);
+static const uint32_t ANIMATION_ZONE_ROWS = rowSpan(ANIMATION_ZONE_Y, ANIMATION_ZONE_HEIGHT);
+static const uint32_t OVERLAY_ROWS = rowSpan(0, OVERLAY_HEIGHT);
+static const int WIDGET_OVERHANG_ROWS = 2; // Bottom-line glyph cells reach this far past the widget zone
+
+void invalidateWidgetZone() {
+  widgetZoneInvalid = true;
+}
+
+void invalidateAnimationZone() {
+  animationZoneInvalid = true;
+}
 
-  // Debug output every 2 seconds
-  if (millis() - lastDebugOutput > 2000) {
-//    Serial.print("Animation: ");
-//    Serial.print(currentAnimation);
-//    Serial.print(", Widgets: ");
-//    Serial.println(currentWidget);
-    lastDebugOutput = millis();
+// Something outside the compositor wrote to the matrix - repaint and re-show everything
+void invalidateDisplay() {
+  displayInvalid = true;
+}
+
+// Rows the current animation paints into. The truck's exhaust reaches up into
+// the widget zone, so those rows have to be repaired when it moves. A lighting
+// controller drives the whole panel.
+uint32_t animationZoneRows() {
+  if (currentAnimation == ANIMATION_PIXELS) {
+    return rowSpan(0, HEIGHT);
+  }
+  uint32_t rows = ANIMATION_ZONE_ROWS;
+  if (currentAnimation == ANIMATION_TRUCK && truckSmokeOn &&
+      truckPosition + 10 >= 0 && truckPosition + 9 < WIDTH) {
+    rows |= rowSpan(ANIMATION_ZONE_Y - 2, 2);
   }
+  return rows;
+}
+
+bool updateMatrixDisplay() {
+  static uint32_t lastFrameUpdate = 0;
 
   // Only update display at a reasonable frame rate (60 FPS max)
   if (millis() - lastFrameUpdate < 16) {
-    return; // Skip this frame
+    return false; // Skip this frame
   }
   lastFrameUpdate = millis();
+  ProfileScope frameScope(PROFILE_FRAME);
+
+  // Collect what changed since the last frame
+  bool forceShow = displayInvalid;
+  bool widgetChanged = forceShow || widgetZoneInvalid;
+  bool animationChanged = forceShow || animationZoneInvalid;
+  displayInvalid = false;
+  widgetZoneInvalid = false;
+  animationZoneInvalid = false;
+
+  widgetChanged |= tickWidget(currentWidget);
+  animationChanged |= tickAnimationZone();
+
+  uint32_t animationRows = animationZoneRows();
+  uint32_t dirtyRows = 0;
+  if (widgetChanged) {
+    dirtyRows |= WIDGET_ZONE_ROWS;
+  }
+  if (animationChanged || animationRows != lastAnimationRows) {
+    // Old and new footprint: pixels left behind by the previous frame must go too
+    dirtyRows |= animationRows | lastAnimationRows;
+  }
+  if (tickOverlay()) {
+    // A message appeared, or the layers under an expired one need repainting
+    dirtyRows |= OVERLAY_ROWS;
+  }
 
-  // Clear the entire screen first
-  matrix.fillScreen(0);
+  if (dirtyRows == 0) {
+    return false; // Static scene - nothing to draw or show
+  }
 
-  // Update widget zone (y=0-14)
-    //  updateWidgets();
-    // Draw widgets only in top zone
+  // Nothing of the widgets shows under an animation that covers their zone
+  bool widgetsHidden = (animationRows & WIDGET_ZONE_ROWS) == WIDGET_ZONE_ROWS;
+  bool redrawWidgets = (dirtyRows & WIDGET_ZONE_ROWS) != 0 && !widgetsHidden;
+  // The animation is the top layer: repaint it when it changed, or when the
+  // widget layer is repainted underneath rows it draws into
+  bool redrawAnimation = (dirtyRows & animationRows) != 0 ||
+                         (redrawWidgets && (animationRows & WIDGET_ZONE_ROWS) != 0);
+
+  uint32_t redrawnRows = 0;
+  if (redrawWidgets) {
+    // Widget zone (y=0-14)
+    ProfileScope widgetScope(PROFILE_WIDGET_DRAW);
+    matrix.fillRect(0, 0, WIDTH, WIDGET_ZONE_HEIGHT, 0);
     drawWidget(currentWidget, 0, 0, 64, WIDGET_ZONE_HEIGHT);
-  // Update animation zone (y=15-31) based on current animation
-  updateAnimationZone();
+    redrawnRows |= WIDGET_ZONE_ROWS;
+
+    if (!redrawAnimation) {
+      // Text on a widget's bottom line can spill into the animation zone;
+      // put back the rows the unchanged animation left there
+      memcpy(matrix.getBuffer() + ANIMATION_ZONE_Y * WIDTH, shownFrame + ANIMATION_ZONE_Y * WIDTH,
+             WIDGET_OVERHANG_ROWS * WIDTH * sizeof(uint16_t));
+    }
+  }
+
+  if (redrawAnimation) {
+    // Animation zone (y=15-31)
+    ProfileScope animationScope(PROFILE_ANIMATION_DRAW);
+    matrix.fillRect(0, ANIMATION_ZONE_Y, WIDTH, ANIMATION_ZONE_HEIGHT, 0);
+    updateAnimationZone();
+    redrawnRows |= ANIMATION_ZONE_ROWS | animationRows;
+  }
+  lastAnimationRows = animationRows;
+
+  if (overlayShowing() && (redrawnRows & OVERLAY_ROWS)) {
+    // Status messages sit above everything
+    drawOverlay();
+    redrawnRows |= OVERLAY_ROWS;
+  }
+
+  // Compare the repainted rows with what is on the panel; skip show() if identical
+  uint16_t *frame = matrix.getBuffer();
+  bool frameChanged = forceShow;
+  for (int y = 0; y < HEIGHT; y++) {
+    if (!(redrawnRows & (1u << y))) continue;
+    uint16_t *row = frame + y * WIDTH;
+    uint16_t *shownRow = shownFrame + y * WIDTH;
+    if (memcmp(row, shownRow, WIDTH * sizeof(uint16_t)) != 0) {
+      memcpy(shownRow, row, WIDTH * sizeof(uint16_t));
+      frameChanged = true;
+    }
+  }
+
+  if (!frameChanged) {
+    return false;
+  }
 
   // Show the combined result ONCE per frame
+  ProfileScope showScope(PROFILE_SHOW);
   matrix.show();
+  return true;
+}
+
+// Advance the current animation's timers. Returns true if its next frame differs.
+bool tickAnimationZone() {
+  switch (currentAnimation) {
+  case ANIMATION_PATTERN:
+    return tickPattern();
+  case ANIMATION_SCROLLING_TEXT:
+    return tickScrollText();
+  case ANIMATION_TRUCK:
+    return tickTruck();
+  case ANIMATION_STREAM:
+    return tickStreamFrame();
+  case ANIMATION_PIXELS:
+    return tickPixelFrame();
+  case ANIMATION_SOLID_COLOR:
+  case ANIMATION_NONE:
+  default:
+    return false; // Static until a setter invalidates the zone
+  }
 }
 
 void updateAnimationZone() {
@@ -64,6 +205,12 @@ void updateAnimationZone() {
   case ANIMATION_TRUCK:
     animateTruck();
     break;
+  case ANIMATION_STREAM:
+    drawStreamFrame();
+    break;
+  case ANIMATION_PIXELS:
+    drawPixelFrame();
+    break;
   case ANIMATION_SOLID_COLOR:
     drawSolidColor();
     break;
@@ -79,39 +226,65 @@ void drawSolidColor() {
   matrix.fillRect(0, ANIMATION_ZONE_Y, WIDTH, ANIMATION_ZONE_HEIGHT, currentColor);
 }
 
-void animatePattern() {
+bool tickPattern() {
   static uint32_t lastPatternUpdate = 0;
 
   if (millis() - lastPatternUpdate > 150) {
-    // Draw pattern only in animation zone - NO CLEARING HERE
-    for (int x = 0; x < WIDTH; x++) {
-      for (int y = ANIMATION_ZONE_Y; y < HEIGHT; y++) {
-        int colorIndex = ((x + y + patternFrame) / 8) % 6 + 1;  // Skip black
-        uint16_t dimColor = colors[colorIndex];
-        int r = ((dimColor >> 11) & 0x1F) >> 1;  // Half brightness
-        int g = ((dimColor >> 5) & 0x3F) >> 1;
-        int b = (dimColor & 0x1F) >> 1;
-        matrix.drawPixel(x, y, matrix.color565(r << 3, g << 2, b << 3));
-      }
-    }
     patternFrame++;
     lastPatternUpdate = millis();
-  } else {
-    // Redraw the current pattern frame (no animation update)
+    return true;
+  }
+  return false;
+}
+
+// Palette-cycled pattern. The diagonal bands repeat every 6 colors x 8 pixels,
+// so each pixel is rasterized once as a phase index; advancing the animation
+// only rotates the palette.
+#define PATTERN_PHASES 48
+static uint8_t patternIndex[ANIMATION_ZONE_HEIGHT][WIDTH];
+static uint16_t patternPalette[PATTERN_PHASES];
+static bool patternRasterized = false;
+
+static void rasterizePattern() {
+  for (int i = 0; i < PATTERN_PHASES; i++) {
+    uint16_t dimColor = colors[(i / 8) % 6 + 1];  // Skip black
+    int r = ((dimColor >> 11) & 0x1F) >> 1;  // Half brightness
+    int g = ((dimColor >> 5) & 0x3F) >> 1;
+    int b = (dimColor & 0x1F) >> 1;
+    patternPalette[i] = matrix.color565(r << 3, g << 2, b << 3);
+  }
+
+  for (int row = 0; row < ANIMATION_ZONE_HEIGHT; row++) {
     for (int x = 0; x < WIDTH; x++) {
-      for (int y = ANIMATION_ZONE_Y; y < HEIGHT; y++) {
-        int colorIndex = ((x + y + patternFrame) / 8) % 6 + 1;
-        uint16_t dimColor = colors[colorIndex];
-        int r = ((dimColor >> 11) & 0x1F) >> 1;
-        int g = ((dimColor >> 5) & 0x3F) >> 1;
-        int b = (dimColor & 0x1F) >> 1;
-        matrix.drawPixel(x, y, matrix.color565(r << 3, g << 2, b << 3));
-      }
+      patternIndex[row][x] = (x + ANIMATION_ZONE_Y + row) % PATTERN_PHASES;
     }
   }
+  patternRasterized = true;
 }
 
-void scrollText() {
+void animatePattern() {
+  if (!patternRasterized) {
+    rasterizePattern();
+  }
+
+  // Rotate the palette to the current frame
+  uint16_t palette[PATTERN_PHASES];
+  int shift = (uint32_t)patternFrame % PATTERN_PHASES;
+  memcpy(palette, patternPalette + shift, (PATTERN_PHASES - shift) * sizeof(uint16_t));
+  memcpy(palette + PATTERN_PHASES - shift, patternPalette, shift * sizeof(uint16_t));
+
+  // Blit whole rows straight into the animation zone - NO CLEARING HERE
+  uint16_t *dst = matrix.getBuffer() + ANIMATION_ZONE_Y * WIDTH;
+  for (int row = 0; row < ANIMATION_ZONE_HEIGHT; row++) {
+    const uint8_t *index = patternIndex[row];
+    for (int x = 0; x < WIDTH; x++) {
+      dst[x] = palette[index[x]];
+    }
+    dst += WIDTH;
+  }
+}
+
+bool tickScrollText() {
   static uint32_t lastTextUpdate = 0;
 
   if (millis() - lastTextUpdate > 120) {
@@ -120,14 +293,24 @@ void scrollText() {
       scrollPosition = WIDTH;
     }
     lastTextUpdate = millis();
+    return true;
+  }
+  return false;
+}
+
+// Scrolling text is rasterized once per message, on the display task
+static TextStrip scrollStrip;
+static volatile bool scrollStripStale = true;
+
+void scrollText() {
+  if (scrollStripStale) {
+    scrollStripStale = false;
+    setTextStripText(scrollStrip, displayText);
   }
 
   // Always draw the text at current position - NO CLEARING HERE
-  matrix.setTextWrap(false);
-  matrix.setCursor(scrollPosition, ANIMATION_ZONE_Y + (ANIMATION_ZONE_HEIGHT / 2) - 4);
-  matrix.setTextSize(1);
-  matrix.setTextColor(matrix.color565(255, 255, 255));
-  matrix.print(displayText);
+  drawTextStrip(scrollStrip, scrollPosition, ANIMATION_ZONE_Y + (ANIMATION_ZONE_HEIGHT / 2) - 4,
+                matrix.color565(255, 255, 255));
 }
 
 // void animateTruck() {
@@ -208,8 +391,9 @@ void scrollText() {
 //   }
 // }
 
-void animateTruck() {
+bool tickTruck() {
   static uint32_t lastTruckUpdateTime = 0;
+  bool changed = false;
 
   if (millis() - lastTruckUpdateTime > 80) {
     truckPosition -= 1;
@@ -217,80 +401,124 @@ void animateTruck() {
       truckPosition = WIDTH;
     }
     lastTruckUpdateTime = millis();
+    changed = true;
   }
 
-  // Always draw truck at current position - NO CLEARING HERE
-  int baseY = ANIMATION_ZONE_Y + 5;
-
-    // road background
-    matrix.drawLine(0, 31, WIDTH, 31, matrix.color565(50, 50, 50));  // Dark gray road
-    matrix.drawLine(0, 20, WIDTH, 20, matrix.color565(50, 50, 50));  // Dark gray road
-    // dashed line
-    for (int x = 0; x < WIDTH; x += 8) {
-      matrix.drawLine(x, 25, x + 4, 25, matrix.color565(252, 225, 15));  // Yellow dashed line
-    }
-
-    // Truck cab (more realistic shape)
-    matrix.fillRect(truckPosition, 20, 10, 8, matrix.color565(0, 100, 200));     // Blue cab
-    matrix.fillRect(truckPosition + 1, 19, 8, 6, matrix.color565(0, 150, 255));  // Lighter blue windows
-
-    // Cab details
-    matrix.drawPixel(truckPosition + 2, 20, matrix.color565(200, 200, 255));  // Windshield
-    matrix.drawPixel(truckPosition + 3, 20, matrix.color565(200, 200, 255));
-    matrix.drawPixel(truckPosition + 4, 20, matrix.color565(200, 200, 255));
-    matrix.drawLine(truckPosition + 5, 22, truckPosition + 5, 27, matrix.color565(0, 50, 150));  // Door line
-
-    // Container/trailer (larger and more detailed)
-    matrix.fillRect(truckPosition + 10, 16, 28, 12, matrix.color565(220, 220, 220));  // Light gray container
-    matrix.drawRect(truckPosition + 10, 16, 28, 12, matrix.color565(180, 180, 180));  // Container border
-
-    // Container details (corrugated sides)
-    matrix.drawLine(truckPosition + 13, 16, truckPosition + 13, 27, matrix.color565(180, 180, 180));
-    matrix.drawLine(truckPosition + 17, 16, truckPosition + 17, 27, matrix.color565(180, 180, 180));
-    matrix.drawLine(truckPosition + 21, 16, truckPosition + 21, 27, matrix.color565(180, 180, 180));
-    matrix.drawLine(truckPosition + 25, 16, truckPosition + 25, 27, matrix.color565(180, 180, 180));
-    matrix.drawLine(truckPosition + 29, 16, truckPosition + 29, 27, matrix.color565(180, 180, 180));
-
-    // Company logo on container (moved further left)
-    if (truckPosition + 12 >= -30) {
-      drawCompanyLogo(truckPosition + 12, 18);
-    }
-
-    // More realistic wheels - repositioned for longer trailer
-    // Front wheel (cab)
-    matrix.fillRect(truckPosition + 2, 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
-    matrix.drawPixel(truckPosition + 3, 29, matrix.color565(120, 120, 120));    // Rim
-
-    // Middle wheel (trailer front)
-    matrix.fillRect(truckPosition + 14, 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
-    matrix.drawPixel(truckPosition + 15, 29, matrix.color565(120, 120, 120));    // Rim
+  // Exhaust smoke flashes independently of the truck's movement
+  bool smokeOn = millis() % 500 < 250;
+  if (smokeOn != truckSmokeOn) {
+    truckSmokeOn = smokeOn;
+    changed = true;
+  }
+  return changed;
+}
 
-    // Back wheel (trailer rear) - moved to end of longer container
-    matrix.fillRect(truckPosition + 28, 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
-    matrix.drawPixel(truckPosition + 29, 29, matrix.color565(120, 120, 120));    // Rim
+// Truck art, rendered once into sprites. Coordinates are the panel
+// coordinates of the old per-frame drawing with the truck at x.
+static void paintRoad(Adafruit_GFX &gfx, int x, int y) {
+  // road background
+  gfx.drawLine(x, y + 31, x + WIDTH, y + 31, matrix.color565(50, 50, 50));  // Dark gray road
+  gfx.drawLine(x, y + 20, x + WIDTH, y + 20, matrix.color565(50, 50, 50));  // Dark gray road
+  // dashed line
+  for (int dx = 0; dx < WIDTH; dx += 8) {
+    gfx.drawLine(x + dx, y + 25, x + dx + 4, y + 25, matrix.color565(252, 225, 15));  // Yellow dashed line
+  }
+}
 
-    // Connection between cab and trailer
-    matrix.drawLine(truckPosition + 9, 22, truckPosition + 11, 22, matrix.color565(100, 100, 100));
+static void paintTruck(Adafruit_GFX &gfx, int x, int y) {
+  // Truck cab (more realistic shape)
+  gfx.fillRect(x, y + 20, 10, 8, matrix.color565(0, 100, 200));     // Blue cab
+  gfx.fillRect(x + 1, y + 19, 8, 6, matrix.color565(0, 150, 255));  // Lighter blue windows
+
+  // Cab details
+  gfx.drawPixel(x + 2, y + 20, matrix.color565(200, 200, 255));  // Windshield
+  gfx.drawPixel(x + 3, y + 20, matrix.color565(200, 200, 255));
+  gfx.drawPixel(x + 4, y + 20, matrix.color565(200, 200, 255));
+  gfx.drawLine(x + 5, y + 22, x + 5, y + 27, matrix.color565(0, 50, 150));  // Door line
+
+  // Container/trailer (larger and more detailed)
+  gfx.fillRect(x + 10, y + 16, 28, 12, matrix.color565(220, 220, 220));  // Light gray container
+  gfx.drawRect(x + 10, y + 16, 28, 12, matrix.color565(180, 180, 180));  // Container border
+
+  // Container details (corrugated sides)
+  gfx.drawLine(x + 13, y + 16, x + 13, y + 27, matrix.color565(180, 180, 180));
+  gfx.drawLine(x + 17, y + 16, x + 17, y + 27, matrix.color565(180, 180, 180));
+  gfx.drawLine(x + 21, y + 16, x + 21, y + 27, matrix.color565(180, 180, 180));
+  gfx.drawLine(x + 25, y + 16, x + 25, y + 27, matrix.color565(180, 180, 180));
+  gfx.drawLine(x + 29, y + 16, x + 29, y + 27, matrix.color565(180, 180, 180));
+
+  // Company logo on container (moved further left)
+  drawCompanyLogo(gfx, x + 12, y + 18);
+
+  // More realistic wheels - repositioned for longer trailer
+  // Front wheel (cab)
+  gfx.fillRect(x + 2, y + 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
+  gfx.drawPixel(x + 3, y + 29, matrix.color565(120, 120, 120));    // Rim
+
+  // Middle wheel (trailer front)
+  gfx.fillRect(x + 14, y + 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
+  gfx.drawPixel(x + 15, y + 29, matrix.color565(120, 120, 120));    // Rim
+
+  // Back wheel (trailer rear) - moved to end of longer container
+  gfx.fillRect(x + 28, y + 28, 3, 3, matrix.color565(40, 40, 40));  // Tire
+  gfx.drawPixel(x + 29, y + 29, matrix.color565(120, 120, 120));    // Rim
+
+  // Connection between cab and trailer
+  gfx.drawLine(x + 9, y + 22, x + 11, y + 22, matrix.color565(100, 100, 100));
+
+  // Headlights
+  gfx.drawPixel(x - 1, y + 25, matrix.color565(255, 255, 200));  // Headlight
+  gfx.drawPixel(x - 1, y + 27, matrix.color565(255, 255, 200));  // Headlight
+
+  // Tail lights - moved to end of longer container
+  gfx.drawPixel(x + 38, y + 25, matrix.color565(255, 0, 0));  // Red tail light (top)
+  gfx.drawPixel(x + 38, y + 27, matrix.color565(255, 0, 0));  // Red tail light (bottom)
+
+  // Exhaust stack behind cab
+  gfx.fillRect(x + 8, y + 17, 1, 4, matrix.color565(60, 60, 60));  // Stack body
+  gfx.drawPixel(x + 8, y + 16, matrix.color565(80, 80, 80));       // Stack top
+  gfx.drawPixel(x + 8, y + 15, matrix.color565(100, 100, 100));    // Stack cap
+}
 
-    // Headlights
-    matrix.drawPixel(truckPosition - 1, 25, matrix.color565(255, 255, 200));  // Headlight
-    matrix.drawPixel(truckPosition - 1, 27, matrix.color565(255, 255, 200));  // Headlight
+static void paintSmoke(Adafruit_GFX &gfx, int x, int y) {
+  gfx.drawPixel(x + 10, y + 13, matrix.color565(80, 80, 80));
+  gfx.drawPixel(x + 9, y + 14, matrix.color565(60, 60, 60));
+}
 
-    // Tail lights - moved to end of longer container
-    matrix.drawPixel(truckPosition + 38, 25, matrix.color565(255, 0, 0));  // Red tail light (top)
-    matrix.drawPixel(truckPosition + 38, 27, matrix.color565(255, 0, 0));  // Red tail light (bottom)
+// Sprite bounds relative to truckPosition: headlights at -1 to tail lights at +38,
+// exhaust cap (y=15) down to the wheels (y=30)
+#define TRUCK_SPRITE_X (-1)
+#define TRUCK_SPRITE_WIDTH 40
+#define TRUCK_SPRITE_HEIGHT 16
+#define SMOKE_SPRITE_X 9
+#define SMOKE_SPRITE_Y (ANIMATION_ZONE_Y - 2)
+
+static Sprite roadSprite;
+static Sprite truckSprite;
+static Sprite smokeSprite;
+
+static bool renderTruckSprites() {
+  static bool rendered = false;
+  if (!rendered) {
+    rendered = renderSprite(roadSprite, WIDTH, ANIMATION_ZONE_HEIGHT, paintRoad, 0, -ANIMATION_ZONE_Y) &&
+               renderSprite(truckSprite, TRUCK_SPRITE_WIDTH, TRUCK_SPRITE_HEIGHT, paintTruck,
+                            -TRUCK_SPRITE_X, -ANIMATION_ZONE_Y) &&
+               renderSprite(smokeSprite, 2, 2, paintSmoke, -SMOKE_SPRITE_X, -SMOKE_SPRITE_Y);
+  }
+  return rendered;
+}
 
-    // Exhaust stack behind cab
-    matrix.fillRect(truckPosition + 8, 17, 1, 4, matrix.color565(60, 60, 60));  // Stack body
-    matrix.drawPixel(truckPosition + 8, 16, matrix.color565(80, 80, 80));       // Stack top
-    matrix.drawPixel(truckPosition + 8, 15, matrix.color565(100, 100, 100));    // Stack cap
+void animateTruck() {
+  if (!renderTruckSprites()) return;
 
-    // exhaust smoke
-    if (millis() % 500 < 250) {  // Flashing smoke effect
-      matrix.drawPixel(truckPosition + 10, 13, matrix.color565(80, 80, 80));
-      matrix.drawPixel(truckPosition + 9, 14, matrix.color565(60, 60, 60));
-    }
+  // Always draw truck at current position - NO CLEARING HERE
+  blitSprite(roadSprite, 0, ANIMATION_ZONE_Y);
+  blitSprite(truckSprite, truckPosition + TRUCK_SPRITE_X, ANIMATION_ZONE_Y);
 
+  // exhaust smoke
+  if (truckSmokeOn) {  // Flashing smoke effect
+    blitSprite(smokeSprite, truckPosition + SMOKE_SPRITE_X, SMOKE_SPRITE_Y);
+  }
 }
 
 
@@ -299,6 +527,7 @@ void setAnimationColor(int colorIndex) {
   if (colorIndex >= 0 && colorIndex < 8) {
     currentAnimation = ANIMATION_SOLID_COLOR;
     currentColor = colors[colorIndex];
+    invalidateAnimationZone();
     Serial.printf("Animation color: %s (0x%04X)\n", colorNames[colorIndex], currentColor);
   }
 }
@@ -306,39 +535,62 @@ void setAnimationColor(int colorIndex) {
 void setAnimationPattern() {
   currentAnimation = ANIMATION_PATTERN;
   patternFrame = 0;
+  invalidateAnimationZone();
   Serial.println("Pattern animation activated");
 }
 
 void setAnimationText(String text) {
+  // The text strip holds at most TEXT_STRIP_MAX_CHARS characters
+  if (text.length() > TEXT_STRIP_MAX_CHARS) {
+    text = text.substring(0, TEXT_STRIP_MAX_CHARS);
+  }
   displayText = text;
+  scrollStripStale = true;
   currentAnimation = ANIMATION_SCROLLING_TEXT;
   scrollPosition = WIDTH;
+  invalidateAnimationZone();
   Serial.println("Text animation: " + displayText);
 }
 
 void setTruckAnimation() {
   currentAnimation = ANIMATION_TRUCK;
   truckPosition = WIDTH;
+  invalidateAnimationZone();
   Serial.println("Truck animation activated");
 }
 
+// Called by the frame stream when a new sender's first frame arrives
+void setStreamAnimation() {
+  currentAnimation = ANIMATION_STREAM;
+  invalidateAnimationZone();
+  Serial.println("Stream animation activated");
+}
+
+// The network task opens the DDP and E1.31 sockets on its next poll
+void setPixelAnimation() {
+  currentAnimation = ANIMATION_PIXELS;
+  invalidateAnimationZone();
+  Serial.println("Pixel receiver animation activated");
+}
+
 void clearAnimationZone() {
   currentAnimation = ANIMATION_NONE;
+  invalidateAnimationZone();
   Serial.println("Animation zone cleared");
 }
 
 
 // Keep existing functions...
-void drawCompanyLogo(int x, int y) {
-  matrix.fillRect(x, y, 8, 5, matrix.color565(0, 180, 0));
-  matrix.fillRect(x + 1, y + 5, 6, 1, matrix.color565(0, 180, 0));
-  matrix.fillRect(x + 3, y + 6, 2, 1, matrix.color565(0, 180, 0));
-
-  matrix.setTextColor(matrix.color565(0, 0, 0));
-  matrix.setTextSize(1);
-  matrix.setTextWrap(false);
-  matrix.setCursor(x + 8, y);
-  matrix.print("IMC");
+void drawCompanyLogo(Adafruit_GFX &gfx, int x, int y) {
+  gfx.fillRect(x, y, 8, 5, matrix.color565(0, 180, 0));
+  gfx.fillRect(x + 1, y + 5, 6, 1, matrix.color565(0, 180, 0));
+  gfx.fillRect(x + 3, y + 6, 2, 1, matrix.color565(0, 180, 0));
+
+  gfx.setTextColor(matrix.color565(0, 0, 0));
+  gfx.setTextSize(1);
+  gfx.setTextWrap(false);
+  gfx.setCursor(x + 8, y);
+  gfx.print("IMC");
 }
 
 void initializeMatrix() {
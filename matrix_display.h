@@ -17,9 +17,19 @@ extern int patternFrame;
 // Matrix management
 void initializeMatrix();
 void testMatrix();
-void updateMatrixDisplay();
+bool updateMatrixDisplay();   // Returns true when a new frame was shown
+
+// Frame compositor - zones are only redrawn when invalidated or their content ticks
+void invalidateWidgetZone();
+void invalidateAnimationZone();
+void invalidateDisplay();
+uint32_t animationZoneRows();
 
 // Animation zone functions (y=15-31)
+bool tickAnimationZone();
+bool tickPattern();
+bool tickScrollText();
+bool tickTruck();
 void updateAnimationZone();
 void animatePattern();
 void scrollText();
@@ -32,10 +42,12 @@ void setAnimationColor(int colorIndex);
 void setAnimationPattern();
 void setAnimationText(String text);
 void setTruckAnimation();
+void setStreamAnimation();
+void setPixelAnimation();
 void clearAnimationZone();
 
 // Utility functions
 void showMatrixIPAddress();
-void drawCompanyLogo(int x, int y);
+void drawCompanyLogo(Adafruit_GFX &gfx, int x, int y);
 
 #endif
\ No newline at end of file
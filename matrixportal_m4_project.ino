@@ -3,6 +3,12 @@
 #include "web_server.h"
 #include "matrix_display.h"
 #include "widgets.h"
+#include "profiler.h"
+#include "http_pool.h"
+#include "token_manager.h"
+#include "warm_start.h"
+#include "frame_stream.h"
+#include "pixel_receiver.h"
 #include "Arduino.h"
 #include <FreeRTOS_SAMD51.h>
 
@@ -28,10 +34,13 @@ void setup() {
     Serial.println("=== MatrixPortal M4 FreeRTOS Project ===");
 
     // Initialize hardware first
+    initializeProfiler();
     initializeMatrix();
     initializeWidgets();
+    restoreWarmStart();     // Last settings, data and tokens from flash
     initializeWiFi();
     initializeWebServer();
+    initializeFrameStream();
 
     Serial.println("Hardware initialization complete!");
 
@@ -96,21 +105,29 @@ void displayTask(void *pvParameters) {
     const TickType_t xFrequency = pdMS_TO_TICKS(16); // ~60 FPS (16ms)
 
     uint32_t frameCount = 0;
+    uint32_t shownCount = 0;
     uint32_t lastStatsReport = 0;
 
     while(1) {
+        profileFrameWake();
         frameCount++;
 
         // Update display - this is always fast and never blocks
-        updateMatrixDisplay();
+        // Static scenes are skipped entirely, so shown frames can be far below 60
+        if (updateMatrixDisplay()) {
+            shownCount++;
+            profileFrameShown();
+        }
 
         // Report performance stats every 5 seconds
         uint32_t now = millis();
         if (now - lastStatsReport > 5000) {
             float fps = frameCount / ((now - lastStatsReport) / 1000.0);
-            Serial.printf("Display: %.1f FPS, Free heap: %d bytes\n",
-                          fps, xPortGetFreeHeapSize());
+            float shownFps = shownCount / ((now - lastStatsReport) / 1000.0);
+            Serial.printf("Display: %.1f FPS (%.1f shown), Free heap: %d bytes\n",
+                          fps, shownFps, xPortGetFreeHeapSize());
             frameCount = 0;
+            shownCount = 0;
             lastStatsReport = now;
         }
 
@@ -125,38 +142,50 @@ void displayTask(void *pvParameters) {
 void networkTask(void *pvParameters) {
     Serial.println("Network task started!");
 
-    TickType_t lastWiFiCheck = 0;
-    const TickType_t wifiCheckInterval = pdMS_TO_TICKS(10000); // 10 seconds
-
     while(1) {
-        TickType_t now = xTaskGetTickCount();
-
-        // WiFi connection maintenance (every 10 seconds)
-        if ((now - lastWiFiCheck) > wifiCheckInterval) {
-            if (!isWiFiConnected()) {
-                Serial.println("Network: WiFi disconnected, attempting reconnection...");
-                handleWiFiReconnection();
-            }
-            lastWiFiCheck = now;
-        }
+        // WiFi connection maintenance: checks the link every 10 seconds and
+        // moves a reconnection along one step, without waiting on the radio
+        handleWiFiReconnection();
 
         // Only do network operations if WiFi is connected
         if (isWiFiConnected()) {
-            // Use existing widget update logic - this handles all timing internally
-            // The updateWidgets() function already:
-            // - Checks if it's time to update each widget type
-            // - Only updates the currently active widget
-            // - Handles all the timing intervals (weather every 10 minutes, etc.)
-            // - Updates the global data structures (currentWeather, currentSpotifyTrack, etc.)
+            // updateWidgets() runs the fetch scheduler: the visible widget's source
+            // when it is due, plus at most one background source within the
+            // radio-time budget, so every widget has recent data when it is shown.
+            // API requests are only started here; pollHttpConnections() completes them
+            // OAuth tokens are renewed first, ahead of expiry, so polls never wait on one
+            runTokenRefresh();
             updateWidgets();
 
-            // Handle web server requests (can block briefly)
+            // Reads whatever of a web request has arrived; never waits for the rest
             handleWebClients();
+
+            // Pixels pushed by a frame sender go straight into the animation zone
+            pollFrameStream();
+
+            // Lighting controller packets, while that animation is selected
+            pollPixelReceiver();
         }
 
-        // Sleep for 500ms - updateWidgets() has its own timing logic
-        // so we don't need to check as frequently
-        vTaskDelay(pdMS_TO_TICKS(500));
+        // Advance API requests in flight; they fail on their own deadlines
+        // if WiFi dropped underneath them
+        pollHttpConnections();
+
+        // Persist what changed; the flash store paces the actual writes
+        saveWarmStart();
+
+        // Sleep for 500ms - the fetch scheduler keeps its own due times
+        // so we don't need to check as frequently. While a request is in
+        // flight, or a browser is partway through sending one, come back
+        // sooner to pick up the rest. A frame sender or lighting controller
+        // needs reading more often than it sends.
+        TickType_t pause = 500;
+        if (frameStreamConnected() || pixelReceiverListening()) {
+            pause = 5;
+        } else if (httpRequestsInFlight() || webClientsPending()) {
+            pause = 20;
+        }
+        vTaskDelay(pdMS_TO_TICKS(pause));
     }
 }
 
@@ -5,16 +5,10 @@
 #include <WiFiNINA.h>
 #include <ArduinoJson.h>
 
-// Microsoft Graph API configuration
-extern String msGraphAccessToken;
-extern String msGraphRefreshToken;
-extern unsigned long msGraphTokenExpiry;
-
-// Function declarations
+// Consent flow for Microsoft Graph; the tokens themselves are kept by the
+// token manager (TOKEN_MS_GRAPH)
 String getMsGraphAuthURL();
 bool exchangeMsGraphCodeForTokens(String authCode);
-bool refreshMsGraphToken();
-bool isMsGraphTokenValid();
-void setMsGraphTokens(String accessToken, String refreshToken, unsigned long expiryTime);
+bool isMsGraphConfigured();
 
 #endif
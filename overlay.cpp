@@ -0,0 +1,66 @@
+#include "overlay.h"
+#include "matrix_display.h"
+#include <atomic>
+
+struct OverlayMessage {
+  char text[OVERLAY_TEXT_MAX + 1];
+  uint16_t background;
+  uint32_t durationMs;
+};
+
+// Single-producer, single-consumer ring. Each side only writes its own index,
+// and a slot is filled before head moves past it.
+static OverlayMessage queue[OVERLAY_QUEUE_SIZE];
+static std::atomic<uint8_t> head(0);    // Next slot to post into (network task)
+static std::atomic<uint8_t> tail(0);    // Next message to show (display task)
+
+// Owned by the display task
+static OverlayMessage current;
+static bool showing = false;
+static uint32_t shownAt = 0;
+
+bool postOverlay(const char *text, uint16_t background, uint32_t durationMs) {
+  uint8_t slot = head.load();
+  if ((uint8_t)(slot - tail.load()) >= OVERLAY_QUEUE_SIZE) {
+    Serial.println("Overlay queue full, dropped: " + String(text));
+    return false;
+  }
+
+  OverlayMessage &message = queue[slot % OVERLAY_QUEUE_SIZE];
+  strncpy(message.text, text, OVERLAY_TEXT_MAX);
+  message.text[OVERLAY_TEXT_MAX] = '\0';
+  message.background = background;
+  message.durationMs = durationMs;
+  head.store(slot + 1);
+  return true;
+}
+
+bool tickOverlay() {
+  bool changed = false;
+  if (showing && millis() - shownAt >= current.durationMs) {
+    showing = false;
+    changed = true;
+  }
+
+  uint8_t slot = tail.load();
+  if (!showing && slot != head.load()) {
+    current = queue[slot % OVERLAY_QUEUE_SIZE];
+    tail.store(slot + 1);
+    showing = true;
+    shownAt = millis();
+    changed = true;
+  }
+  return changed;
+}
+
+bool overlayShowing() {
+  return showing;
+}
+
+void drawOverlay() {
+  matrix.fillRect(0, 0, WIDTH, OVERLAY_HEIGHT, current.background);
+  matrix.setCursor(2, 1);
+  matrix.setTextColor(matrix.color565(255, 255, 255));
+  matrix.setTextSize(1);
+  matrix.print(current.text);
+}
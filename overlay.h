@@ -0,0 +1,23 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include <Arduino.h>
+
+// Short status messages ("WiFi OK") shown as a bar across the top of the
+// panel, above the widgets and the animation. The network task posts them; the
+// display task shows each for its duration, one after another, as part of its
+// normal frame, so nothing else ever draws to the matrix for them.
+
+#define OVERLAY_HEIGHT 8            // Rows covered from the top of the panel
+#define OVERLAY_TEXT_MAX 10         // Characters that fit across the bar
+#define OVERLAY_QUEUE_SIZE 4        // Messages waiting; must divide 256
+
+// Network task. False (message dropped) when the queue is full
+bool postOverlay(const char *text, uint16_t background, uint32_t durationMs);
+
+// Display task
+bool tickOverlay();                 // True when a message appeared or expired
+bool overlayShowing();
+void drawOverlay();
+
+#endif
@@ -0,0 +1,278 @@
+#include "pixel_receiver.h"
+#include "matrix_display.h"
+#include "snapshot.h"
+#include <WiFiNINA.h>
+#include <WiFiUdp.h>
+
+#define PIXEL_CHANNELS (WIDTH * HEIGHT * 3)
+#define E131_UNIVERSES ((WIDTH * HEIGHT + E131_PIXELS_PER_UNIVERSE - 1) / E131_PIXELS_PER_UNIVERSE)
+
+// Controllers send a frame as a burst (13 universes for this panel); a poll
+// takes a few frames' worth at most
+#define PIXEL_PACKETS_PER_POLL 32
+
+// DDP header (10 bytes, 14 with a timecode)
+#define DDP_HEADER_SIZE 10
+#define DDP_FLAG_VERSION_MASK 0xC0
+#define DDP_FLAG_VERSION_1 0x40
+#define DDP_FLAG_TIMECODE 0x10
+#define DDP_FLAG_QUERY 0x02
+#define DDP_FLAG_PUSH 0x01
+#define DDP_ID_DISPLAY 1
+#define DDP_ID_ALL 255
+
+// E1.31 data packet up to the first slot after the start code, and the sync packet
+#define E131_HEADER_SIZE 126
+#define E131_SYNC_SIZE 49
+#define E131_VECTOR_ROOT_DATA 0x00000004
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define E131_VECTOR_DATA_PACKET 0x00000002
+#define E131_VECTOR_EXTENDED_SYNC 0x00000001
+#define E131_OPTION_PREVIEW 0x80
+#define E131_OPTION_TERMINATED 0x40
+
+struct PixelFrame {
+  uint16_t pixels[WIDTH * HEIGHT];
+};
+
+static WiFiUDP ddp;
+static WiFiUDP e131;
+static bool listening = false;
+
+// Channels land here as they arrive; presenting publishes it whole
+static PixelFrame canvas;
+static Snapshot<PixelFrame> frames;
+
+static uint8_t header[E131_HEADER_SIZE];
+
+static uint8_t ddpSequence = 0;                     // 0 until a numbered packet arrives
+static int16_t e131Sequence[E131_UNIVERSES];        // -1 until the universe's first packet
+static uint16_t e131Pending = 0;                    // Universes written since the last present
+static uint16_t e131SyncAddress = 0;                // Universe whose sync packet presents the frame
+
+static uint32_t ddpPackets = 0;
+static uint32_t e131Packets = 0;
+static uint32_t stalePackets = 0;
+static uint32_t malformedPackets = 0;
+static uint32_t framesPresented = 0;
+static uint32_t framesShown = 0;
+
+static uint32_t bigEndian(const uint8_t *bytes, int count) {
+  uint32_t value = 0;
+  for (int i = 0; i < count; i++) value = (value << 8) | bytes[i];
+  return value;
+}
+
+// One 8-bit channel into its 5- or 6-bit field of an RGB565 pixel
+static void writeChannel(uint32_t channel, uint8_t value) {
+  uint16_t &pixel = canvas.pixels[channel / 3];
+  switch (channel % 3) {
+    case 0: pixel = (pixel & 0x07FF) | ((value & 0xF8) << 8); break;
+    case 1: pixel = (pixel & 0xF81F) | ((value & 0xFC) << 3); break;
+    case 2: pixel = (pixel & 0xFFE0) | (value >> 3); break;
+  }
+}
+
+// length channels starting at channel, clipped to the panel
+static void writeChannels(uint32_t channel, const uint8_t *data, size_t length) {
+  if (channel >= PIXEL_CHANNELS) return;
+  length = min(length, (size_t)(PIXEL_CHANNELS - channel));
+
+  while (length > 0 && channel % 3 != 0) {
+    writeChannel(channel++, *data++);
+    length--;
+  }
+  uint16_t *pixel = canvas.pixels + channel / 3;
+  for (; length >= 3; length -= 3, channel += 3, data += 3) {
+    *pixel++ = ((data[0] & 0xF8) << 8) | ((data[1] & 0xFC) << 3) | (data[2] >> 3);
+  }
+  while (length > 0) {
+    writeChannel(channel++, *data++);
+    length--;
+  }
+}
+
+// The rest of the current packet, a chunk at a time, into the canvas
+static void readChannels(WiFiUDP &udp, uint32_t channel, size_t length) {
+  uint8_t chunk[96];
+  while (length > 0) {
+    int count = udp.read(chunk, min(length, sizeof(chunk)));
+    if (count <= 0) break;
+    writeChannels(channel, chunk, count);
+    channel += count;
+    length -= count;
+  }
+}
+
+static void present() {
+  frames.publish(canvas);
+  framesPresented++;
+  e131Pending = 0;
+}
+
+// 4-bit DDP sequence: the same number again, or one from the older half of
+// the cycle, has been overtaken
+static bool ddpStale(uint8_t sequence) {
+  if (sequence == 0) return false;
+  uint8_t behind = (ddpSequence - sequence) & 0x0F;
+  if (ddpSequence != 0 && behind < 8) return true;
+  ddpSequence = sequence;
+  return false;
+}
+
+// E1.31 6.7.2: drop a packet up to 20 behind the last one of its universe
+static bool e131Stale(int universeIndex, uint8_t sequence) {
+  int16_t &last = e131Sequence[universeIndex];
+  if (last >= 0) {
+    int8_t ahead = (int8_t)(sequence - (uint8_t)last);
+    if (ahead <= 0 && ahead > -20) return true;
+  }
+  last = sequence;
+  return false;
+}
+
+static void receiveDdp(int size) {
+  ddpPackets++;
+  if (size < DDP_HEADER_SIZE || ddp.read(header, DDP_HEADER_SIZE) != DDP_HEADER_SIZE) {
+    malformedPackets++;
+    return;
+  }
+
+  uint8_t flags = header[0];
+  uint8_t type = header[2];
+  uint8_t id = header[3];
+  int headerSize = (flags & DDP_FLAG_TIMECODE) ? DDP_HEADER_SIZE + 4 : DDP_HEADER_SIZE;
+  uint32_t offset = bigEndian(header + 4, 4);
+  uint32_t length = bigEndian(header + 8, 2);
+
+  // Only 8-bit RGB (or untyped) data for this display; queries get no reply
+  bool rgb = type == 0 || type == 0x01 || type == 0x0B;
+  if ((flags & DDP_FLAG_VERSION_MASK) != DDP_FLAG_VERSION_1 || (flags & DDP_FLAG_QUERY) ||
+      (id != DDP_ID_DISPLAY && id != DDP_ID_ALL) || !rgb || headerSize + length > (uint32_t)size) {
+    malformedPackets++;
+    return;
+  }
+  if (ddpStale(header[1] & 0x0F)) {
+    stalePackets++;
+    return;
+  }
+
+  if (headerSize > DDP_HEADER_SIZE) ddp.read(header, headerSize - DDP_HEADER_SIZE);
+  readChannels(ddp, offset, length);
+  if (flags & DDP_FLAG_PUSH) present();
+}
+
+static bool e131Identifier() {
+  static const uint8_t identifier[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+  return memcmp(header + 4, identifier, sizeof(identifier)) == 0;
+}
+
+static void receiveE131(int size) {
+  e131Packets++;
+  int count = e131.read(header, min(size, E131_HEADER_SIZE));
+  if (count < E131_SYNC_SIZE || !e131Identifier()) {
+    malformedPackets++;
+    return;
+  }
+
+  uint32_t rootVector = bigEndian(header + 18, 4);
+  uint32_t framingVector = bigEndian(header + 40, 4);
+
+  if (rootVector == E131_VECTOR_ROOT_EXTENDED && framingVector == E131_VECTOR_EXTENDED_SYNC) {
+    if (e131SyncAddress != 0 && bigEndian(header + 45, 2) == e131SyncAddress) present();
+    return;
+  }
+
+  uint32_t slots = bigEndian(header + 123, 2);
+  if (count < E131_HEADER_SIZE || rootVector != E131_VECTOR_ROOT_DATA ||
+      framingVector != E131_VECTOR_DATA_PACKET || header[117] != 0x02 ||
+      slots == 0 || slots > 513 || E131_HEADER_SIZE - 1 + slots > (uint32_t)size) {
+    malformedPackets++;
+    return;
+  }
+
+  // Other start codes (e.g. 0xDD per-channel priority) carry no levels
+  uint8_t options = header[112];
+  int universeIndex = (int)bigEndian(header + 113, 2) - E131_FIRST_UNIVERSE;
+  if (header[125] != 0 || (options & (E131_OPTION_PREVIEW | E131_OPTION_TERMINATED)) ||
+      universeIndex < 0 || universeIndex >= E131_UNIVERSES) {
+    return;
+  }
+  if (e131Stale(universeIndex, header[111])) {
+    stalePackets++;
+    return;
+  }
+
+  e131SyncAddress = bigEndian(header + 109, 2);
+  uint16_t bit = 1u << universeIndex;
+  if (e131SyncAddress == 0 && (e131Pending & bit)) present();    // The next frame started first
+
+  uint32_t channels = min(slots - 1, (uint32_t)E131_PIXELS_PER_UNIVERSE * 3);
+  readChannels(e131, (uint32_t)universeIndex * E131_PIXELS_PER_UNIVERSE * 3, channels);
+  e131Pending |= bit;
+
+  if (e131SyncAddress == 0 && universeIndex == E131_UNIVERSES - 1) present();
+}
+
+static void startListening() {
+  ddp.begin(DDP_PORT);
+  e131.begin(E131_PORT);
+  ddpSequence = 0;
+  for (int16_t &sequence : e131Sequence) sequence = -1;
+  e131Pending = 0;
+  e131SyncAddress = 0;
+  listening = true;
+  Serial.println("Pixel receiver listening: DDP on " + String(DDP_PORT) + ", E1.31 on " + String(E131_PORT));
+}
+
+static void stopListening() {
+  ddp.stop();
+  e131.stop();
+  listening = false;
+  Serial.println("Pixel receiver stopped");
+}
+
+void pollPixelReceiver() {
+  bool wanted = currentAnimation == ANIMATION_PIXELS;
+  if (wanted && !listening) startListening();
+  if (!wanted && listening) stopListening();
+  if (!listening) return;
+
+  for (int i = 0; i < PIXEL_PACKETS_PER_POLL; i++) {
+    int ddpSize = ddp.parsePacket();
+    if (ddpSize > 0) receiveDdp(ddpSize);
+    int e131Size = e131.parsePacket();
+    if (e131Size > 0) receiveE131(e131Size);
+    if (ddpSize <= 0 && e131Size <= 0) break;
+  }
+}
+
+bool pixelReceiverListening() {
+  return listening;
+}
+
+bool tickPixelFrame() {
+  bool fresh;
+  frames.read(&fresh);
+  if (fresh) framesShown++;
+  return fresh;
+}
+
+void drawPixelFrame() {
+  memcpy(matrix.getBuffer(), frames.read().pixels, sizeof(PixelFrame));
+}
+
+void printPixelReceiverMetrics(Print &out) {
+  out.print("pixels_ddp_packets ");
+  out.println(ddpPackets);
+  out.print("pixels_e131_packets ");
+  out.println(e131Packets);
+  out.print("pixels_stale_packets ");
+  out.println(stalePackets);
+  out.print("pixels_malformed_packets ");
+  out.println(malformedPackets);
+  out.print("pixels_frames_presented ");
+  out.println(framesPresented);
+  out.print("pixels_frames_shown ");
+  out.println(framesShown);
+}
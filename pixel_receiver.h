@@ -0,0 +1,36 @@
+#ifndef PIXEL_RECEIVER_H
+#define PIXEL_RECEIVER_H
+
+#include <Arduino.h>
+
+// Lighting-controller input for ANIMATION_PIXELS: the whole 64x32 panel is
+// one pixel fixture, row by row from the top left, 3 channels (RGB) a pixel.
+// While the animation is selected, two UDP sockets are open:
+//
+//   DDP on 4048 - data offset is the byte offset into that layout; the frame
+//                 is shown on a packet with the PUSH flag
+//   E1.31 on 5568 (unicast) - universe E131_FIRST_UNIVERSE holds pixels
+//                 0-169, the next 170-339 and so on; the frame is shown on a
+//                 sync packet for the data's sync address, or without one once
+//                 the panel's last universe (or a repeated one) arrives
+//
+// Packets are read off the socket a chunk at a time and converted straight
+// into the back canvas. Packets with a sequence number behind the last one are
+// dropped, as are previews and terminated streams.
+
+#define DDP_PORT 4048
+#define E131_PORT 5568
+#define E131_FIRST_UNIVERSE 1
+#define E131_PIXELS_PER_UNIVERSE 170
+
+void pollPixelReceiver();                 // Network task: opens/closes the sockets with the animation, reads packets
+bool pixelReceiverListening();
+
+// Display task, for ANIMATION_PIXELS
+bool tickPixelFrame();                    // True when a newer frame was presented
+void drawPixelFrame();                    // Fills the whole panel
+
+// Packets by protocol, stale and malformed drops, frames presented and shown
+void printPixelReceiverMetrics(Print &out);
+
+#endif
@@ -0,0 +1,168 @@
+#include "profiler.h"
+
+#if defined(__SAMD51__)
+#define PROFILE_TICKS_PER_US (F_CPU / 1000000)
+#else
+#include <chrono>
+#define PROFILE_TICKS_PER_US 1000   // Host ticks are nanoseconds
+#endif
+
+struct ProfileHistogram {
+  uint32_t count;
+  uint32_t minTicks;
+  uint32_t maxTicks;
+  uint64_t totalTicks;
+  uint16_t buckets[PROFILE_BUCKETS];
+};
+
+// Each stage is only recorded from one task; /metrics may read a stage while
+// it is being updated, which at worst skews that one line.
+static ProfileHistogram histograms[PROFILE_STAGE_COUNT];
+static uint32_t lateFrames = 0;
+static uint32_t frameCount = 0;
+static uint32_t shownFrameCount = 0;
+
+static const char *stageNames[PROFILE_STAGE_COUNT] = {
+  "frame",
+  "widget_draw",
+  "animation_draw",
+  "show",
+  "fetch_weather",
+  "fetch_spotify",
+  "fetch_teams",
+  "fetch_auth",
+  "json_parse",
+  "web_request",
+  "frame_jitter",
+};
+
+static int bucketIndex(uint32_t ticks) {
+  if (ticks < PROFILE_SUB_BUCKETS) return ticks;
+  int msb = 31 - __builtin_clz(ticks);
+  int sub = (ticks >> (msb - 2)) & (PROFILE_SUB_BUCKETS - 1);
+  return PROFILE_SUB_BUCKETS + (msb - 2) * PROFILE_SUB_BUCKETS + sub;
+}
+
+// Largest value that falls into a bucket
+static uint32_t bucketUpperBound(int index) {
+  if (index < PROFILE_SUB_BUCKETS) return index;
+  int msb = (index - PROFILE_SUB_BUCKETS) / PROFILE_SUB_BUCKETS + 2;
+  int sub = (index - PROFILE_SUB_BUCKETS) % PROFILE_SUB_BUCKETS;
+  uint64_t lower = (uint64_t)(PROFILE_SUB_BUCKETS + sub) << (msb - 2);
+  return (uint32_t)min<uint64_t>(lower + (1ull << (msb - 2)) - 1, 0xFFFFFFFFull);
+}
+
+void initializeProfiler() {
+#if defined(__SAMD51__)
+  // Enable the DWT cycle counter
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    memset(&histograms[i], 0, sizeof(ProfileHistogram));
+    histograms[i].minTicks = 0xFFFFFFFF;
+  }
+  lateFrames = 0;
+  frameCount = 0;
+  shownFrameCount = 0;
+}
+
+uint32_t profileNow() {
+#if defined(__SAMD51__)
+  return DWT->CYCCNT;
+#else
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void profileRecord(ProfileStage stage, uint32_t ticks) {
+  ProfileHistogram &h = histograms[stage];
+  h.count++;
+  h.totalTicks += ticks;
+  if (ticks < h.minTicks) h.minTicks = ticks;
+  if (ticks > h.maxTicks) h.maxTicks = ticks;
+
+  uint16_t &bucket = h.buckets[bucketIndex(ticks)];
+  if (bucket == 0xFFFF) {
+    // Halve everything rather than saturate; percentiles stay proportional
+    for (int i = 0; i < PROFILE_BUCKETS; i++) {
+      h.buckets[i] >>= 1;
+    }
+  }
+  bucket++;
+}
+
+void profileFrameWake() {
+  static uint32_t lastWake = 0;
+  static bool started = false;
+
+  uint32_t now = profileNow();
+  if (started) {
+    const uint32_t period = (uint32_t)PROFILE_FRAME_PERIOD_US * PROFILE_TICKS_PER_US;
+    uint32_t interval = now - lastWake;
+    profileRecord(PROFILE_FRAME_JITTER, interval > period ? interval - period : period - interval);
+
+    // The scheduler tick is 1 ms, so anything past that is a frame that was late
+    if (interval > period + 1000u * PROFILE_TICKS_PER_US) {
+      lateFrames++;
+    }
+  }
+  lastWake = now;
+  started = true;
+  frameCount++;
+}
+
+void profileFrameShown() {
+  shownFrameCount++;
+}
+
+uint32_t profileFrameCount() {
+  return frameCount;
+}
+
+uint32_t profileShownFrameCount() {
+  return shownFrameCount;
+}
+
+static void printMicros(Print &out, uint32_t ticks) {
+  out.print(" ");
+  out.print(ticks / (float)PROFILE_TICKS_PER_US, 1);
+}
+
+void printProfileMetrics(Print &out) {
+  out.println("# stage count min_us avg_us p99_us max_us");
+  for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    const ProfileHistogram &h = histograms[i];
+    out.print(stageNames[i]);
+    out.print(" ");
+    out.print(h.count);
+    if (h.count == 0) {
+      out.println(" 0 0 0 0");
+      continue;
+    }
+
+    // p99 from the buckets; rounded up to the bucket's top, but never past max
+    uint32_t total = 0;
+    for (int b = 0; b < PROFILE_BUCKETS; b++) total += h.buckets[b];
+    uint32_t target = total - total / 100;
+    uint32_t seen = 0;
+    uint32_t p99 = h.maxTicks;
+    for (int b = 0; b < PROFILE_BUCKETS; b++) {
+      seen += h.buckets[b];
+      if (seen >= target) {
+        p99 = min(bucketUpperBound(b), h.maxTicks);
+        break;
+      }
+    }
+
+    printMicros(out, h.minTicks);
+    printMicros(out, (uint32_t)(h.totalTicks / h.count));
+    printMicros(out, p99);
+    printMicros(out, h.maxTicks);
+    out.println();
+  }
+  out.print("frames_late ");
+  out.println(lateFrames);
+}
@@ -0,0 +1,55 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+
+// Lightweight stage timers. On the board they read the Cortex-M4 DWT cycle
+// counter; on the host build they fall back to std::chrono. Every stage keeps a
+// fixed-size log histogram, so recording never allocates.
+
+enum ProfileStage {
+  PROFILE_FRAME = 0,        // All display work for one tick of updateMatrixDisplay()
+  PROFILE_WIDGET_DRAW,
+  PROFILE_ANIMATION_DRAW,
+  PROFILE_SHOW,
+  PROFILE_FETCH_WEATHER,
+  PROFILE_FETCH_SPOTIFY,
+  PROFILE_FETCH_TEAMS,
+  PROFILE_FETCH_AUTH,       // OAuth code exchanges and token refreshes
+  PROFILE_JSON_PARSE,
+  PROFILE_WEB_REQUEST,
+  PROFILE_FRAME_JITTER,     // |display task wake-up interval - 16 ms|
+  PROFILE_STAGE_COUNT
+};
+
+#define PROFILE_FRAME_PERIOD_US 16000
+
+// Histogram buckets: exact below 4 ticks, then 4 buckets per power of two (<= 25% error)
+#define PROFILE_SUB_BUCKETS 4
+#define PROFILE_BUCKETS (PROFILE_SUB_BUCKETS + (32 - 2) * PROFILE_SUB_BUCKETS)
+
+void initializeProfiler();
+uint32_t profileNow();                    // Free-running tick counter
+void profileRecord(ProfileStage stage, uint32_t ticks);
+void profileFrameWake();                  // Call once per display task iteration
+void profileFrameShown();                 // ...and this when the iteration changed the panel
+
+// Display task iterations and shown frames since boot, for rates over any window
+uint32_t profileFrameCount();
+uint32_t profileShownFrameCount();
+
+// Writes one line per stage: count, min/avg/p99/max in microseconds
+void printProfileMetrics(Print &out);
+
+// Times the enclosing block
+class ProfileScope {
+public:
+  ProfileScope(ProfileStage stage) : stage(stage), start(profileNow()) {}
+  ~ProfileScope() { profileRecord(stage, profileNow() - start); }
+
+private:
+  ProfileStage stage;
+  uint32_t start;
+};
+
+#endif
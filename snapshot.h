@@ -0,0 +1,49 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <atomic>
+#include <stdint.h>
+
+// Triple-buffered hand-off of a value from one writer task to one reader task.
+// The writer copies into a slot the reader cannot see and publishes it with one
+// atomic exchange; the reader swaps in the newest slot the same way. Neither
+// side ever waits, and a published value is never written while it is read, so
+// String members can't be torn or freed underneath the reader.
+template <typename T>
+class Snapshot {
+public:
+  Snapshot() : middle(1), writeSlot(0), readSlot(2), published(0) {}
+
+  // Writer side: copy value into the free slot and make it the newest
+  void publish(const T &value) {
+    slots[writeSlot] = value;
+    writeSlot = middle.exchange(writeSlot | FRESH) & SLOT_MASK;
+    published++;
+  }
+
+  // Writer side: how many values were published, to tell whether one changed
+  uint32_t version() const { return published; }
+
+  // Reader side: the newest published value. The reference stays valid and
+  // unchanged until the reader's next read(). fresh is set when it changed.
+  const T &read(bool *fresh = nullptr) {
+    bool changed = (middle.load() & FRESH) != 0;
+    if (changed) {
+      readSlot = middle.exchange(readSlot) & SLOT_MASK;
+    }
+    if (fresh) *fresh = changed;
+    return slots[readSlot];
+  }
+
+private:
+  static const uint8_t SLOT_MASK = 0x03;
+  static const uint8_t FRESH = 0x04;
+
+  T slots[3];
+  std::atomic<uint8_t> middle;  // Slot index of the hand-off buffer, plus FRESH
+  uint8_t writeSlot;            // Owned by the writer
+  uint8_t readSlot;             // Owned by the reader
+  uint32_t published;           // Owned by the writer
+};
+
+#endif
@@ -3,276 +3,207 @@
 #include <WiFiNINA.h>
 #include "wifi_manager.h"
 #include <ArduinoJson.h>
-
-// Spotify authentication state
-static String spotifyAccessToken = "";
-static String spotifyRefreshToken = "";
-static uint32_t tokenExpiry = 0;
-static bool authenticationComplete = false;
+#include "matrix_display.h"
+#include "text_strip.h"
+#include "profiler.h"
+#include "http_pool.h"
+#include "json_arena.h"
+#include "fetch_scheduler.h"
+#include "token_manager.h"
+
+// Next poll while playing: just after the track should end, but no later than
+// this so skips and pauses from another device still show up
+#define SPOTIFY_PLAYING_POLL_MS 30000
+#define SPOTIFY_TRACK_END_SLACK_MS 1500
+#define SPOTIFY_PAUSED_POLL_MS 60000
+
+// Playing-bars animation frame
+static uint8_t playingBarFrame = 0;
+
+// Track and artist text, rasterized when they change
+static TextStrip trackNameStrip;
+static TextStrip artistNameStrip;
 
 // Forward declarations
-bool refreshSpotifyToken();
 bool fetchCurrentlyPlayingFast();
-void parseSpotifyResponseFast(String jsonString);
-
-// Simple Base64 encoding for Basic Auth
-String base64Encode(String input) {
-    const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    String encoded = "";
-    int i = 0;
-    unsigned char char_array_3[3];
-    unsigned char char_array_4[4];
-
-    for (int j = 0; j < input.length(); j++) {
-        char_array_3[i++] = input[j];
-        if (i == 3) {
-            char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-            char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-            char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-            char_array_4[3] = char_array_3[2] & 0x3f;
-
-            for (i = 0; i < 4; i++)
-                encoded += chars[char_array_4[i]];
-            i = 0;
-        }
-    }
+bool parseSpotifyResponseFast(Stream &input, uint32_t progressAnchor);
 
-    if (i) {
-        for (int j = i; j < 3; j++)
-            char_array_3[j] = '\0';
+// The scheduler calls this when the next poll is due; progress between polls
+// comes from the playback clock at draw time
+bool updateSpotifyData() {
+    // Still waiting on the previous request
+    if (spotifyApiConnection.busy()) return false;
 
-        char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-        char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-        char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-        char_array_4[3] = char_array_3[2] & 0x3f;
+    if (!isWiFiConnected()) {
+        Serial.println("WiFi not connected - skipping Spotify update");
+        return false;
+    }
 
-        for (int j = 0; j < i + 1; j++)
-            encoded += chars[char_array_4[j]];
+    Serial.println("Polling Spotify...");
 
-        while (i++ < 3)
-            encoded += '=';
+    // Tokens are renewed in the background; without a usable one, skip this round
+    if (!tokenReady(TOKEN_SPOTIFY)) {
+        Serial.println("No valid Spotify access token yet");
+        return false;
     }
 
-    return encoded;
+    return fetchCurrentlyPlayingFast();
 }
 
-void updateSpotifyData() {
-    static uint32_t lastLightUpdate = 0; // For progress-only updates
+// Nothing changes on its own while paused, so only a track ending needs an early poll
+static uint32_t nextPollDelay(const SpotifyTrackData &track) {
+    if (!track.isPlaying) return SPOTIFY_PAUSED_POLL_MS;
 
-    if (!isWiFiConnected()) {
-        Serial.println("WiFi not connected - skipping Spotify update");
-        return;
-    }
-
-    uint32_t now = millis();
-
-    // Do light updates (just progress) every 10 seconds when playing
-    if (currentSpotifyTrack.isPlaying && currentSpotifyTrack.dataValid) {
-        if (now - lastLightUpdate > 10000) {
-            // Just increment progress without network call
-            currentSpotifyTrack.progressMs += (now - lastLightUpdate);
-            lastLightUpdate = now;
-            Serial.println("Light Spotify update (progress only)");
-            return;
-        }
-    }
+    int32_t remaining = track.durationMs - track.progressMs;
+    if (remaining < 0) remaining = 0;
+    return min((uint32_t)remaining + SPOTIFY_TRACK_END_SLACK_MS, (uint32_t)SPOTIFY_PLAYING_POLL_MS);
+}
 
-    // Full network update every 30 seconds or when no data
-    if (now - lastSpotifyUpdate < 30000 && currentSpotifyTrack.dataValid) {
-        return; // Skip this update
-    }
+// Nothing with a track clock is playing. Not playing also means the next poll
+// waits the paused interval
+static void showNoTrack(const char *trackName, const char *artistName, uint32_t progressAnchor) {
+    currentSpotifyTrack.isPlaying = false;
+    currentSpotifyTrack.trackName = trackName;
+    currentSpotifyTrack.artistName = artistName;
+    // Nothing to show progress for: stop the previous track's clock too
+    currentSpotifyTrack.durationMs = 0;
+    currentSpotifyTrack.progressMs = 0;
+    currentSpotifyTrack.progressAnchor = progressAnchor;
+    currentSpotifyTrack.lastUpdate = millis();
+    currentSpotifyTrack.dataValid = true;
+    publishSpotifyData();
+}
 
-    Serial.println("Full Spotify network update...");
+// Completes the request started by fetchCurrentlyPlayingFast()
+static void handleCurrentlyPlayingResponse(PooledConnection &connection) {
+    bool success = false;
 
-    // Check if we need to refresh the access token
-    if (millis() > tokenExpiry && spotifyRefreshToken.length() > 0) {
-        if (!refreshSpotifyToken()) {
-            Serial.println("Failed to refresh Spotify token");
-            currentSpotifyTrack.dataValid = false;
-            return;
-        }
+    if (connection.status() == 204) {
+        // 204 No Content when nothing is playing
+        Serial.println("No currently playing track");
+        showNoTrack("No Track", "Paused", connection.responseTime());
+        success = true;
+    } else if (connection.status() == 401) {
+        // The access token expired early or was revoked: refresh before the next poll
+        Serial.println("Spotify rejected the access token");
+        invalidateAccessToken(TOKEN_SPOTIFY);
+    } else if (connection.status() == 200) {
+        success = parseSpotifyResponseFast(connection.body(), connection.responseTime());
+        if (!success) connection.markFailed();
     }
 
-    // If we don't have a valid token, we can't fetch data
-    if (spotifyAccessToken.length() == 0) {
-        Serial.println("No Spotify access token available");
-        currentSpotifyTrack.dataValid = false;
-        return;
+    if (success) {
+        fetchSchedulerFetched(WIDGET_SPOTIFY);
+        fetchSchedulerDueIn(WIDGET_SPOTIFY, nextPollDelay(currentSpotifyTrack));
     }
 
-    bool success = fetchCurrentlyPlayingFast();
-
     if (!success) {
         Serial.println("Failed to fetch currently playing track");
         // Keep old data but mark as potentially stale
         if (millis() - currentSpotifyTrack.lastUpdate > 300000) { // 5 minutes
             currentSpotifyTrack.dataValid = false;
+            publishSpotifyData();
         }
     }
+}
 
-    lastSpotifyUpdate = millis();
-    lastLightUpdate = millis();
+bool fetchCurrentlyPlayingFast() {
+    // Kept-alive socket, so most polls skip the TLS handshake. market=from_token
+    // leaves out the per-country market lists, most of the response
+    return spotifyApiConnection.begin("/v1/me/player/currently-playing?market=from_token",
+                                      tokenAuthorization(TOKEN_SPOTIFY), handleCurrentlyPlayingResponse);
 }
 
-bool refreshSpotifyToken() {
-    if (spotifyRefreshToken.length() == 0) {
-        Serial.println("No refresh token available");
-        return false;
-    }
+bool parseSpotifyResponseFast(Stream &input, uint32_t progressAnchor) {
+    // The response is several KB of images, markets and URLs; keep only these
+    JsonArena arena;
+    JsonDocument filter(&arena);
+    filter["progress_ms"] = true;
+    filter["is_playing"] = true;
+    filter["currently_playing_type"] = true;
+    filter["item"]["name"] = true;
+    filter["item"]["duration_ms"] = true;
+    filter["item"]["artists"][0]["name"] = true;
+
+    JsonDocument doc(&arena);
+    uint32_t parseStart = profileNow();
+    DeserializationError error = deserializeJson(doc, input, DeserializationOption::Filter(filter));
+    profileRecord(PROFILE_JSON_PARSE, profileNow() - parseStart);
 
-    WiFiSSLClient client;
-    if (!client.connect("accounts.spotify.com", 443)) {
-        Serial.println("Failed to connect to Spotify accounts");
+    if (error) {
+        Serial.print("JSON parse error: ");
+        Serial.println(error.c_str());
         return false;
     }
 
-    // Prepare Basic Auth header
-    String credentials = String(spotifyClientId) + ":" + String(spotifyClientSecret);
-    String basicAuth = base64Encode(credentials);
-
-    // Prepare the refresh token request
-    String postData = "grant_type=refresh_token&refresh_token=" + spotifyRefreshToken;
-
-    client.println("POST /api/token HTTP/1.1");
-    client.println("Host: accounts.spotify.com");
-    client.println("Content-Type: application/x-www-form-urlencoded");
-    client.println("Authorization: Basic " + basicAuth);
-    client.println("Content-Length: " + String(postData.length()));
-    client.println("Connection: close");
-    client.println();
-    client.println(postData);
-
-    // Wait for response with timeout
-    unsigned long timeout = millis();
-    while (client.available() == 0) {
-        if (millis() - timeout > 5000) {
-            Serial.println("Token refresh timeout");
-            client.stop();
-            return false;
-        }
-    }
-
-    // Skip headers
-    while (client.available()) {
-        String line = client.readStringUntil('\n');
-        line.trim();
-        if (line.length() == 0) break;
-    }
-
-    // Read response
-    String response = "";
-    timeout = millis();
-    while (client.available() && (millis() - timeout < 2000)) {
-        char c = client.read();
-        if (c >= 32 && c <= 126) {
-            response += c;
+    JsonObject item = doc["item"];
+    if (item.isNull()) {
+        // Ads, podcast episodes without additional_types and private sessions
+        // come without an item; don't leave the last track's clock running
+        const char *type = doc["currently_playing_type"].as<const char *>();
+        if (!type) type = "unknown";
+        Serial.print("Nothing to show for playback type ");
+        Serial.println(type);
+        if (strcmp(type, "ad") == 0) {
+            showNoTrack("Advertisement", "Spotify", progressAnchor);
+        } else if (strcmp(type, "episode") == 0) {
+            showNoTrack("Podcast", "Spotify", progressAnchor);
+        } else {
+            showNoTrack("Unknown", "Spotify", progressAnchor);
         }
-    }
-    client.stop();
-
-    // Parse the token response
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, response);
-
-    if (!error && doc["access_token"]) {
-        spotifyAccessToken = doc["access_token"].as<String>();
-        tokenExpiry = millis() + (doc["expires_in"].as<int>() * 1000);
-        Serial.println("Spotify token refreshed successfully");
         return true;
     }
 
-    Serial.println("Failed to refresh Spotify token");
-    return false;
-}
-
-bool fetchCurrentlyPlayingFast() {
-    WiFiSSLClient client;
-    client.setTimeout(2000); // Set socket timeout to 2 seconds
-
-    if (!client.connect("api.spotify.com", 443)) {
-        Serial.println("Failed to connect to Spotify API");
-        return false;
-    }
-
-    // Send request quickly
-    client.print("GET /v1/me/player/currently-playing HTTP/1.1\r\n");
-    client.print("Host: api.spotify.com\r\n");
-    client.print("Authorization: Bearer ");
-    client.print(spotifyAccessToken);
-    client.print("\r\nConnection: close\r\n\r\n");
-
-    // Very short wait for response start
-    unsigned long timeout = millis();
-    while (client.available() == 0) {
-        if (millis() - timeout > 1500) { // Only 1.5 seconds
-            Serial.println("Spotify API timeout");
-            client.stop();
-            return false;
-        }
-    }
+    currentSpotifyTrack.trackName = item["name"].as<String>();
+    currentSpotifyTrack.durationMs = item["duration_ms"].as<int>();
+    currentSpotifyTrack.progressMs = doc["progress_ms"].as<int>();
+    currentSpotifyTrack.progressAnchor = progressAnchor;
+    currentSpotifyTrack.isPlaying = doc["is_playing"].as<bool>();
 
-    // Skip headers ultra-fast
-    bool headersComplete = false;
-    while (client.available() && !headersComplete) {
-        String line = client.readStringUntil('\n');
-        if (line.length() <= 1) headersComplete = true; // Empty line = end of headers
+    JsonArray artists = item["artists"];
+    if (artists.size() > 0) {
+        currentSpotifyTrack.artistName = artists[0]["name"].as<String>();
     }
 
-    // Read response with strict timeout
-    String response = "";
-    timeout = millis();
-    while (client.available() && (millis() - timeout < 1000)) { // Only 1 second for JSON
-        response += (char)client.read();
-    }
-    client.stop();
+    currentSpotifyTrack.lastUpdate = millis();
+    currentSpotifyTrack.dataValid = true;
+    publishSpotifyData();
 
-    if (response.length() == 0) {
-        Serial.println("No currently playing track");
-        currentSpotifyTrack.isPlaying = false;
-        currentSpotifyTrack.trackName = "No Track";
-        currentSpotifyTrack.artistName = "Paused";
-        currentSpotifyTrack.dataValid = true;
-        return true;
-    }
+    Serial.println("♪ " + currentSpotifyTrack.trackName + " - " + currentSpotifyTrack.artistName);
+    return true;
+}
 
-    // Quick JSON validation
-    response.trim();
-    if (response.startsWith("{") && response.endsWith("}")) {
-        parseSpotifyResponseFast(response);
-        return true;
-    }
+// Playback clock: progress at the given time, counted from the last poll
+static int progressAt(const SpotifyTrackData &track, uint32_t now) {
+    if (!track.isPlaying) return track.progressMs;
 
-    Serial.println("Invalid JSON received");
-    return false;
+    uint32_t elapsed = now - track.progressAnchor;
+    uint32_t progress = (uint32_t)max(track.progressMs, 0) + elapsed;
+    return (int)min(progress, (uint32_t)max(track.durationMs, 0));
 }
 
-void parseSpotifyResponseFast(String jsonString) {
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, jsonString);
+// Advance the playing bars and watch the clock; true when the widget needs a redraw
+bool tickSpotifyWidget() {
+    const SpotifyTrackData &track = spotifySnapshot.read();
+    bool changed = false;
 
-    if (error) {
-        Serial.print("JSON parse error: ");
-        Serial.println(error.c_str());
-        return;
+    // Redraw each time the progress passes a whole second
+    static int shownSecond = -1;
+    int second = progressAt(track, millis()) / 1000;
+    if (second != shownSecond) {
+        shownSecond = second;
+        changed = track.dataValid;
     }
 
-    JsonObject item = doc["item"];
-    if (!item.isNull()) {
-        currentSpotifyTrack.trackName = item["name"].as<String>();
-        currentSpotifyTrack.durationMs = item["duration_ms"].as<int>();
-        currentSpotifyTrack.progressMs = doc["progress_ms"].as<int>();
-        currentSpotifyTrack.isPlaying = doc["is_playing"].as<bool>();
-
-        JsonArray artists = item["artists"];
-        if (artists.size() > 0) {
-            currentSpotifyTrack.artistName = artists[0]["name"].as<String>();
-        }
-
-        currentSpotifyTrack.lastUpdate = millis();
-        currentSpotifyTrack.dataValid = true;
-
-        Serial.println("♪ " + currentSpotifyTrack.trackName + " - " + currentSpotifyTrack.artistName);
+    // Only update bars every 100ms for smooth animation
+    static uint32_t lastBarUpdate = 0;
+    if (millis() - lastBarUpdate > 100) {
+        playingBarFrame = (playingBarFrame + 1) % 8; // Cycle through 8 frames
+        lastBarUpdate = millis();
+        changed |= track.isPlaying && track.dataValid;
     }
+
+    return changed;
 }
 
 // Replace the drawSpotifyWidget function with the corrected version
@@ -299,13 +230,9 @@ void drawSpotifyWidget(int x, int y, int width, int height) {
 //        lastSpotifyScroll = millis();
 //    }
 
-    // Update progress every second
-    if (currentSpotifyTrack.isPlaying && millis() - lastSpotifyProgress > 1000) {
-        currentSpotifyTrack.progressMs += 1000;
-        lastSpotifyProgress = millis();
-    }
+    const SpotifyTrackData &track = spotifySnapshot.read();
 
-    if (!currentSpotifyTrack.dataValid) {
+    if (!track.dataValid) {
         // Show loading state with Spotify green
         matrix.fillRect(x, y, width, height, matrix.color565(0, 20, 10)); // Dark green
         matrix.setCursor(x + 2, y + 4);
@@ -316,23 +243,23 @@ void drawSpotifyWidget(int x, int y, int width, int height) {
     }
 
     // Clean background - dark but not black
-    uint16_t bgColor = currentSpotifyTrack.isPlaying ?
+    uint16_t bgColor = track.isPlaying ?
                        matrix.color565(5, 15, 5) :      // Very dark green if playing
                        matrix.color565(15, 10, 5);      // Dark warm color if paused
 
     matrix.fillRect(x, y, width, height, bgColor);
 
     // Progress bar at top (y=0)
-    if (currentSpotifyTrack.durationMs > 0) {
-        drawSpotifyProgressBar(x, 0, width, currentSpotifyTrack.progressMs, currentSpotifyTrack.durationMs);
+    if (track.durationMs > 0) {
+        drawSpotifyProgressBar(x, 0, width, progressAt(track, millis()), track.durationMs);
     }
 
     // Play/pause indicator
-    uint16_t statusColor = currentSpotifyTrack.isPlaying ?
+    uint16_t statusColor = track.isPlaying ?
                            matrix.color565(30, 215, 96) :   // Spotify green
                            matrix.color565(255, 100, 100);  // Light red for paused
 
-    if (currentSpotifyTrack.isPlaying) {
+    if (track.isPlaying) {
         drawPlayingBars(x + 1, y + 3, statusColor);
     } else {
         // Pause symbol - two vertical bars
@@ -344,36 +271,19 @@ void drawSpotifyWidget(int x, int y, int width, int height) {
     matrix.fillRect(x + 8, y + 1, width - 8, 8, bgColor);   // Clear track name area
     matrix.fillRect(x + 8, y + 9, width - 8, 6, bgColor);   // Clear artist name area
 
-    // Track name - WHITE and SIZE 1 (exactly like your global scrollText)
-    matrix.setTextWrap(false);
-
-    // Track name - let it scroll normally, matrix will clip at boundaries
-//    matrix.setCursor(x + 8 + spotifyTitleScroll, y + 1);
-    matrix.setCursor(x + 8, y + 1);
-
-    matrix.setTextColor(matrix.color565(255, 255, 255)); // Pure white
-    matrix.setTextSize(1);
-    matrix.print(currentSpotifyTrack.trackName);
+    // Track name - WHITE, from the cached strip; the strip clips at x + 8 if it ever scrolls
+//    drawTextStrip(trackNameStrip, x + 8 + spotifyTitleScroll, y + 1, color, x + 8);
+    setTextStripText(trackNameStrip, track.trackName);
+    drawTextStrip(trackNameStrip, x + 8, y + 1, matrix.color565(255, 255, 255)); // Pure white
 
-    // Artist name - let it scroll normally, matrix will clip at boundaries
-    matrix.setTextWrap(false);
-//    matrix.setCursor(x + 8 + spotifyArtistScroll, y + 9);
-    matrix.setCursor(x + 8, y + 9);
-
-    matrix.setTextColor(matrix.color565(102, 95, 95)); // Darker gray
-    matrix.setTextSize(1);
-    matrix.print(currentSpotifyTrack.artistName);
+    // Artist name - same as the track name
+//    drawTextStrip(artistNameStrip, x + 8 + spotifyArtistScroll, y + 9, color, x + 8);
+    setTextStripText(artistNameStrip, track.artistName);
+    drawTextStrip(artistNameStrip, x + 8, y + 9, matrix.color565(102, 95, 95)); // Darker gray
 }
 
 void drawPlayingBars(int x, int y, uint16_t color) {
-    static uint8_t barFrame = 0;
-    static uint32_t lastBarUpdate = 0;
-
-    // Only update bars every 100ms for smooth animation
-    if (millis() - lastBarUpdate > 100) {
-        barFrame = (barFrame + 1) % 8; // Cycle through 8 frames
-        lastBarUpdate = millis();
-    }
+    uint8_t barFrame = playingBarFrame;
 
     // Draw 3 animated bars of different heights
     int bar1Height = 3 + (barFrame % 3);           // Height 3-5
@@ -409,12 +319,14 @@ void drawSpotifyProgressBar(int x, int y, int width, int progress, int total) {
     }
 }
 
+// Check if Spotify has been authorized at all
+bool isSpotifyConfigured() {
+    return tokenConfigured(TOKEN_SPOTIFY);
+}
+
 void setSpotifyTokens(String accessToken, String refreshToken) {
-    spotifyAccessToken = accessToken;
-    spotifyRefreshToken = refreshToken;
-    tokenExpiry = millis() + 3600000; // 1 hour from now
-    authenticationComplete = true;
-    Serial.println("Spotify tokens set manually");
+    setTokens(TOKEN_SPOTIFY, accessToken, refreshToken, 3600000); // 1 hour from now
+    fetchSchedulerDueNow(WIDGET_SPOTIFY);
 }
 
 String getSpotifyAuthURL() {
@@ -428,121 +340,14 @@ String getSpotifyAuthURL() {
     return authURL;
 }
 
-bool exchangeCodeForTokens(String authCode) {
-    WiFiSSLClient client;
-
-    Serial.println("Connecting to accounts.spotify.com...");
-
-    if (!client.connect("accounts.spotify.com", 443)) {
-        Serial.println("Failed to connect to Spotify accounts");
-        return false;
-    }
-
-    Serial.println("Connected! Preparing token exchange...");
-
-    // Prepare Basic Auth header
-    String credentials = String(spotifyClientId) + ":" + String(spotifyClientSecret);
-    String basicAuth = base64Encode(credentials);
-
-    // Prepare POST data
-    String postData = "grant_type=authorization_code";
-    postData += "&code=" + authCode;
-    postData += "&redirect_uri=https://spotify.com";
-
-    Serial.println("Sending token request...");
-
-    // Send request
-    client.println("POST /api/token HTTP/1.1");
-    client.println("Host: accounts.spotify.com");
-    client.println("Authorization: Basic " + basicAuth);
-    client.println("Content-Type: application/x-www-form-urlencoded");
-    client.println("Content-Length: " + String(postData.length()));
-    client.println("Connection: close");
-    client.println();
-    client.println(postData);
-
-    Serial.println("Waiting for response...");
-
-    // Wait for response with shorter timeout
-    unsigned long timeout = millis();
-    while (client.available() == 0) {
-        if (millis() - timeout > 10000) {
-            Serial.println("Token exchange timeout");
-            client.stop();
-            return false;
-        }
-    }
-
-    Serial.println("Response received, reading headers...");
-
-    // Read status line
-    String statusLine = client.readStringUntil('\n');
-    Serial.println("Status: " + statusLine);
-
-    // Skip remaining headers
-    while (client.available()) {
-        String line = client.readStringUntil('\n');
-        line.trim();
-        if (line.length() == 0) break;
-    }
-
-    Serial.println("Reading JSON response...");
-
-    // Read JSON response with timeout
-    String response = "";
-    timeout = millis();
-    while (client.available() && (millis() - timeout < 3000)) {
-        char c = client.read();
-        if (c >= 32 && c <= 126) {
-            response += c;
-        }
-    }
-    client.stop();
-
-    Serial.println("Raw response length: " + String(response.length()));
-    if (response.length() > 0) {
-        Serial.println("Response preview: " + response.substring(0, min(200, (int)response.length())));
-    }
-
-    if (response.length() == 0) {
-        Serial.println("Empty response from Spotify");
-        return false;
-    }
-
-    // Parse response
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, response);
-
-    if (error) {
-        Serial.print("JSON parsing failed: ");
-        Serial.println(error.c_str());
-        return false;
-    }
-
-    if (doc["access_token"]) {
-        spotifyAccessToken = doc["access_token"].as<String>();
-        if (doc["refresh_token"]) {
-            spotifyRefreshToken = doc["refresh_token"].as<String>();
-        }
-        tokenExpiry = millis() + (doc["expires_in"].as<int>() * 1000);
-
-        Serial.println("Spotify tokens obtained successfully!");
-        Serial.println("Access token length: " + String(spotifyAccessToken.length()));
-
-        // Immediately try to fetch current track
-        currentSpotifyTrack.dataValid = false;
-        lastSpotifyUpdate = 0;
-        updateSpotifyData();
+// Runs once the exchange started below has brought tokens
+static void onSpotifyTokens() {
+    // Fetch the current track right away rather than at the next scheduled poll
+    currentSpotifyTrack.dataValid = false;
+    publishSpotifyData();
+    fetchSchedulerDueNow(WIDGET_SPOTIFY);
+}
 
-        return true;
-    } else {
-        Serial.println("No access_token in response");
-        if (doc["error"]) {
-            Serial.println("Error: " + doc["error"].as<String>());
-            if (doc["error_description"]) {
-                Serial.println("Description: " + doc["error_description"].as<String>());
-            }
-        }
-        return false;
-    }
-}
\ No newline at end of file
+bool exchangeCodeForTokens(String authCode) {
+    return exchangeAuthCode(TOKEN_SPOTIFY, authCode, onSpotifyTokens);
+}
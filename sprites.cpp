@@ -0,0 +1,89 @@
+#include "sprites.h"
+
+bool renderSprite(Sprite &sprite, int16_t width, int16_t height, SpritePainter paint, int x, int y) {
+  freeSprite(sprite);
+
+  sprite.canvas = new GFXcanvas16(width, height);
+  if (!sprite.canvas || !sprite.canvas->getBuffer()) {
+    Serial.println("Sprite canvas allocation failed");
+    freeSprite(sprite);
+    return false;
+  }
+  sprite.width = width;
+  sprite.height = height;
+
+  sprite.canvas->fillScreen(SPRITE_TRANSPARENT);
+  paint(*sprite.canvas, x, y);
+
+  // First pass counts the opaque runs, second pass records them
+  const uint16_t *pixels = sprite.canvas->getBuffer();
+  int runCount = 0;
+  for (int i = 0; i < width * height; i++) {
+    bool opaque = pixels[i] != SPRITE_TRANSPARENT;
+    bool runStart = (i % width == 0) || pixels[i - 1] == SPRITE_TRANSPARENT;
+    if (opaque && runStart) runCount++;
+  }
+
+  sprite.rowRuns = new uint16_t[height + 1];
+  sprite.runs = new SpriteRun[runCount > 0 ? runCount : 1];
+  if (!sprite.rowRuns || !sprite.runs) {
+    Serial.println("Sprite mask allocation failed");
+    freeSprite(sprite);
+    return false;
+  }
+
+  int run = 0;
+  for (int row = 0; row < height; row++) {
+    sprite.rowRuns[row] = run;
+    const uint16_t *line = pixels + row * width;
+    int col = 0;
+    while (col < width) {
+      if (line[col] == SPRITE_TRANSPARENT) {
+        col++;
+        continue;
+      }
+      int start = col;
+      while (col < width && line[col] != SPRITE_TRANSPARENT) col++;
+      sprite.runs[run].start = start;
+      sprite.runs[run].length = col - start;
+      run++;
+    }
+  }
+  sprite.rowRuns[height] = run;
+  return true;
+}
+
+void freeSprite(Sprite &sprite) {
+  delete sprite.canvas;
+  delete[] sprite.rowRuns;
+  delete[] sprite.runs;
+  sprite.canvas = NULL;
+  sprite.rowRuns = NULL;
+  sprite.runs = NULL;
+  sprite.width = 0;
+  sprite.height = 0;
+}
+
+// Copy the sprite's opaque runs into the matrix buffer, clipped to the panel
+void blitSprite(const Sprite &sprite, int x, int y) {
+  if (!sprite.canvas) return;
+
+  int firstRow = max(0, -y);
+  int lastRow = min((int)sprite.height, HEIGHT - y);
+  const uint16_t *pixels = sprite.canvas->getBuffer();
+  uint16_t *frame = matrix.getBuffer();
+
+  for (int row = firstRow; row < lastRow; row++) {
+    const uint16_t *src = pixels + row * sprite.width;
+    uint16_t *dst = frame + (y + row) * WIDTH;
+
+    for (int r = sprite.rowRuns[row]; r < sprite.rowRuns[row + 1]; r++) {
+      int start = x + sprite.runs[r].start;
+      int end = start + sprite.runs[r].length;
+      if (start < 0) start = 0;
+      if (end > WIDTH) end = WIDTH;
+      if (start >= end) continue;
+      memcpy(dst + start, src + (start - x), (end - start) * sizeof(uint16_t));
+    }
+  }
+}
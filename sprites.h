@@ -0,0 +1,35 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include "hardware_config.h"
+
+// Pre-rendered RGB565 sprites. Art is drawn once with the normal GFX calls into
+// an offscreen canvas; each frame is then a clipped copy into the matrix buffer.
+
+// Canvas background while painting - any pixel left at this color is transparent.
+// color565(0, 0, 8): never used by sprite art.
+#define SPRITE_TRANSPARENT 0x0001
+
+// One opaque span of a sprite row. The spans are the sprite's transparency mask.
+struct SpriteRun {
+  uint8_t start;
+  uint8_t length;
+};
+
+struct Sprite {
+  int16_t width;
+  int16_t height;
+  GFXcanvas16 *canvas;   // Pixel storage
+  uint16_t *rowRuns;     // First run of each row in runs[] (height + 1 entries)
+  SpriteRun *runs;
+};
+
+// Paints sprite art. (x, y) is added to every coordinate so art written in
+// panel coordinates can be shifted to the sprite's origin.
+typedef void (*SpritePainter)(Adafruit_GFX &gfx, int x, int y);
+
+bool renderSprite(Sprite &sprite, int16_t width, int16_t height, SpritePainter paint, int x, int y);
+void freeSprite(Sprite &sprite);
+void blitSprite(const Sprite &sprite, int x, int y);
+
+#endif
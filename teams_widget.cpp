@@ -3,6 +3,11 @@
 #include "matrix_display.h"
 #include "ms_graph_auth.h"
 #include <ArduinoJson.h>
+#include "profiler.h"
+#include "http_pool.h"
+#include "json_arena.h"
+#include "fetch_scheduler.h"
+#include "token_manager.h"
 
 // Teams presence status icons
 void drawPresenceIcon(int x, int y, uint16_t color) {
@@ -10,67 +15,45 @@ void drawPresenceIcon(int x, int y, uint16_t color) {
     matrix.fillCircle(x + 4, y + 4, 3, color);
 }
 
-// Function to fetch Teams presence data from Microsoft Graph API
-void updateTeamsData() {
-    // Check if we have a valid token or refresh if needed
-    if (!isMsGraphTokenValid()) {
-        if (!refreshMsGraphToken()) {
-            Serial.println("Failed to refresh MS Graph token, can't update Teams data");
-            return;
-        }
-    }
-
-    WiFiSSLClient client;
-
-    Serial.println("Fetching Teams presence data...");
-
-    if (!client.connect("graph.microsoft.com", 443)) {
+// Completes the presence request started by updateTeamsData()
+static void handleTeamsResponse(PooledConnection &connection) {
+    if (connection.status() == 0) {
         Serial.println("Connection to Microsoft Graph failed");
         return;
     }
-
-    // Send the HTTP request to fetch presence data
-    client.println("GET /v1.0/me/presence HTTP/1.1");
-    client.println("Host: graph.microsoft.com");
-    client.println("Authorization: Bearer " + msGraphAccessToken);
-    client.println("Connection: close");
-    client.println();
-
-    // Wait for the response
-    while (client.connected() && !client.available()) delay(10);
-
-    // Read and parse the response
-    String response = "";
-    while (client.available()) {
-        char c = client.read();
-        response += c;
-    }
-    client.stop();
-
-    // Extract the JSON part from the response
-    int jsonStart = response.indexOf("{");
-    if (jsonStart == -1) {
-        Serial.println("Invalid response format from Graph API");
+    if (connection.status() == 401) {
+        Serial.println("Microsoft Graph rejected the access token");
+        invalidateAccessToken(TOKEN_MS_GRAPH);     // Refresh before the next poll
         return;
     }
 
-    String jsonResponse = response.substring(jsonStart);
+    if (!parseTeamsPresence(connection.body())) connection.markFailed();
+}
+
+bool parseTeamsPresence(Stream &input) {
+    // Keep only the fields used below
+    JsonArena arena;
+    JsonDocument filter(&arena);
+    filter["availability"] = true;
+    filter["activity"] = true;
+    filter["error"]["message"] = true;
 
-    // Parse the JSON response
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, jsonResponse);
+    JsonDocument doc(&arena);
+    uint32_t parseStart = profileNow();
+    DeserializationError error = deserializeJson(doc, input, DeserializationOption::Filter(filter));
+    profileRecord(PROFILE_JSON_PARSE, profileNow() - parseStart);
 
     if (error) {
         Serial.print("JSON parsing failed: ");
         Serial.println(error.c_str());
-        return;
+        return false;
     }
 
     // Check if the response contains an error
     if (doc["error"].isNull() == false) {
         Serial.print("Graph API error: ");
         Serial.println(doc["error"]["message"].as<String>());
-        return;
+        return false;
     }
 
     // Extract presence information
@@ -83,14 +66,34 @@ void updateTeamsData() {
         currentTeams.details = activity;
         currentTeams.statusColor = getTeamsStatusColor(availability);
         currentTeams.lastUpdate = millis();
+        publishTeamsData();
+        fetchSchedulerFetched(WIDGET_TEAMS);
 
         Serial.print("Teams presence updated: ");
         Serial.print(availability);
         Serial.print(" - ");
         Serial.println(activity);
-    } else {
-        Serial.println("No presence data found in response");
+        return true;
     }
+    Serial.println("No presence data found in response");
+    return false;
+}
+
+// Function to fetch Teams presence data from Microsoft Graph API
+bool updateTeamsData() {
+    // Still waiting on the previous request
+    if (msGraphConnection.busy()) return false;
+
+    // The token manager keeps the token fresh; without one, skip this round
+    if (!tokenReady(TOKEN_MS_GRAPH)) {
+        Serial.println("No valid MS Graph token yet, can't update Teams data");
+        return false;
+    }
+
+    Serial.println("Fetching Teams presence data...");
+
+    // Kept-alive socket, so most polls skip the TLS handshake
+    return msGraphConnection.begin("/v1.0/me/presence", tokenAuthorization(TOKEN_MS_GRAPH), handleTeamsResponse);
 }
 
 // Enhanced status color mapping
@@ -112,28 +115,28 @@ uint16_t getTeamsStatusColor(String status) {
 
 // Enhanced Teams widget drawing
 void drawTeamsWidget(int x, int y, int width, int height) {
+    const TeamsData &teams = teamsSnapshot.read();
+
     // Background based on status color but dimmed
     uint16_t bgColor = matrix.color565(
-        ((currentTeams.statusColor >> 11) & 0x1F) >> 2, // Dimmed red
-        ((currentTeams.statusColor >> 5) & 0x3F) >> 2, // Dimmed green
-        (currentTeams.statusColor & 0x1F) >> 2         // Dimmed blue
+        ((teams.statusColor >> 11) & 0x1F) >> 2, // Dimmed red
+        ((teams.statusColor >> 5) & 0x3F) >> 2, // Dimmed green
+        (teams.statusColor & 0x1F) >> 2         // Dimmed blue
     );
 
     // Clear widget area
     matrix.fillRect(x, y, width, height, matrix.color565(0, 0, 0));
 
     // Draw presence icon
-    drawPresenceIcon(x + 2, y + 3, currentTeams.statusColor);
+    drawPresenceIcon(x + 2, y + 3, teams.statusColor);
 
     // Show status text
     matrix.setCursor(x + 10, y + 8);
-    matrix.setTextColor(currentTeams.statusColor);
+    matrix.setTextColor(teams.statusColor);
     matrix.setTextSize(1);
 
-    // Format status text for display
-    String displayText = currentTeams.status;
-    if (displayText.length() > 12) {
-        displayText = displayText.substring(0, 12);
-    }
+    // Format status text for display - at most 12 characters fit
+    char displayText[13];
+    snprintf(displayText, sizeof(displayText), "%s", teams.status.c_str());
     matrix.print(displayText);
 }
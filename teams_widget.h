@@ -12,7 +12,10 @@ uint16_t getTeamsStatusColor(String status);
 void drawPresenceIcon(int x, int y, uint16_t color);
 
 // Function to update Teams data from Microsoft Graph API
-void updateTeamsData();
+bool updateTeamsData();
+
+// Reads a presence response body into currentTeams; false if it had none
+bool parseTeamsPresence(Stream &input);
 
 // Function to draw the Teams widget
 void drawTeamsWidget(int x, int y, int width, int height);
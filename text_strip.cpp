@@ -0,0 +1,63 @@
+#include "text_strip.h"
+
+bool setTextStripText(TextStrip &strip, const String &text) {
+  if (strip.canvas && strip.text.length() == text.length() && strip.text == text) {
+    return false;
+  }
+
+  freeTextStrip(strip);
+  strip.text = text;
+
+  int chars = min((int)text.length(), TEXT_STRIP_MAX_CHARS);
+  if (chars == 0) {
+    return true; // Nothing to draw; width stays 0
+  }
+
+  strip.canvas = new GFXcanvas1(chars * 6, TEXT_STRIP_HEIGHT);
+  if (!strip.canvas || !strip.canvas->getBuffer()) {
+    Serial.println("Text strip allocation failed");
+    freeTextStrip(strip);
+    return false;
+  }
+
+  strip.canvas->fillScreen(0);
+  strip.canvas->setTextWrap(false);
+  strip.canvas->setTextSize(1);
+  strip.canvas->setTextColor(1);
+  strip.canvas->setCursor(0, 0);
+  strip.canvas->print(chars < (int)text.length() ? text.substring(0, chars) : text);
+  strip.width = chars * 6;
+  return true;
+}
+
+void freeTextStrip(TextStrip &strip) {
+  delete strip.canvas;
+  strip.canvas = NULL;
+  strip.width = 0;
+}
+
+void drawTextStrip(const TextStrip &strip, int x, int y, uint16_t color, int clipLeft, int clipRight) {
+  if (!strip.canvas) return;
+
+  // Visible window of the strip
+  int left = max(max(x, clipLeft), 0);
+  int right = min(min(x + (int)strip.width, clipRight), (int)WIDTH);
+  if (left >= right) return;
+
+  int firstRow = max(0, -y);
+  int lastRow = min(TEXT_STRIP_HEIGHT, HEIGHT - y);
+  int stride = (strip.width + 7) / 8;
+  const uint8_t *bits = strip.canvas->getBuffer();
+  uint16_t *frame = matrix.getBuffer();
+
+  for (int row = firstRow; row < lastRow; row++) {
+    const uint8_t *src = bits + row * stride;
+    uint16_t *dst = frame + (y + row) * WIDTH;
+    for (int px = left; px < right; px++) {
+      int sx = px - x;
+      if (src[sx >> 3] & (0x80 >> (sx & 7))) {
+        dst[px] = color;
+      }
+    }
+  }
+}
@@ -0,0 +1,28 @@
+#ifndef TEXT_STRIP_H
+#define TEXT_STRIP_H
+
+#include "hardware_config.h"
+
+// Pre-rasterized text. A string is printed once with the built-in 6x8 font into
+// a 1-bit strip; drawing copies only the columns that land on the panel, so the
+// per-frame cost does not depend on the length of the text.
+
+#define TEXT_STRIP_HEIGHT 8
+#define TEXT_STRIP_MAX_CHARS 512
+
+struct TextStrip {
+  GFXcanvas1 *canvas;
+  String text;     // Text the strip was rasterized from
+  int16_t width;   // Strip width in pixels (6 per character)
+};
+
+// Re-rasterizes only when the text differs from the cached strip. Returns true if it did.
+bool setTextStripText(TextStrip &strip, const String &text);
+void freeTextStrip(TextStrip &strip);
+
+// Draw the strip with its left edge at x, keeping pixels inside [clipLeft, clipRight).
+// The color is applied here, so changing it never invalidates the strip.
+void drawTextStrip(const TextStrip &strip, int x, int y, uint16_t color,
+                   int clipLeft = 0, int clipRight = WIDTH);
+
+#endif
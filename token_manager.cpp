@@ -0,0 +1,344 @@
+#include "token_manager.h"
+#include "credentials.h"
+#include <ArduinoJson.h>
+#include "http_pool.h"
+#include "json_arena.h"
+#include "profiler.h"
+
+#define TOKEN_REFRESH_AHEAD_MS 300000   // Renew this long before the access token runs out
+#define TOKEN_DEFAULT_LIFETIME_MS 3600000
+#define TOKEN_RETRY_MS 30000            // Wait after a failed refresh, doubled each time it fails again
+#define TOKEN_RETRY_MAX_MS 1800000
+
+struct OAuthClient {
+  const char *name;
+  const char *host;
+  const char *tokenPath;
+  const char *clientId;
+  const char *clientSecret;
+  const char *redirectUri;
+  const char *scope;          // Sent with every grant, or nullptr
+  bool basicAuth;             // Client credentials as HTTP Basic instead of form fields
+  PooledConnection *connection;
+};
+
+struct TokenState {
+  String accessToken;
+  String refreshToken;
+  uint32_t refreshTokenVersion;   // Bumped whenever refreshToken changes
+  String authorization;       // "Bearer " + accessToken
+  String basicHeader;         // "Basic " + base64(clientId:clientSecret), built on first use
+  uint32_t expiresAt;
+  uint32_t retryAt;           // No refresh before this while refreshFailures > 0
+  uint8_t refreshFailures;    // In a row, since the last token the provider issued
+  bool exchanging;            // The grant in flight trades a code rather than refreshes
+  TokenExchangeState exchange;
+  TokenCallback onTokens;
+};
+
+static const OAuthClient clients[TOKEN_PROVIDER_COUNT] = {
+  {"spotify", "accounts.spotify.com", "/api/token", spotifyClientId, spotifyClientSecret,
+   "https://spotify.com", nullptr, true, &spotifyAccountsConnection},
+  {"msgraph", "login.microsoftonline.com", "/common/oauth2/v2.0/token", msGraphClientId, msGraphClientSecret,
+   "https://login.microsoftonline.com/common/oauth2/nativeclient", "Presence.Read", false, &msLoginConnection},
+};
+
+static TokenState tokens[TOKEN_PROVIDER_COUNT];
+
+static void storeRefreshToken(TokenProvider provider, const String &refreshToken) {
+  tokens[provider].refreshToken = refreshToken;
+  tokens[provider].refreshTokenVersion++;
+}
+
+static const String noAuthorization;
+
+static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Appends data as padded base64, a whole group of four characters at a time
+static void appendBase64(String &out, const char *data, size_t length) {
+  out.reserve(out.length() + (length + 2) / 3 * 4);
+
+  char group[5] = {0};
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t bits = (uint8_t)data[i] << 16;
+    if (i + 1 < length) bits |= (uint8_t)data[i + 1] << 8;
+    if (i + 2 < length) bits |= (uint8_t)data[i + 2];
+
+    group[0] = base64Chars[(bits >> 18) & 0x3f];
+    group[1] = base64Chars[(bits >> 12) & 0x3f];
+    group[2] = i + 1 < length ? base64Chars[(bits >> 6) & 0x3f] : '=';
+    group[3] = i + 2 < length ? base64Chars[bits & 0x3f] : '=';
+    out += group;
+  }
+}
+
+static const char hexDigits[] = "0123456789ABCDEF";
+
+// Appends "name=value" (after a '&' unless it is the first field), with
+// everything in value but the unreserved characters percent-encoded: codes and
+// refresh tokens are opaque and may hold any of '+', '/', '=' or '%'
+static void appendFormField(String &form, const char *name, const char *value) {
+  size_t encodedLength = 0;
+  for (const char *c = value; *c; c++) {
+    encodedLength += isalnum((uint8_t)*c) || strchr("-._~", *c) ? 1 : 3;
+  }
+  form.reserve(form.length() + strlen(name) + encodedLength + 2);
+
+  if (form.length() > 0) form += '&';
+  form += name;
+  form += '=';
+  for (const char *c = value; *c; c++) {
+    if (isalnum((uint8_t)*c) || strchr("-._~", *c)) {
+      form += *c;
+    } else {
+      form += '%';
+      form += hexDigits[(uint8_t)*c >> 4];
+      form += hexDigits[(uint8_t)*c & 0x0f];
+    }
+  }
+}
+
+static const String &basicHeader(TokenProvider provider) {
+  TokenState &state = tokens[provider];
+  if (state.basicHeader.length() == 0) {
+    const OAuthClient &client = clients[provider];
+    String credentials = String(client.clientId) + ":" + client.clientSecret;
+    state.basicHeader = "Basic ";
+    appendBase64(state.basicHeader, credentials.c_str(), credentials.length());
+  }
+  return state.basicHeader;
+}
+
+static void storeAccessToken(TokenProvider provider, const String &accessToken, uint32_t expiresInMs) {
+  TokenState &state = tokens[provider];
+  state.accessToken = accessToken;
+  state.authorization = "Bearer " + accessToken;
+  state.expiresAt = millis() + expiresInMs;
+}
+
+// Reads the tokens out of a token endpoint response and stores them. error
+// receives the OAuth error code of a rejected grant.
+static bool storeTokenResponse(TokenProvider provider, PooledConnection &connection, String &error) {
+  const OAuthClient &oauth = clients[provider];
+  if (connection.status() == 0) return false;     // The pool has said why
+
+  JsonArena arena;
+  JsonDocument filter(&arena);
+  filter["access_token"] = true;
+  filter["refresh_token"] = true;
+  filter["expires_in"] = true;
+  filter["error"] = true;
+  filter["error_description"] = true;
+
+  JsonDocument doc(&arena);
+  uint32_t parseStart = profileNow();
+  DeserializationError parseError = deserializeJson(doc, connection.body(), DeserializationOption::Filter(filter));
+  profileRecord(PROFILE_JSON_PARSE, profileNow() - parseStart);
+
+  if (parseError) {
+    Serial.print(oauth.host);
+    Serial.print(": token response JSON error ");
+    Serial.print(parseError.c_str());
+    Serial.print(", status ");
+    Serial.println(connection.status());
+    return false;
+  }
+
+  if (doc["access_token"].isNull()) {
+    error = doc["error"].as<String>();
+    Serial.print(oauth.name);
+    Serial.print(" token error: ");
+    Serial.print(error);
+    Serial.print(" ");
+    Serial.println(doc["error_description"].as<String>());
+    return false;
+  }
+
+  uint32_t expiresInMs = doc["expires_in"].isNull() ? TOKEN_DEFAULT_LIFETIME_MS : doc["expires_in"].as<uint32_t>() * 1000;
+  storeAccessToken(provider, doc["access_token"].as<String>(), expiresInMs);
+  if (!doc["refresh_token"].isNull()) {
+    storeRefreshToken(provider, doc["refresh_token"].as<String>());   // Microsoft rotates them
+  }
+  return true;
+}
+
+// Completes the grant started by requestTokens(). Each provider has its own
+// connection, which says whose response this is.
+static void handleTokenResponse(PooledConnection &connection) {
+  int provider = 0;
+  while (clients[provider].connection != &connection) provider++;
+  const OAuthClient &oauth = clients[provider];
+  TokenState &state = tokens[provider];
+
+  String error;
+  bool stored = storeTokenResponse((TokenProvider)provider, connection, error);
+  if (stored) {
+    state.refreshFailures = 0;
+  } else if (connection.status() > 0) {
+    connection.markFailed();          // Answered, but without tokens
+  }
+
+  if (state.exchanging) {
+    state.exchanging = false;
+    state.exchange = stored ? TOKEN_EXCHANGE_OK : TOKEN_EXCHANGE_FAILED;
+    if (!stored) return;
+    Serial.print(oauth.name);
+    Serial.println(" tokens obtained");
+    if (state.onTokens) state.onTokens();
+    return;
+  }
+
+  if (stored) {
+    Serial.print(oauth.name);
+    Serial.println(" token refreshed");
+    return;
+  }
+
+  // Whatever went wrong (a bad client secret, a response that didn't parse, no
+  // answer at all), the same grant would fail the same way on the next tick
+  uint32_t retryMs = min((uint32_t)TOKEN_RETRY_MS << min(state.refreshFailures, (uint8_t)6), (uint32_t)TOKEN_RETRY_MAX_MS);
+  if (state.refreshFailures < 255) state.refreshFailures++;
+  state.retryAt = millis() + retryMs;
+  Serial.print(oauth.name);
+  Serial.print(" refresh failed, next try in ");
+  Serial.print((unsigned long)(retryMs / 1000));
+  Serial.println(" s");
+
+  if (error == "invalid_grant") {
+    // Revoked or expired for good: only a new consent helps
+    Serial.print(oauth.name);
+    Serial.println(" refresh token rejected, authorize again");
+    state.accessToken = "";
+    state.authorization = "";
+    storeRefreshToken((TokenProvider)provider, "");
+  }
+}
+
+// Queues one grant to the provider's token endpoint. The response is handled
+// by handleTokenResponse().
+static bool requestTokens(TokenProvider provider, const char *grantType, const char *grantField, const String &grantValue) {
+  const OAuthClient &oauth = clients[provider];
+
+  String form;
+  appendFormField(form, "grant_type", grantType);
+  appendFormField(form, grantField, grantValue.c_str());
+  if (strcmp(grantType, "authorization_code") == 0) {
+    appendFormField(form, "redirect_uri", oauth.redirectUri);
+  }
+  if (oauth.scope) {
+    appendFormField(form, "scope", oauth.scope);
+  }
+  if (!oauth.basicAuth) {
+    appendFormField(form, "client_id", oauth.clientId);
+    appendFormField(form, "client_secret", oauth.clientSecret);
+  }
+
+  return oauth.connection->post(oauth.tokenPath, oauth.basicAuth ? basicHeader(provider) : noAuthorization,
+                                form, handleTokenResponse);
+}
+
+// False while the host is backing off or a grant to it is already in flight
+static bool refreshTokens(TokenProvider provider) {
+  if (!requestTokens(provider, "refresh_token", "refresh_token", tokens[provider].refreshToken)) return false;
+
+  Serial.print("Refreshing ");
+  Serial.print(clients[provider].name);
+  Serial.println(" token...");
+  return true;
+}
+
+bool tokenConfigured(TokenProvider provider) {
+  const TokenState &state = tokens[provider];
+  return state.accessToken.length() > 0 || state.refreshToken.length() > 0;
+}
+
+bool tokenReady(TokenProvider provider) {
+  const TokenState &state = tokens[provider];
+  return state.accessToken.length() > 0 && (int32_t)(state.expiresAt - millis()) > 0;
+}
+
+const String &tokenAuthorization(TokenProvider provider) {
+  return tokens[provider].authorization;
+}
+
+void setTokens(TokenProvider provider, const String &accessToken, const String &refreshToken, uint32_t expiresInMs) {
+  storeAccessToken(provider, accessToken, expiresInMs);
+  storeRefreshToken(provider, refreshToken);
+  tokens[provider].refreshFailures = 0;
+  Serial.print(clients[provider].name);
+  Serial.println(" tokens set manually");
+}
+
+bool exchangeAuthCode(TokenProvider provider, const String &code, TokenCallback onTokens) {
+  TokenState &state = tokens[provider];
+
+  Serial.print("Exchanging ");
+  Serial.print(clients[provider].name);
+  Serial.println(" authorization code...");
+
+  if (!requestTokens(provider, "authorization_code", "code", code)) {
+    Serial.print(clients[provider].host);
+    Serial.println(": busy or backing off, code not sent");
+    return false;
+  }
+  state.exchanging = true;
+  state.exchange = TOKEN_EXCHANGE_PENDING;
+  state.onTokens = onTokens;
+  return true;
+}
+
+TokenExchangeState tokenExchangeState(TokenProvider provider) {
+  return tokens[provider].exchange;
+}
+
+bool findTokenProvider(const char *name, TokenProvider &provider) {
+  for (int i = 0; i < TOKEN_PROVIDER_COUNT; i++) {
+    if (strcmp(clients[i].name, name) == 0) {
+      provider = (TokenProvider)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+const String &refreshTokenValue(TokenProvider provider) {
+  return tokens[provider].refreshToken;
+}
+
+uint32_t refreshTokenVersion(TokenProvider provider) {
+  return tokens[provider].refreshTokenVersion;
+}
+
+void restoreRefreshToken(TokenProvider provider, const String &refreshToken) {
+  storeRefreshToken(provider, refreshToken);
+  tokens[provider].refreshFailures = 0;
+}
+
+void invalidateAccessToken(TokenProvider provider) {
+  tokens[provider].expiresAt = millis();
+}
+
+void runTokenRefresh() {
+  uint32_t now = millis();
+  for (int i = 0; i < TOKEN_PROVIDER_COUNT; i++) {
+    const TokenState &state = tokens[i];
+    if (state.refreshToken.length() == 0) continue;
+    if (state.accessToken.length() > 0 && (int32_t)(state.expiresAt - now) > TOKEN_REFRESH_AHEAD_MS) continue;
+    if (state.refreshFailures > 0 && (int32_t)(state.retryAt - now) > 0) continue;
+    if (refreshTokens((TokenProvider)i)) return;
+  }
+}
+
+void printTokenStatus(Print &out) {
+  out.println("# token provider configured expires_in_ms");
+  for (int i = 0; i < TOKEN_PROVIDER_COUNT; i++) {
+    out.print("token ");
+    out.print(clients[i].name);
+    out.print(tokenConfigured((TokenProvider)i) ? " 1 " : " 0 ");
+    if (tokens[i].accessToken.length() > 0) {
+      out.println((long)(int32_t)(tokens[i].expiresAt - millis()));
+    } else {
+      out.println("-");
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef TOKEN_MANAGER_H
+#define TOKEN_MANAGER_H
+
+#include <Arduino.h>
+
+// OAuth tokens for every API that needs one. Each provider's token endpoint,
+// client credentials and grant details live in one table, so code exchange and
+// refresh are the same code for all of them. The Bearer header is rebuilt
+// only when the access token changes, and the Basic header for client
+// credentials is built once. runTokenRefresh() renews tokens from the network
+// task before they expire, so a data poll never waits on a refresh: it either
+// has a usable token or skips that round.
+//
+// Grants go out as form POSTs on each provider's pooled connection and are
+// answered through the same poll as the widgets' requests, so nothing here
+// waits on the network.
+
+enum TokenProvider {
+  TOKEN_SPOTIFY = 0,
+  TOKEN_MS_GRAPH,
+  TOKEN_PROVIDER_COUNT
+};
+
+// Outcome of the last authorization code exchange, for the page that started it
+enum TokenExchangeState {
+  TOKEN_EXCHANGE_IDLE = 0,      // None since boot
+  TOKEN_EXCHANGE_PENDING,
+  TOKEN_EXCHANGE_OK,
+  TOKEN_EXCHANGE_FAILED
+};
+
+typedef void (*TokenCallback)();
+
+// Has a refresh or access token, i.e. the user authorized it at some point
+bool tokenConfigured(TokenProvider provider);
+
+// Has an access token that hasn't expired
+bool tokenReady(TokenProvider provider);
+
+// "Bearer <access token>", ready to send as the Authorization header
+const String &tokenAuthorization(TokenProvider provider);
+
+void setTokens(TokenProvider provider, const String &accessToken, const String &refreshToken, uint32_t expiresInMs);
+
+// Start trading an authorization code from the consent page for tokens.
+// Returns false when it can't be sent now (a grant to the provider already in
+// flight, or the host backing off). Otherwise tokenExchangeState() reads
+// pending until the response is in, and onTokens (or nullptr) runs on the
+// network task once the provider has an access token.
+bool exchangeAuthCode(TokenProvider provider, const String &code, TokenCallback onTokens);
+TokenExchangeState tokenExchangeState(TokenProvider provider);
+
+// "spotify" or "msgraph"; false for any other name
+bool findTokenProvider(const char *name, TokenProvider &provider);
+
+// Refresh token as last issued, empty when the provider isn't authorized
+const String &refreshTokenValue(TokenProvider provider);
+
+// Changes whenever the refresh token does, so callers can skip re-reading it
+uint32_t refreshTokenVersion(TokenProvider provider);
+
+// Start from a refresh token saved before a reboot; the access token follows
+// on the next runTokenRefresh()
+void restoreRefreshToken(TokenProvider provider, const String &refreshToken);
+
+// The API rejected the access token: refresh it before the next request
+void invalidateAccessToken(TokenProvider provider);
+
+// Call from the network task; starts at most one refresh per call
+void runTokenRefresh();
+
+// One line per provider: whether it is authorized and ms until the access token expires
+void printTokenStatus(Print &out);
+
+#endif
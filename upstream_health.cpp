@@ -0,0 +1,90 @@
+#include "upstream_health.h"
+
+#define BACKOFF_BASE_MS 5000
+#define BACKOFF_MAX_MS 600000
+
+UpstreamHealth weatherApiHealth("api.weatherapi.com");
+UpstreamHealth spotifyApiHealth("api.spotify.com");
+UpstreamHealth msGraphHealth("graph.microsoft.com");
+UpstreamHealth spotifyAccountsHealth("accounts.spotify.com");
+UpstreamHealth msLoginHealth("login.microsoftonline.com");
+
+static UpstreamHealth *upstreams[] = {
+  &weatherApiHealth,
+  &spotifyApiHealth,
+  &msGraphHealth,
+  &spotifyAccountsHealth,
+  &msLoginHealth,
+};
+
+static const char *breakerNames[] = { "closed", "open", "half-open" };
+
+bool UpstreamHealth::allowRequest() {
+  if (msUntilNextAttempt() > 0) return false;
+
+  if (breaker == BREAKER_OPEN) {
+    breaker = BREAKER_HALF_OPEN;
+    Serial.print(upstreamName);
+    Serial.println(": circuit half-open, probing");
+  }
+  return true;
+}
+
+void UpstreamHealth::recordSuccess(int status) {
+  if (breaker != BREAKER_CLOSED) {
+    Serial.print(upstreamName);
+    Serial.println(": circuit closed");
+  }
+  breaker = BREAKER_CLOSED;
+  failures = 0;
+  lastStatus = status;
+  nextAttempt = millis();
+}
+
+void UpstreamHealth::recordFailure(int status, uint32_t retryAfterMs) {
+  if (failures < 255) failures++;
+  lastStatus = status;
+
+  // 5 s, 10 s, 20 s ... up to 10 min, then anywhere in the upper half of that
+  uint32_t backoff = BACKOFF_MAX_MS;
+  if (failures <= 8) backoff = min((uint32_t)BACKOFF_BASE_MS << (failures - 1), (uint32_t)BACKOFF_MAX_MS);
+  backoff = backoff / 2 + random(backoff / 2 + 1);
+  if (retryAfterMs > backoff) backoff = retryAfterMs;
+  nextAttempt = millis() + backoff;
+
+  if (breaker == BREAKER_HALF_OPEN || failures >= BREAKER_THRESHOLD) {
+    if (breaker != BREAKER_OPEN) {
+      Serial.print(upstreamName);
+      Serial.println(": circuit open");
+    }
+    breaker = BREAKER_OPEN;
+  }
+
+  Serial.print(upstreamName);
+  Serial.print(": failure ");
+  Serial.print(failures);
+  Serial.print(", next attempt in ");
+  Serial.print((unsigned long)(backoff / 1000));
+  Serial.println(" s");
+}
+
+int32_t UpstreamHealth::msUntilNextAttempt() const {
+  int32_t wait = (int32_t)(nextAttempt - millis());
+  return wait > 0 ? wait : 0;
+}
+
+void printUpstreamHealth(Print &out) {
+  out.println("# upstream state failures next_attempt_ms last_status");
+  for (const UpstreamHealth *upstream : upstreams) {
+    out.print("upstream ");
+    out.print(upstream->upstreamName);
+    out.print(' ');
+    out.print(breakerNames[upstream->breaker]);
+    out.print(' ');
+    out.print(upstream->failures);
+    out.print(' ');
+    out.print((long)upstream->msUntilNextAttempt());
+    out.print(' ');
+    out.println(upstream->lastStatus);
+  }
+}
@@ -0,0 +1,58 @@
+#ifndef UPSTREAM_HEALTH_H
+#define UPSTREAM_HEALTH_H
+
+#include <Arduino.h>
+
+// Failure tracking for one upstream API. Consecutive failures back off
+// exponentially with jitter (or as long as a Retry-After asks, if longer), and
+// after BREAKER_THRESHOLD of them the circuit opens: no requests at all until
+// the backoff runs out, then a single half-open probe decides whether it
+// closes again or reopens with a longer wait. While an upstream is backing
+// off, requests to it are refused up front, so a dead service costs no radio
+// time and doesn't hold up the network task.
+
+#define BREAKER_THRESHOLD 5
+
+enum BreakerState {
+  BREAKER_CLOSED,
+  BREAKER_OPEN,
+  BREAKER_HALF_OPEN
+};
+
+class UpstreamHealth {
+public:
+  explicit UpstreamHealth(const char *name) : upstreamName(name) {}
+
+  // True if a request may go out now. In the open state the first call after
+  // the backoff turns it half-open, and that request is the probe.
+  bool allowRequest();
+
+  // status is the HTTP status, or 0 when there was no usable response
+  void recordSuccess(int status);
+  void recordFailure(int status, uint32_t retryAfterMs = 0);
+
+  const char *name() const { return upstreamName; }
+  BreakerState state() const { return breaker; }
+  uint8_t failureCount() const { return failures; }
+  int32_t msUntilNextAttempt() const;
+
+private:
+  const char *upstreamName;
+  BreakerState breaker = BREAKER_CLOSED;
+  uint8_t failures = 0;
+  int lastStatus = 0;
+  uint32_t nextAttempt = 0;
+
+  friend void printUpstreamHealth(Print &out);
+};
+
+extern UpstreamHealth weatherApiHealth;
+extern UpstreamHealth spotifyApiHealth;
+extern UpstreamHealth msGraphHealth;
+extern UpstreamHealth spotifyAccountsHealth;
+extern UpstreamHealth msLoginHealth;
+
+// One line per upstream: breaker state, consecutive failures, wait left, last status
+void printUpstreamHealth(Print &out);
+
+#endif
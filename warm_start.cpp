@@ -0,0 +1,299 @@
+#include "warm_start.h"
+#include "flash_store.h"
+#include "widgets.h"
+#include "matrix_display.h"
+#include "token_manager.h"
+#include "teams_widget.h"
+
+#define WARM_START_VERSION 1
+
+// Flash write hold per kind of value: settings follow a click within seconds,
+// fetched data is rewritten at most every few minutes however often it changes
+#define SETTINGS_HOLD_MS 5000
+#define TOKEN_HOLD_MS 1000
+#define DATA_HOLD_MS 300000
+
+enum WarmStartKey : uint8_t {
+  KEY_SETTINGS = 1,
+  KEY_WEATHER,
+  KEY_TEAMS,
+  KEY_SPOTIFY_TRACK,
+  KEY_SPOTIFY_REFRESH_TOKEN,
+  KEY_MS_GRAPH_REFRESH_TOKEN
+};
+
+// Serialized values: a version byte, then fields in a fixed order, strings
+// prefixed with their length
+class ValueWriter {
+public:
+  ValueWriter(uint8_t *buffer, size_t size) : buffer(buffer), size(size) {}
+
+  void u8(uint8_t value) { bytes(&value, 1); }
+  void u16(uint16_t value) { u8(value); u8(value >> 8); }
+  void i32(int32_t value) { u16(value); u16((uint32_t)value >> 16); }
+  void str(const String &value) {
+    u16(value.length());
+    bytes((const uint8_t *)value.c_str(), value.length());
+  }
+
+  bool ok() const { return !overflow; }
+  size_t length() const { return position; }
+
+private:
+  void bytes(const uint8_t *data, size_t length) {
+    if (position + length > size) {
+      overflow = true;
+      return;
+    }
+    memcpy(buffer + position, data, length);
+    position += length;
+  }
+
+  uint8_t *buffer;
+  size_t size;
+  size_t position = 0;
+  bool overflow = false;
+};
+
+class ValueReader {
+public:
+  ValueReader(const uint8_t *buffer, size_t length) : buffer(buffer), length(length) {}
+
+  uint8_t u8() { return position < length ? buffer[position++] : (overflow = true, 0); }
+  uint16_t u16() { uint16_t low = u8(); return low | (u8() << 8); }
+  int32_t i32() { uint32_t low = u16(); return (int32_t)(low | ((uint32_t)u16() << 16)); }
+  String str() {
+    uint16_t count = u16();
+    if (position + count > length) {
+      overflow = true;
+      return String();
+    }
+    String value;
+    value.reserve(count);
+    for (uint16_t i = 0; i < count; i++) value += (char)buffer[position++];
+    return value;
+  }
+
+  bool ok() const { return !overflow; }
+
+private:
+  const uint8_t *buffer;
+  size_t length;
+  size_t position = 0;
+  bool overflow = false;
+};
+
+static uint8_t valueBuffer[STORE_VALUE_MAX];
+
+// Reads a stored value; the reader fails ok() if it's missing or from another version
+static ValueReader load(uint8_t key) {
+  int length = storeGet(key, valueBuffer, sizeof(valueBuffer));
+  if (length <= 0 || valueBuffer[0] != WARM_START_VERSION) length = 0;
+
+  ValueReader reader(valueBuffer, length);
+  reader.u8();
+  return reader;
+}
+
+static void save(uint8_t key, const ValueWriter &writer, uint32_t holdMs) {
+  if (writer.ok()) storeSet(key, valueBuffer, writer.length(), holdMs);
+}
+
+static void saveToken(uint8_t key, TokenProvider provider) {
+  const String &token = refreshTokenValue(provider);
+  storeSet(key, (const uint8_t *)token.c_str(), token.length(), TOKEN_HOLD_MS);
+}
+
+static void restoreToken(uint8_t key, TokenProvider provider) {
+  int length = storeGet(key, valueBuffer, sizeof(valueBuffer));
+  if (length <= 0) return;
+
+  String token;
+  token.reserve(length);
+  for (int i = 0; i < length; i++) token += (char)valueBuffer[i];
+  restoreRefreshToken(provider, token);
+}
+
+static void restoreSettings() {
+  ValueReader reader = load(KEY_SETTINGS);
+  uint8_t widget = reader.u8();
+  uint8_t animation = reader.u8();
+  uint16_t color = reader.u16();
+  String text = reader.str();
+  if (!reader.ok()) return;
+
+  if (widget <= WIDGET_TEMPERATURE) setWidget((WidgetType)widget);
+
+  displayText = text;
+  currentColor = color;
+  switch (animation) {
+    case ANIMATION_NONE: clearAnimationZone(); break;
+    case ANIMATION_SOLID_COLOR:
+      currentAnimation = ANIMATION_SOLID_COLOR;
+      invalidateAnimationZone();
+      break;
+    case ANIMATION_PATTERN: setAnimationPattern(); break;
+    case ANIMATION_SCROLLING_TEXT: setAnimationText(text); break;
+    case ANIMATION_TRUCK: setTruckAnimation(); break;
+    case ANIMATION_PIXELS: setPixelAnimation(); break;
+  }
+}
+
+// Restored data has no age: lastUpdate stays 0, so the first fetch replaces it
+static void restoreWeather() {
+  ValueReader reader = load(KEY_WEATHER);
+  WeatherData weather = currentWeather;
+  weather.location = reader.str();
+  weather.region = reader.str();
+  weather.country = reader.str();
+  weather.temperature = reader.i32();
+  weather.isDay = reader.u8();
+  weather.condition = reader.str();
+  weather.icon = reader.str();
+  weather.humidity = reader.i32();
+  weather.windSpeed = reader.i32();
+  weather.windDirection = reader.str();
+  weather.conditionCode = reader.i32();
+  if (!reader.ok()) return;
+
+  weather.lastUpdate = 0;
+  weather.dataValid = true;
+  classifyWeather(weather);
+  currentWeather = weather;
+  publishWeatherData();
+}
+
+static void restoreTeams() {
+  ValueReader reader = load(KEY_TEAMS);
+  String status = reader.str();
+  String details = reader.str();
+  if (!reader.ok()) return;
+
+  currentTeams.status = status;
+  currentTeams.details = details;
+  currentTeams.statusColor = getTeamsStatusColor(status);
+  publishTeamsData();
+}
+
+// Shown paused: there's no telling how far the track got while the power was out
+static void restoreSpotifyTrack() {
+  ValueReader reader = load(KEY_SPOTIFY_TRACK);
+  SpotifyTrackData track = currentSpotifyTrack;
+  track.trackName = reader.str();
+  track.artistName = reader.str();
+  track.albumName = reader.str();
+  track.durationMs = reader.i32();
+  track.progressMs = reader.i32();
+  track.deviceName = reader.str();
+  if (!reader.ok()) return;
+
+  track.progressAnchor = millis();
+  track.isPlaying = false;
+  track.dataValid = true;
+  track.lastUpdate = 0;
+  currentSpotifyTrack = track;
+  publishSpotifyData();
+}
+
+void restoreWarmStart() {
+  if (!initializeFlashStore()) return;
+
+  restoreSettings();
+  restoreWeather();
+  restoreTeams();
+  restoreSpotifyTrack();
+  restoreToken(KEY_SPOTIFY_REFRESH_TOKEN, TOKEN_SPOTIFY);
+  restoreToken(KEY_MS_GRAPH_REFRESH_TOKEN, TOKEN_MS_GRAPH);
+}
+
+// What the last saveWarmStart() serialized; a value is only rebuilt once its
+// source has changed since
+static struct {
+  WidgetType widget;
+  AnimationType animation;
+  uint16_t color;
+  String text;
+  bool settings;
+  uint32_t weather;
+  uint32_t teams;
+  uint32_t spotify;
+  uint32_t tokens[TOKEN_PROVIDER_COUNT];
+} saved;
+
+static bool settingsChanged() {
+  if (saved.settings && saved.widget == currentWidget && saved.animation == currentAnimation &&
+      saved.color == currentColor && saved.text == displayText) {
+    return false;
+  }
+  saved.settings = true;
+  saved.widget = currentWidget;
+  saved.animation = currentAnimation;
+  saved.color = currentColor;
+  saved.text = displayText;
+  return true;
+}
+
+static bool versionChanged(uint32_t &savedVersion, uint32_t version) {
+  if (savedVersion == version) return false;
+  savedVersion = version;
+  return true;
+}
+
+void saveWarmStart() {
+  if (settingsChanged()) {
+    ValueWriter writer(valueBuffer, sizeof(valueBuffer));
+    writer.u8(WARM_START_VERSION);
+    writer.u8(currentWidget);
+    writer.u8(currentAnimation);
+    writer.u16(currentColor);
+    writer.str(displayText);
+    save(KEY_SETTINGS, writer, SETTINGS_HOLD_MS);
+  }
+
+  if (versionChanged(saved.weather, weatherSnapshot.version()) && currentWeather.dataValid) {
+    ValueWriter writer(valueBuffer, sizeof(valueBuffer));
+    writer.u8(WARM_START_VERSION);
+    writer.str(currentWeather.location);
+    writer.str(currentWeather.region);
+    writer.str(currentWeather.country);
+    writer.i32(currentWeather.temperature);
+    writer.u8(currentWeather.isDay);
+    writer.str(currentWeather.condition);
+    writer.str(currentWeather.icon);
+    writer.i32(currentWeather.humidity);
+    writer.i32(currentWeather.windSpeed);
+    writer.str(currentWeather.windDirection);
+    writer.i32(currentWeather.conditionCode);
+    save(KEY_WEATHER, writer, DATA_HOLD_MS);
+  }
+
+  // Only once presence has actually been fetched, not the built-in default
+  if (versionChanged(saved.teams, teamsSnapshot.version()) && currentTeams.lastUpdate != 0) {
+    ValueWriter writer(valueBuffer, sizeof(valueBuffer));
+    writer.u8(WARM_START_VERSION);
+    writer.str(currentTeams.status);
+    writer.str(currentTeams.details);
+    save(KEY_TEAMS, writer, DATA_HOLD_MS);
+  }
+
+  if (versionChanged(saved.spotify, spotifySnapshot.version()) && currentSpotifyTrack.dataValid) {
+    ValueWriter writer(valueBuffer, sizeof(valueBuffer));
+    writer.u8(WARM_START_VERSION);
+    writer.str(currentSpotifyTrack.trackName);
+    writer.str(currentSpotifyTrack.artistName);
+    writer.str(currentSpotifyTrack.albumName);
+    writer.i32(currentSpotifyTrack.durationMs);
+    writer.i32(currentSpotifyTrack.progressMs);
+    writer.str(currentSpotifyTrack.deviceName);
+    save(KEY_SPOTIFY_TRACK, writer, DATA_HOLD_MS);
+  }
+
+  if (versionChanged(saved.tokens[TOKEN_SPOTIFY], refreshTokenVersion(TOKEN_SPOTIFY))) {
+    saveToken(KEY_SPOTIFY_REFRESH_TOKEN, TOKEN_SPOTIFY);
+  }
+  if (versionChanged(saved.tokens[TOKEN_MS_GRAPH], refreshTokenVersion(TOKEN_MS_GRAPH))) {
+    saveToken(KEY_MS_GRAPH_REFRESH_TOKEN, TOKEN_MS_GRAPH);
+  }
+
+  flushFlashStore();
+}
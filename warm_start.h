@@ -0,0 +1,19 @@
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <Arduino.h>
+
+// What the device should come back up with after a reboot or power blip: the
+// selected widget and animation, the last good weather, Teams and Spotify
+// data, and the OAuth refresh tokens, kept in the QSPI flash store. Restored
+// data is shown until the first fetch replaces it.
+
+// Call from setup() after initializeWidgets(), before the tasks start
+void restoreWarmStart();
+
+// Call from the network task every tick. Only values whose source changed
+// since the last call are serialized, and frequently changing data reaches
+// the flash at most once per hold period
+void saveWarmStart();
+
+#endif
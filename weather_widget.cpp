@@ -4,6 +4,12 @@
 #include "wifi_manager.h"
 #include <ArduinoJson.h>
 #include "hardware_config.h"
+#include "matrix_display.h"
+#include "text_strip.h"
+#include "profiler.h"
+#include "json_arena.h"
+#include "http_pool.h"
+#include "fetch_scheduler.h"
 
 // Animation state variables
 static uint32_t lastWeatherAnimation = 0;
@@ -11,6 +17,10 @@ static int cloudOffset = 0;
 static int rainOffset = 0;
 static int sunRayFrame = 0;
 
+// Location text, rasterized when the location changes
+static TextStrip locationStrip;
+static String locationStripSource;
+
 
 /*
  * For DEBUG mode - to view on the display the various weather conditions
@@ -57,6 +67,7 @@ void setWeatherDebugMode(bool enabled) {
     weatherDebugMode = enabled;
     debugConditionIndex = 0;
     lastDebugSwitch = millis();
+    invalidateWidgetZone();
 
     if (enabled) {
         Serial.println("=== Weather Debug Mode ENABLED ===");
@@ -68,12 +79,17 @@ void setWeatherDebugMode(bool enabled) {
     }
 }
 
+bool isWeatherDebugMode() {
+    return weatherDebugMode;
+}
+
 // Function to manually advance to next debug condition
 void advanceDebugWeather() {
     if (!weatherDebugMode) return;
 
     debugConditionIndex = (debugConditionIndex + 1) % numDebugConditions;
     lastDebugSwitch = millis();
+    invalidateWidgetZone();
 
     Serial.print("Debug weather: ");
     Serial.print(debugConditions[debugConditionIndex].description);
@@ -84,24 +100,57 @@ void advanceDebugWeather() {
     Serial.println(")");
 }
 
-// Core weather widget drawing (separated for debug use)
-void drawWeatherWidgetCore(int x, int y, int width, int height) {
+// Jump straight to one debug condition (restarts the 5 second auto-advance)
+void selectDebugWeather(int index) {
+    if (index < 0 || index >= numDebugConditions) return;
+
+    debugConditionIndex = index;
+    lastDebugSwitch = millis();
+    invalidateWidgetZone();
+}
+
+int getDebugWeatherCount() {
+    return numDebugConditions;
+}
+
+String getDebugWeatherDescription(int index) {
+    if (index < 0 || index >= numDebugConditions) return "";
+    return debugConditions[index].description;
+}
+
+// Advance weather animation and debug cycling; true when the widget needs a redraw
+bool tickWeatherWidget() {
+    // Auto-advance every 5 seconds in debug mode
+    if (weatherDebugMode && millis() - lastDebugSwitch > 5000) {
+        advanceDebugWeather();
+    }
+
+    // Nothing animates on the loading screen
+    if (!weatherDebugMode && !weatherSnapshot.read().dataValid) {
+        return false;
+    }
+
     // Update animation frame every 500ms
     if (millis() - lastWeatherAnimation > 500) {
-        cloudOffset = (cloudOffset + 1) % width;
+        cloudOffset = (cloudOffset + 1) % WIDTH;
         rainOffset = (rainOffset + 1) % 4;
         sunRayFrame = (sunRayFrame + 1) % 8;
         lastWeatherAnimation = millis();
+        return true;
     }
+    return false;
+}
 
+// Core weather widget drawing (separated for debug use)
+void drawWeatherWidgetCore(const WeatherData &weather, int x, int y, int width, int height) {
     // Draw background based on day/night
-    drawWeatherBackground(x, y, width, height);
+    drawWeatherBackground(weather, x, y, width, height);
 
     // Draw weather elements based on condition
-    drawWeatherElements(x, y, width, height);
+    drawWeatherElements(weather, x, y, width, height);
 
     // Draw text overlay (temperature and location)
-    drawWeatherText(x, y, width, height);
+    drawWeatherText(weather, x, y, width, height);
 }
 
 // Function to get current debug status info
@@ -118,75 +167,30 @@ String getDebugWeatherInfo() {
 // END OF DEBUG WEATHER CODE
 
 // Forward declarations for functions used within this file
-bool parseWeatherJSON(String jsonString);
+bool parseWeatherJSON(Stream &input);
 
 void drawWeatherIcon(int x, int y, String condition);
 
 
-// Function to make HTTP request to WeatherAPI
-bool fetchWeatherData() {
-    WiFiClient client;
-
-    Serial.println("Fetching weather data...");
-
-    if (!client.connect("api.weatherapi.com", 80)) {
-        Serial.println("Connection to WeatherAPI failed");
-        return false;
-    }
+// Completes the WeatherAPI request started by updateWeatherData()
+static void handleWeatherResponse(PooledConnection &connection) {
+    bool success = connection.status() == 200 && parseWeatherJSON(connection.body());
 
-    // Build request URL for IP-based location detection
-    String url = "/v1/current.json?key=" + String(weatherApiKey) + "&q=auto:ip&aqi=no";
-
-    // Send HTTP/1.0 request to avoid chunked encoding
-    client.print("GET " + url + " HTTP/1.0\r\n");
-    client.print("Host: api.weatherapi.com\r\n");
-    client.print("User-Agent: MatrixPortal-Weather/1.0\r\n");
-    client.print("Connection: close\r\n\r\n");
-
-    // Wait for response with timeout
-    unsigned long timeout = millis();
-    while (client.available() == 0) {
-        if (millis() - timeout > 10000) {
-            Serial.println("Request timeout");
-            client.stop();
-            return false;
-        }
-    }
-
-    // Skip HTTP headers
-    while (client.available()) {
-        String line = client.readStringUntil('\n');
-        line.trim();
-        if (line.length() == 0) break; // Empty line = end of headers
-    }
-
-    // Read JSON response
-    String response = "";
-    while (client.available()) {
-        char c = client.read();
-        if (c >= 32 && c <= 126) {
-            // Only printable ASCII characters
-            response += c;
-        }
-    }
-
-    client.stop();
-
-    // Validate and clean JSON
-    response.trim();
-    if (!response.startsWith("{") || !response.endsWith("}")) {
-        // Extract JSON if wrapped in extra characters
-        int jsonStart = response.indexOf('{');
-        int jsonEnd = response.lastIndexOf('}');
-        if (jsonStart >= 0 && jsonEnd > jsonStart) {
-            response = response.substring(jsonStart, jsonEnd + 1);
-        } else {
-            Serial.println("Invalid JSON response");
-            return false;
+    if (success) {
+        fetchSchedulerFetched(WIDGET_WEATHER);
+    } else {
+        if (connection.status() == 200) connection.markFailed();   // Answered, but not with weather
+        Serial.println("Failed to fetch weather data");
+        // Keep old data but mark as potentially stale
+        if (millis() - currentWeather.lastUpdate > 1800000) {
+            // 30 minutes
+            currentWeather.dataValid = false;
+            publishWeatherData();
         }
     }
 
-    return parseWeatherJSON(response);
+    // Schedule next update (every 10 minutes for weather data)
+    currentWeather.lastUpdate = millis();
 }
 
 // example response
@@ -237,9 +241,26 @@ bool fetchWeatherData() {
 //     "gust_kph": 22.7
 //   }
 // }
-bool parseWeatherJSON(String jsonString) {
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, jsonString);
+bool parseWeatherJSON(Stream &input) {
+    // Only the fields below are kept out of the ~1.5 KB response
+    JsonArena arena;
+    JsonDocument filter(&arena);
+    filter["location"]["name"] = true;
+    filter["location"]["region"] = true;
+    filter["location"]["country"] = true;
+    filter["current"]["temp_f"] = true;
+    filter["current"]["is_day"] = true;
+    filter["current"]["condition"]["text"] = true;
+    filter["current"]["condition"]["code"] = true;
+    filter["current"]["condition"]["icon"] = true;
+    filter["current"]["humidity"] = true;
+    filter["current"]["wind_mph"] = true;
+    filter["current"]["wind_dir"] = true;
+
+    JsonDocument doc(&arena);
+    uint32_t parseStart = profileNow();
+    DeserializationError error = deserializeJson(doc, input, DeserializationOption::Filter(filter));
+    profileRecord(PROFILE_JSON_PARSE, profileNow() - parseStart);
 
     if (error) {
         Serial.print("JSON parsing failed: ");
@@ -268,6 +289,7 @@ bool parseWeatherJSON(String jsonString) {
     currentWeather.temperature = current["temp_f"].as<int>();
     currentWeather.isDay = static_cast<bool>(current["is_day"].as<int>());
     currentWeather.condition = current["condition"]["text"].as<String>();
+    currentWeather.conditionCode = current["condition"]["code"].as<int>();
     currentWeather.icon = current["condition"]["icon"].as<String>();
     currentWeather.humidity = current["humidity"].as<int>();
     currentWeather.windSpeed = current["wind_mph"].as<int>();
@@ -275,6 +297,8 @@ bool parseWeatherJSON(String jsonString) {
 
     currentWeather.lastUpdate = millis();
     currentWeather.dataValid = true;
+    classifyWeather(currentWeather);
+    publishWeatherData();
 
     Serial.println("Weather updated: " + currentWeather.location +
                    ", " + String(currentWeather.temperature) + "°F, " +
@@ -283,43 +307,168 @@ bool parseWeatherJSON(String jsonString) {
     return true;
 }
 
+/*
+ * Condition classification - runs once per weather update, so drawing a
+ * frame never looks at the condition text
+ */
+
+enum WeatherKind {
+    WEATHER_KIND_CLEAR,
+    WEATHER_KIND_PARTLY_CLOUDY,
+    WEATHER_KIND_CLOUDY,
+    WEATHER_KIND_RAIN,
+    WEATHER_KIND_SNOW,
+    WEATHER_KIND_STORM
+};
+
+// WeatherAPI condition codes (weather_conditions.json in their docs)
+static bool weatherKindFromCode(int code, WeatherKind &kind) {
+    switch (code) {
+        case 1000:                                  // Sunny / clear
+            kind = WEATHER_KIND_CLEAR;
+            return true;
+        case 1003:                                  // Partly cloudy
+            kind = WEATHER_KIND_PARTLY_CLOUDY;
+            return true;
+        case 1006: case 1009:                       // Cloudy, overcast
+        case 1030: case 1135: case 1147:            // Mist, fog, freezing fog
+            kind = WEATHER_KIND_CLOUDY;
+            return true;
+        case 1063: case 1072: case 1150: case 1153: // Patchy rain, drizzle
+        case 1168: case 1171: case 1180: case 1183: // Freezing drizzle, light rain
+        case 1186: case 1189: case 1192: case 1195: // Moderate and heavy rain
+        case 1198: case 1201: case 1240: case 1243: // Freezing rain, showers
+        case 1246:
+            kind = WEATHER_KIND_RAIN;
+            return true;
+        case 1066: case 1069: case 1114: case 1117: // Patchy snow/sleet, blowing snow, blizzard
+        case 1204: case 1207: case 1210: case 1213: // Sleet, light snow
+        case 1216: case 1219: case 1222: case 1225: // Moderate and heavy snow
+        case 1237: case 1249: case 1252: case 1255: // Ice pellets, sleet and snow showers
+        case 1258: case 1261: case 1264: case 1279: // Ice pellet showers, snow with thunder
+        case 1282:
+            kind = WEATHER_KIND_SNOW;
+            return true;
+        case 1087: case 1273: case 1276:            // Thundery outbreaks, rain with thunder
+            kind = WEATHER_KIND_STORM;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Case-insensitive search of the condition text
+static bool conditionHas(const String &condition, const char *word) {
+    size_t wordLength = strlen(word);
+    for (const char *text = condition.c_str(); *text; text++) {
+        if (strncasecmp(text, word, wordLength) == 0) return true;
+    }
+    return false;
+}
+
+// Fallback for conditions without a known code (and the debug conditions)
+static WeatherKind weatherKindFromText(const String &condition) {
+    if (conditionHas(condition, "clear") || conditionHas(condition, "sunny")) {
+        return WEATHER_KIND_CLEAR;
+    } else if (conditionHas(condition, "partly")) {
+        return WEATHER_KIND_PARTLY_CLOUDY;
+    } else if (conditionHas(condition, "cloudy") || conditionHas(condition, "overcast")) {
+        return WEATHER_KIND_CLOUDY;
+    } else if (conditionHas(condition, "rain") || conditionHas(condition, "drizzle")) {
+        return conditionHas(condition, "thunder") ? WEATHER_KIND_STORM : WEATHER_KIND_RAIN;
+    } else if (conditionHas(condition, "snow") || conditionHas(condition, "ice")) {
+        return WEATHER_KIND_SNOW;
+    } else if (conditionHas(condition, "thunder") || conditionHas(condition, "storm")) {
+        return WEATHER_KIND_STORM;
+    }
+    return WEATHER_KIND_CLEAR; // Default: just sun or moon
+}
+
+// Work out the scene for weather.conditionCode (or weather.condition) and weather.isDay
+void classifyWeather(WeatherData &weather) {
+    WeatherKind kind;
+    if (!weatherKindFromCode(weather.conditionCode, kind)) {
+        kind = weatherKindFromText(weather.condition);
+    }
+
+    WeatherScene &scene = weather.scene;
+    scene.celestial = kind == WEATHER_KIND_CLEAR ? CELESTIAL_OPEN_SKY :
+                      kind == WEATHER_KIND_PARTLY_CLOUDY ? CELESTIAL_BEHIND_CLOUDS : CELESTIAL_NONE;
+    scene.clouds = kind == WEATHER_KIND_CLEAR ? CLOUDS_NONE :
+                   kind == WEATHER_KIND_PARTLY_CLOUDY ? CLOUDS_LIGHT : CLOUDS_HEAVY;
+    scene.precipitation = kind == WEATHER_KIND_SNOW ? PRECIPITATION_SNOW :
+                          (kind == WEATHER_KIND_RAIN || kind == WEATHER_KIND_STORM) ? PRECIPITATION_RAIN :
+                          PRECIPITATION_NONE;
+    scene.thunder = kind == WEATHER_KIND_STORM;
+
+    if (weather.isDay) {
+        scene.stars = false;
+        scene.skyTopRows = 3;
+        if (kind == WEATHER_KIND_RAIN || kind == WEATHER_KIND_SNOW || kind == WEATHER_KIND_STORM) {
+            // Rainy day - grey sky
+            scene.skyColor = matrix.color565(55, 55, 56);
+            scene.skyTopColor = matrix.color565(86, 86, 87);
+        } else {
+            // Light blue sky gradient
+            scene.skyColor = matrix.color565(3, 44, 98);
+            scene.skyTopColor = matrix.color565(36, 145, 186);
+        }
+        scene.temperatureColor = matrix.color565(237, 5, 16); // Red
+        scene.locationColor = matrix.color565(247, 153, 2); // Burnt Orange
+    } else {
+        // Night: midnight blue with a purple band and stars
+        scene.stars = true;
+        scene.skyTopRows = 4;
+        scene.skyColor = matrix.color565(20, 1, 54);
+        scene.skyTopColor = matrix.color565(25, 25, 112);
+        if (kind == WEATHER_KIND_SNOW) {
+            // Snowy night - colorful on dark
+            scene.temperatureColor = matrix.color565(150, 150, 255); // Light blue
+            scene.locationColor = matrix.color565(255, 150, 150); // Light red
+        } else {
+            // Dark background, use bright text
+            scene.temperatureColor = matrix.color565(247, 247, 0); // Loud yellow
+            scene.locationColor = matrix.color565(207, 255, 4); // Neon Yellow
+        }
+    }
+}
+
 // weather widget drawing function
 // Modified drawWeatherWidget function with debug support
 void drawWeatherWidget(int x, int y, int width, int height) {
     // Handle debug mode
     if (weatherDebugMode) {
-        // Auto-advance every 5 seconds in debug mode
-        if (millis() - lastDebugSwitch > 5000) {
-            advanceDebugWeather();
+        // Debug conditions never change, so the display task keeps its own
+        // WeatherData for the selected one instead of touching the live data
+        static WeatherData debugWeather;
+        static int debugWeatherIndex = -1;
+        int index = debugConditionIndex;
+        if (index != debugWeatherIndex) {
+            DebugWeatherCondition &condition = debugConditions[index];
+            debugWeather.condition = condition.condition;
+            debugWeather.location = condition.location;
+            debugWeather.temperature = condition.temperature;
+            debugWeather.isDay = condition.isDay;
+            debugWeather.dataValid = true;
+            debugWeather.conditionCode = 0;
+            classifyWeather(debugWeather);
+            debugWeatherIndex = index;
         }
 
-        // Override weather data with debug data
-        DebugWeatherCondition &debugWeather = debugConditions[debugConditionIndex];
-
-        // Temporarily override the current weather data for display
-        WeatherData originalWeather = currentWeather;
-        currentWeather.condition = debugWeather.condition;
-        currentWeather.location = debugWeather.location;
-        currentWeather.temperature = debugWeather.temperature;
-        currentWeather.isDay = debugWeather.isDay;
-        currentWeather.dataValid = true;
-
         // Draw the weather widget with debug data
-        drawWeatherWidgetCore(x, y, width, height);
+        drawWeatherWidgetCore(debugWeather, x, y, width, height);
 
         // Show debug info on display
         // matrix.setCursor(x + 1, y + height - 16);
         // matrix.setTextColor(matrix.color565(255, 100, 100)); // Light red for debug
         // matrix.setTextSize(1);
         // matrix.print("DBG:" + String(debugConditionIndex + 1) + "/" + String(numDebugConditions));
-
-        // Restore original weather data
-        currentWeather = originalWeather;
         return;
     }
 
     // Normal mode - check if we have valid weather data
-    if (!currentWeather.dataValid) {
+    const WeatherData &weather = weatherSnapshot.read();
+    if (!weather.dataValid) {
         // Show loading or error state
         matrix.fillRect(x, y, width, height, matrix.color565(32, 16, 0)); // Dark orange
         matrix.setCursor(x, y + 4);
@@ -329,36 +478,30 @@ void drawWeatherWidget(int x, int y, int width, int height) {
         return;
     }
 
-    drawWeatherWidgetCore(x, y, width, height);
+    drawWeatherWidgetCore(weather, x, y, width, height);
 }
 
 
 // Updated main weather update function
-void updateWeatherData() {
+bool updateWeatherData() {
+    // Still waiting on the previous request
+    if (weatherApiConnection.busy()) return false;
+
     Serial.println("Updating weather data via WeatherAPI...");
 
     if (!isWiFiConnected()) {
         Serial.println("WiFi not connected - skipping weather update");
-        return;
-    }
-
-    bool success = fetchWeatherData();
-
-    if (!success) {
-        Serial.println("Failed to fetch weather data");
-        // Keep old data but mark as potentially stale
-        if (millis() - currentWeather.lastUpdate > 1800000) {
-            // 30 minutes
-            currentWeather.dataValid = false;
-        }
+        return false;
     }
 
-    // Schedule next update (every 10 minutes for weather data)
-    currentWeather.lastUpdate = millis();
+    // IP-based location detection; the response arrives in handleWeatherResponse()
+    String path = "/v1/current.json?key=" + String(weatherApiKey) + "&q=auto:ip&aqi=no";
+    return weatherApiConnection.begin(path, "", handleWeatherResponse);
 }
 
 // Alternative: Fallback to coordinates if IP detection fails
 bool fetchWeatherByCoordinates(float lat, float lon) {
+    ProfileScope fetchScope(PROFILE_FETCH_WEATHER);
     WiFiClient client;
     const char *host = "api.weatherapi.com";
 
@@ -374,7 +517,7 @@ bool fetchWeatherByCoordinates(float lat, float lon) {
     client.print("Host: " + String(host) + "\r\n");
     client.print("Connection: close\r\n\r\n");
 
-    // ... rest of the function similar to fetchWeatherData()
+    // ... rest of the function similar to updateWeatherData()
     // (implementation details omitted for brevity)
 
     return true;
@@ -407,47 +550,41 @@ void drawStars(int x, int y, int width, int height) {
     }
 }
 
-void drawWeatherElements(int x, int y, int width, int height) {
-    String condition = currentWeather.condition;
-    condition.toLowerCase(); // Make case-insensitive
+void drawWeatherElements(const WeatherData &weather, int x, int y, int width, int height) {
+    const WeatherScene &scene = weather.scene;
 
-    // Determine main weather elements to draw
-    if (condition.indexOf("clear") >= 0 || condition.indexOf("sunny") >= 0) {
-        if (currentWeather.isDay) {
+    // Sun or moon, moved left when it shares the sky with light clouds
+    if (scene.celestial == CELESTIAL_OPEN_SKY) {
+        if (weather.isDay) {
             drawAnimatedSun(x + width - 20, y + 2);
         } else {
             drawMoon(x + width - 16, y + 2);
         }
-    } else if (condition.indexOf("partly cloudy") >= 0 || condition.indexOf("partly") >= 0) {
-        // Draw sun/moon with clouds
-        if (currentWeather.isDay) {
+    } else if (scene.celestial == CELESTIAL_BEHIND_CLOUDS) {
+        if (weather.isDay) {
             drawAnimatedSun(x + width - 25, y + 1);
         } else {
             drawMoon(x + width - 20, y + 1);
         }
-        drawAnimatedClouds(x, y, width, height, false); // Light clouds
-    } else if (condition.indexOf("cloudy") >= 0 || condition.indexOf("overcast") >= 0) {
-        drawAnimatedClouds(x, y, width, height, true); // Heavy clouds
-    } else if (condition.indexOf("rain") >= 0 || condition.indexOf("drizzle") >= 0) {
-        drawAnimatedClouds(x, y, width, height, true); // Rain clouds
-        drawAnimatedRain(x, y, width, height);
-        if (condition.indexOf("thunder") >= 0) {
-            drawLightning(x, y, width, height); // Add lightning if thunderstorm
-        }
-    } else if (condition.indexOf("snow") >= 0 || condition.indexOf("ice") >= 0) {
-        drawAnimatedClouds(x, y, width, height, true); // Snow clouds
-        drawAnimatedSnow(x, y, width, height);
-    } else if (condition.indexOf("thunder") >= 0 || condition.indexOf("storm") >= 0) {
-        drawAnimatedClouds(x, y, width, height, true); // Storm clouds
-        drawAnimatedRain(x, y, width, height);
+    }
+
+    if (scene.clouds != CLOUDS_NONE) {
+        drawAnimatedClouds(x, y, width, height, scene.clouds == CLOUDS_HEAVY);
+    }
+
+    switch (scene.precipitation) {
+        case PRECIPITATION_RAIN:
+            drawAnimatedRain(x, y, width, height);
+            break;
+        case PRECIPITATION_SNOW:
+            drawAnimatedSnow(x, y, width, height);
+            break;
+        case PRECIPITATION_NONE:
+            break;
+    }
+
+    if (scene.thunder) {
         drawLightning(x, y, width, height);
-    } else {
-        // Default: just sun or moon
-        if (currentWeather.isDay) {
-            drawAnimatedSun(x + width - 20, y + 2);
-        } else {
-            drawMoon(x + width - 16, y + 2);
-        }
     }
 }
 
@@ -563,83 +700,41 @@ void drawLightning(int x, int y, int width, int height) {
     }
 }
 
-void drawWeatherBackground(int x, int y, int width, int height) {
-    uint16_t bgColor;
-    String condition = currentWeather.condition;
-    condition.toLowerCase(); // Make case-insensitive
-
-    if (currentWeather.isDay) {
-        // Day: Light blue sky gradient
-        bgColor = matrix.color565(3, 44, 98);
-        // Add some darker blue at the top for sky gradient effect
-        uint16_t lightSky = matrix.color565(36, 145, 186);
-        if (
-                condition.indexOf("rain") >= 0 || condition.indexOf("drizzle") >= 0 ||
-                condition.indexOf("storm") >= 0 || condition.indexOf("thunder") >= 0 ||
-                condition.indexOf("snow") >= 0) {
-            // Rainy day - use dark blue for sky
-            bgColor = matrix.color565(55, 55, 56);
-            lightSky = matrix.color565(86, 86, 87);
-        }
-        matrix.fillRect(x, y, width, height, bgColor);
-        matrix.fillRect(x, y, width, 3, lightSky);
-    } else {
-        // Night: Dark blue to purple gradient
-        bgColor = matrix.color565(20, 1, 54); // Midnight blue
-        matrix.fillRect(x, y, width, height, bgColor);
+void drawWeatherBackground(const WeatherData &weather, int x, int y, int width, int height) {
+    const WeatherScene &scene = weather.scene;
 
-        // Add purple tint at top
-        uint16_t darkPurple = matrix.color565(25, 25, 112);
-        matrix.fillRect(x, y, width, 4, darkPurple);
+    // Sky with a lighter (day) or purple (night) band at the top
+    matrix.fillRect(x, y, width, height, scene.skyColor);
+    matrix.fillRect(x, y, width, scene.skyTopRows, scene.skyTopColor);
 
-        // Draw some stars
+    if (scene.stars) {
         drawStars(x, y, width, height);
     }
 }
 
-void drawWeatherText(int x, int y, int width, int height) {
-    // Determine text colors based on background and weather conditions
-    uint16_t tempColor, locationColor;
-
-    String condition = currentWeather.condition;
-    condition.toLowerCase();
-
-    if (currentWeather.isDay) {
-        tempColor = matrix.color565(237, 5, 16); // Red
-        locationColor = matrix.color565(247, 153, 2); // Burnt Orange
-
-    } else {
-        // Night scenes - generally dark backgrounds
-        if (condition.indexOf("rain") >= 0 || condition.indexOf("storm") >= 0 ||
-            condition.indexOf("thunder") >= 0) {
-            // Stormy night - use very bright colors
-            tempColor = matrix.color565(247, 247, 0); // Loud yellow
-            locationColor = matrix.color565(207, 255, 4); // Neon Yellow
-        } else if (condition.indexOf("snow") >= 0) {
-            // Snowy night - colorful on dark
-            tempColor = matrix.color565(150, 150, 255); // Light blue
-            locationColor = matrix.color565(255, 150, 150); // Light red
-        } else {
-            // Clear/cloudy night - dark background, use bright text
-            tempColor = matrix.color565(247, 247, 0); // Loud yellow
-            locationColor = matrix.color565(207, 255, 4); // Neon Yellow
-        }
-    }
+void drawWeatherText(const WeatherData &weather, int x, int y, int width, int height) {
+    // Text colors were picked for the background when the weather was classified
+    uint16_t tempColor = weather.scene.temperatureColor;
+    uint16_t locationColor = weather.scene.locationColor;
 
     // Temperature in upper left with adaptive color
     matrix.setCursor(x + 1, y);
     matrix.setTextColor(tempColor);
     matrix.setTextSize(1);
-    matrix.print(String(currentWeather.temperature) + "F");
-
-    // Location on bottom line with adaptive color
-    matrix.setCursor(x + 1, y + height - 7);
-    matrix.setTextColor(locationColor);
-    String displayLocation = currentWeather.location;
-    // word length + 1 is spaces - each char is 5 pixels wide
-    // I have 64 pixels wide, so 10 characters max
-    if (displayLocation.length() > 10) {
-        displayLocation = displayLocation.substring(0, 10) + "...";
+    char temperature[8];
+    snprintf(temperature, sizeof(temperature), "%dF", weather.temperature);
+    matrix.print(temperature);
+
+    // Location on bottom line with adaptive color, rasterized only when it changes
+    if (!locationStrip.canvas || weather.location != locationStripSource) {
+        locationStripSource = weather.location;
+        String displayLocation = weather.location;
+        // word length + 1 is spaces - each char is 5 pixels wide
+        // I have 64 pixels wide, so 10 characters max
+        if (displayLocation.length() > 10) {
+            displayLocation = displayLocation.substring(0, 10) + "...";
+        }
+        setTextStripText(locationStrip, displayLocation);
     }
-    matrix.print(displayLocation);
+    drawTextStrip(locationStrip, x + 1, y + height - 7, locationColor);
 }
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Compress the pages in web/ into web_assets.cpp and web_assets.h.
+
+Each page becomes a gzip byte array in flash with its ETag, served as-is by
+the web server. Run this after editing a page; deploy.bat and the host CMake
+build run it before compiling. The output only changes when a page does.
+"""
+
+import gzip
+import hashlib
+import pathlib
+
+WEB = pathlib.Path(__file__).resolve().parent
+OUTPUT = WEB.parent / "web_assets.cpp"
+HEADER = WEB.parent / "web_assets.h"
+
+# (request path, file in web/, content type)
+PAGES = [
+    ("/", "index.html", "text/html; charset=UTF-8"),
+    ("/msgraph_auth", "msgraph_auth.html", "text/html; charset=UTF-8"),
+    ("/msgraph_code", "msgraph_code.html", "text/html; charset=UTF-8"),
+]
+
+
+def symbol(name):
+    return "asset_" + "".join(c if c.isalnum() else "_" for c in name)
+
+
+def asset_id(name):
+    return "WEB_ASSET_" + pathlib.Path(name).stem.upper()
+
+
+def write_if_changed(path, text):
+    if not path.exists() or path.read_text(encoding="utf-8") != text:
+        path.write_text(text, encoding="utf-8")
+
+
+def header():
+    ids = "\n".join(f"  {asset_id(name)}," for _, name, _ in PAGES)
+    return f"""// Generated by web/gen_web_assets.py - edit the script, not this file
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// Static pages of the control UI, gzipped at build time from web/. Sent as
+// stored, with Content-Encoding: gzip.
+
+struct WebAsset {{
+  const char *path;
+  const char *contentType;
+  const char *etag;             // Quoted, from the uncompressed page
+  const uint8_t *data;
+  uint32_t length;
+}};
+
+// Index into webAssets
+enum WebAssetId {{
+{ids}
+  WEB_ASSET_COUNT
+}};
+
+extern const WebAsset webAssets[WEB_ASSET_COUNT];
+
+#endif
+"""
+
+
+def main():
+    lines = [
+        "// Generated by web/gen_web_assets.py from the pages in web/ - edit those and rerun it",
+        "",
+        '#include "web_assets.h"',
+        "",
+    ]
+    table = []
+    for path, name, content_type in PAGES:
+        raw = (WEB / name).read_bytes()
+        packed = gzip.compress(raw, compresslevel=9, mtime=0)
+        packed = packed[:9] + b"\xff" + packed[10:]  # OS byte "unknown", same output everywhere
+        etag = '"' + hashlib.sha1(raw).hexdigest()[:16] + '"'
+
+        lines.append(f"// {name}: {len(raw)} bytes, {len(packed)} gzipped")
+        lines.append(f"static const uint8_t {symbol(name)}[] = {{")
+        for offset in range(0, len(packed), 16):
+            chunk = packed[offset:offset + 16]
+            lines.append("  " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+        lines.append("};")
+        lines.append("")
+        table.append(f'  {{"{path}", "{content_type}", "\\{etag[:-1]}\\"", '
+                     f"{symbol(name)}, sizeof({symbol(name)})}},")
+
+    lines.append("const WebAsset webAssets[WEB_ASSET_COUNT] = {")
+    lines.extend(table)
+    lines.append("};")
+
+    write_if_changed(OUTPUT, "\n".join(lines) + "\n")
+    write_if_changed(HEADER, header())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,408 @@
+// Generated by web/gen_web_assets.py from the pages in web/ - edit those and rerun it
+
+#include "web_assets.h"
+
+// index.html: 10969 bytes, 3455 gzipped
+static const uint8_t asset_index_html[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xc5, 0x1a, 0x5b, 0x6b, 0x23, 0xd7,
+  0xf9, 0xdd, 0xbf, 0xe2, 0x8b, 0x43, 0x3b, 0x12, 0xb1, 0x47, 0x37, 0xdb, 0xeb, 0xb5, 0x64, 0x19,
+  0x5f, 0x1b, 0x07, 0xef, 0xc6, 0xb5, 0xbd, 0x5d, 0x42, 0x12, 0x96, 0xa3, 0x99, 0x23, 0xe9, 0xe0,
+  0xd1, 0xcc, 0x74, 0xe6, 0x8c, 0x65, 0x65, 0xf1, 0x5b, 0x0b, 0xa5, 0x84, 0x2c, 0xbd, 0xd0, 0x42,
+  0xda, 0x10, 0x02, 0x7d, 0x28, 0x94, 0x42, 0x5f, 0x1a, 0xd2, 0xd7, 0xfe, 0x94, 0xfd, 0x03, 0xcd,
+  0x4f, 0xe8, 0xf7, 0x9d, 0x73, 0xe6, 0x22, 0x69, 0xe4, 0xb5, 0x9d, 0xb4, 0x61, 0xf1, 0x5a, 0xe7,
+  0xf6, 0xdd, 0xef, 0x72, 0xe7, 0xad, 0x83, 0xf7, 0xf7, 0x2f, 0x3e, 0x38, 0x3d, 0x84, 0xa1, 0x1c,
+  0x79, 0xdd, 0xa5, 0x4e, 0xfa, 0x8b, 0x33, 0x17, 0x7f, 0x49, 0x21, 0x3d, 0xde, 0x3d, 0x39, 0x3c,
+  0x80, 0x27, 0x4c, 0x46, 0xe2, 0x1a, 0xf6, 0x03, 0x5f, 0x46, 0x81, 0xd7, 0xa9, 0xe9, 0x93, 0xa5,
+  0x4e, 0x2c, 0x27, 0xf4, 0xbb, 0x17, 0xb8, 0x13, 0x78, 0x09, 0x7d, 0x3c, 0x5e, 0xed, 0xb3, 0x91,
+  0xf0, 0x26, 0x5b, 0xb0, 0x1b, 0x09, 0xe6, 0xb5, 0x61, 0xc4, 0xa2, 0x81, 0xf0, 0xb7, 0xa0, 0x59,
+  0x0f, 0xaf, 0xdb, 0xd0, 0x63, 0xce, 0xe5, 0x20, 0x0a, 0x12, 0xdf, 0xdd, 0x82, 0xb7, 0x9b, 0xcd,
+  0x66, 0x1b, 0x9c, 0xc0, 0x0b, 0x22, 0x5c, 0xf4, 0xfb, 0xfd, 0x36, 0xdc, 0x2c, 0x0d, 0x1b, 0x08,
+  0x27, 0xdd, 0x5b, 0xdb, 0xdf, 0x3d, 0x5a, 0xaf, 0xd3, 0x76, 0x2f, 0x91, 0x32, 0xf0, 0xf1, 0x28,
+  0x64, 0xae, 0x2b, 0xfc, 0xc1, 0x16, 0x34, 0x10, 0x9e, 0x01, 0x9a, 0xa2, 0x58, 0xa7, 0x85, 0xa2,
+  0x21, 0x16, 0x9f, 0x70, 0xbc, 0xb2, 0xa1, 0x50, 0x06, 0x91, 0xcb, 0x11, 0x9a, 0x1f, 0xf8, 0x3c,
+  0x5d, 0xad, 0x46, 0xcc, 0x15, 0x49, 0x6c, 0x9e, 0x38, 0x49, 0x14, 0x13, 0xbe, 0x30, 0x10, 0xbe,
+  0xe4, 0x11, 0xe1, 0xb3, 0x15, 0x09, 0xab, 0x3d, 0x49, 0x38, 0xc7, 0xc2, 0x95, 0x43, 0xbc, 0xab,
+  0x90, 0x0d, 0xb9, 0x18, 0x0c, 0x65, 0xba, 0x4a, 0x51, 0xb7, 0x8a, 0x98, 0x9a, 0x48, 0x59, 0x1c,
+  0x78, 0xc2, 0x85, 0xb7, 0x37, 0x36, 0x36, 0x0c, 0x38, 0x25, 0x38, 0x03, 0x70, 0x4a, 0x0a, 0x29,
+  0x93, 0x86, 0xe9, 0xf1, 0x50, 0x48, 0x3e, 0xfb, 0x66, 0x6b, 0x18, 0x5c, 0xf1, 0x68, 0xee, 0xe5,
+  0x3a, 0xab, 0xaf, 0x3d, 0x56, 0x77, 0x65, 0x94, 0x38, 0x97, 0x65, 0xd0, 0x8f, 0x8e, 0x36, 0xf6,
+  0x5a, 0xeb, 0x25, 0xd0, 0xb3, 0x17, 0xe5, 0xb0, 0x0f, 0xd7, 0xd7, 0x77, 0x9b, 0x7b, 0xea, 0x26,
+  0xb2, 0x3f, 0xe0, 0xb2, 0x0c, 0x78, 0xb3, 0xf1, 0x78, 0xe3, 0xa8, 0x55, 0x02, 0x3c, 0x7f, 0x52,
+  0x0e, 0xbd, 0xf1, 0xf8, 0xd1, 0xc6, 0x41, 0x53, 0x5d, 0x75, 0x79, 0x2f, 0x19, 0x94, 0x01, 0x7f,
+  0xbc, 0xdf, 0x7c, 0xb4, 0x57, 0x26, 0x97, 0xec, 0x45, 0x39, 0xec, 0x47, 0x7b, 0x8d, 0xa3, 0x5d,
+  0x0d, 0x3b, 0x0e, 0x03, 0x29, 0xfa, 0x93, 0x32, 0xe8, 0x8d, 0x83, 0xbd, 0xc7, 0xeb, 0x6b, 0x25,
+  0xd0, 0x0b, 0x6f, 0x16, 0xd0, 0xbe, 0xbb, 0x7b, 0xb8, 0xb6, 0x4f, 0x77, 0x85, 0x1f, 0x26, 0xf2,
+  0x43, 0x39, 0x09, 0xf9, 0xb6, 0x25, 0xf9, 0xb5, 0xb4, 0x3e, 0x2e, 0x1a, 0xe8, 0x66, 0xa9, 0x35,
+  0x1a, 0x5b, 0x6a, 0xd6, 0xeb, 0x45, 0x8b, 0x69, 0xcc, 0x58, 0xcc, 0x8c, 0x95, 0xae, 0xcd, 0xb9,
+  0xce, 0xda, 0xda, 0xda, 0x9c, 0xeb, 0xc4, 0xdc, 0xe3, 0x8e, 0x7c, 0x33, 0x09, 0xdf, 0x2b, 0x52,
+  0x3b, 0x46, 0x9c, 0x42, 0xb9, 0x66, 0xd1, 0xd3, 0x01, 0x15, 0x97, 0xbb, 0xea, 0xfa, 0x1c, 0xa8,
+  0x56, 0xab, 0x35, 0x87, 0x70, 0x53, 0x13, 0x77, 0xbd, 0x1a, 0x0f, 0x99, 0x1b, 0x8c, 0xb7, 0xa0,
+  0xae, 0x3c, 0x09, 0xe9, 0x80, 0x68, 0xd0, 0x63, 0x95, 0xfa, 0x8a, 0xfa, 0x67, 0xb7, 0xaa, 0x45,
+  0x1b, 0x1b, 0x44, 0xc8, 0xc0, 0x4b, 0x70, 0x45, 0x1c, 0x7a, 0x0c, 0xc3, 0x0e, 0xad, 0xdb, 0xea,
+  0xff, 0x55, 0xc9, 0x47, 0xb8, 0x27, 0xf9, 0x2a, 0xd2, 0x9c, 0x8c, 0x7c, 0x44, 0xd1, 0xe8, 0x47,
+  0xf4, 0x83, 0xe7, 0x2c, 0xd4, 0x21, 0x24, 0x77, 0xe1, 0x86, 0x21, 0xfb, 0x66, 0xa9, 0x53, 0x33,
+  0x61, 0xad, 0x53, 0x33, 0x81, 0x90, 0xe2, 0x1b, 0x85, 0xc5, 0x46, 0xf7, 0xdb, 0x2f, 0x3f, 0xfb,
+  0x2b, 0xcc, 0x47, 0x44, 0x38, 0x65, 0x3e, 0xc7, 0xb8, 0x88, 0x37, 0x96, 0x3a, 0xae, 0xb8, 0x02,
+  0xc7, 0x63, 0x71, 0xbc, 0x6d, 0x19, 0xe9, 0x58, 0xf4, 0xb8, 0xd5, 0xdd, 0x27, 0xd9, 0xc5, 0x5b,
+  0x78, 0xad, 0x45, 0x40, 0x75, 0x4c, 0x33, 0x37, 0xb3, 0x80, 0x63, 0x81, 0xc2, 0xbe, 0x6d, 0x15,
+  0x05, 0xd6, 0xf3, 0x70, 0x61, 0x41, 0xe0, 0x3b, 0x9e, 0x70, 0x2e, 0x09, 0xae, 0x54, 0xc0, 0x2a,
+  0xf5, 0xaa, 0xd5, 0xed, 0xd4, 0x34, 0xa8, 0x7b, 0xc2, 0x8c, 0xb8, 0x5b, 0x06, 0xb1, 0xf1, 0x70,
+  0x88, 0x83, 0x88, 0x73, 0xbf, 0x0c, 0x66, 0xf3, 0xe1, 0x30, 0x7b, 0x5e, 0xc2, 0xcb, 0x40, 0xb6,
+  0x1e, 0x0e, 0x72, 0xc2, 0x3d, 0x2f, 0x18, 0x97, 0x01, 0x5d, 0x7b, 0x38, 0xd0, 0x11, 0x1b, 0x70,
+  0x5f, 0xb2, 0x32, 0xa8, 0xeb, 0x0f, 0x87, 0xea, 0x4c, 0x58, 0xa9, 0x40, 0x37, 0x1e, 0x0e, 0x52,
+  0x85, 0xba, 0x32, 0x98, 0x8f, 0xa6, 0x61, 0xd6, 0xd0, 0x8c, 0x6f, 0x33, 0xe6, 0x03, 0xed, 0x71,
+  0xf0, 0x24, 0x70, 0xf9, 0x42, 0x9b, 0xce, 0x32, 0xd8, 0x34, 0xc2, 0x53, 0x26, 0x31, 0xd1, 0xfa,
+  0x15, 0xc4, 0xf8, 0xed, 0x97, 0x9f, 0xfe, 0x0a, 0xce, 0x98, 0xf0, 0x7b, 0xc1, 0x18, 0xcc, 0xfe,
+  0x42, 0xce, 0xb2, 0xa4, 0x35, 0x0d, 0xee, 0x82, 0xb6, 0x35, 0xb0, 0xcf, 0xff, 0x04, 0x6a, 0x05,
+  0xbb, 0xbe, 0x18, 0x31, 0x22, 0xf7, 0x16, 0x31, 0x95, 0x51, 0xe7, 0x78, 0x9c, 0x45, 0x86, 0x37,
+  0x02, 0xf9, 0xfa, 0xf3, 0xbf, 0xc1, 0x3e, 0xed, 0x81, 0xd9, 0x5c, 0x08, 0x2f, 0x4f, 0x7a, 0x33,
+  0xcc, 0x8a, 0x6b, 0xee, 0xc5, 0x9a, 0xbc, 0xdf, 0x7e, 0x05, 0x07, 0x07, 0xa7, 0x50, 0x83, 0xc3,
+  0x86, 0xdd, 0x6a, 0xc0, 0x31, 0x65, 0x90, 0x7b, 0xc8, 0xfc, 0x1c, 0x83, 0x95, 0x84, 0xe7, 0x0a,
+  0x51, 0x26, 0xf3, 0xc2, 0xed, 0x42, 0x4c, 0xb4, 0xf4, 0x09, 0xfe, 0xef, 0xb1, 0x1e, 0xf7, 0xba,
+  0xfa, 0x11, 0xbe, 0xd1, 0xcb, 0x4e, 0x2f, 0xa2, 0xf2, 0x4d, 0xa7, 0x0c, 0xe1, 0xa6, 0x4f, 0xe9,
+  0x55, 0x10, 0xaa, 0x80, 0x7e, 0xc5, 0xd0, 0xf3, 0xb6, 0xad, 0xba, 0xd5, 0x7d, 0x8a, 0x95, 0x53,
+  0xa7, 0xa6, 0xb7, 0xe7, 0xce, 0x1b, 0x56, 0x77, 0xdf, 0x0b, 0x9c, 0xcb, 0x85, 0x17, 0x9a, 0x56,
+  0xf7, 0x39, 0x67, 0x72, 0xc8, 0xa3, 0x85, 0x57, 0x5a, 0x56, 0xf7, 0x82, 0xb3, 0x51, 0x0c, 0xe7,
+  0x92, 0xc9, 0x24, 0x5e, 0x78, 0x6f, 0xcd, 0xea, 0x9e, 0x4b, 0xc4, 0x05, 0x17, 0x28, 0xdb, 0x5b,
+  0xe0, 0xad, 0x93, 0xa8, 0x3f, 0xfb, 0x27, 0x9c, 0xeb, 0x5c, 0x5e, 0xb8, 0x57, 0xd3, 0x1c, 0xdf,
+  0x59, 0x77, 0x5a, 0x6a, 0xa4, 0xbb, 0x73, 0x5e, 0xa2, 0xa8, 0xe9, 0x5f, 0x0b, 0xd5, 0x76, 0x81,
+  0xc5, 0x41, 0x6a, 0x3e, 0xa9, 0xd6, 0x54, 0xf1, 0x00, 0x85, 0xe2, 0x41, 0x69, 0x81, 0x3e, 0x29,
+  0xa3, 0xb0, 0x00, 0x2f, 0x3b, 0x7c, 0x18, 0x78, 0x98, 0x22, 0xb7, 0xad, 0x43, 0x2a, 0x4c, 0x81,
+  0x4e, 0x41, 0x06, 0x69, 0xb2, 0xb3, 0xee, 0xee, 0x70, 0x44, 0x81, 0xb6, 0xc0, 0xdf, 0x7d, 0x01,
+  0xe7, 0x43, 0x74, 0x35, 0xda, 0xb9, 0x87, 0xe5, 0xa1, 0x9b, 0xfe, 0xe5, 0x3f, 0xdf, 0xbc, 0x02,
+  0xa3, 0x4a, 0x38, 0xa0, 0x22, 0x4c, 0xf9, 0x7e, 0xca, 0x50, 0x88, 0x6c, 0xc6, 0x12, 0x98, 0xe7,
+  0xc1, 0xd8, 0x5c, 0x42, 0x72, 0x5c, 0x41, 0x40, 0x62, 0x60, 0xbe, 0x8b, 0x3f, 0xc6, 0x25, 0xc9,
+  0x74, 0xc3, 0x39, 0xe2, 0xb3, 0xba, 0xae, 0x40, 0x3a, 0xf7, 0x59, 0xcf, 0xe3, 0x06, 0xa9, 0xc2,
+  0xa9, 0xb9, 0xf8, 0xfd, 0x2f, 0xe0, 0x50, 0x1d, 0xc1, 0x6e, 0x22, 0x83, 0xd5, 0xfd, 0x09, 0xba,
+  0xed, 0x42, 0xc7, 0x2c, 0x03, 0xec, 0x23, 0xfb, 0xb3, 0x60, 0x5f, 0xbf, 0xfa, 0x3b, 0xb1, 0xf8,
+  0x94, 0xa4, 0xbc, 0x9f, 0x92, 0x7e, 0xcf, 0xf0, 0x81, 0xaa, 0x29, 0xa3, 0xf8, 0xf5, 0xab, 0x7f,
+  0x11, 0xe8, 0x03, 0x7d, 0xaa, 0xa5, 0x77, 0xbf, 0x40, 0xe2, 0x0c, 0xb9, 0x73, 0xa9, 0xde, 0x69,
+  0x27, 0x31, 0xda, 0xfc, 0x75, 0xe6, 0x33, 0x19, 0x30, 0xd2, 0x21, 0xd9, 0x92, 0x9b, 0x5f, 0xce,
+  0x12, 0x81, 0x2e, 0x76, 0x56, 0x65, 0x90, 0x95, 0x3f, 0x53, 0x0d, 0x55, 0x59, 0xc1, 0x57, 0x52,
+  0x16, 0xa2, 0x4d, 0x68, 0xfd, 0xc7, 0x0a, 0x3a, 0x16, 0xb5, 0xa8, 0x74, 0x16, 0x86, 0x14, 0x25,
+  0x91, 0x6b, 0x7e, 0x67, 0xc7, 0x40, 0x06, 0xbe, 0x86, 0x13, 0x71, 0xc5, 0x8b, 0xb1, 0x8c, 0x68,
+  0xf7, 0x70, 0x2f, 0x23, 0xfa, 0x81, 0x24, 0x4e, 0x01, 0x33, 0x0a, 0xc9, 0x62, 0xd1, 0x16, 0xac,
+  0x16, 0xa9, 0x4b, 0xaf, 0x99, 0x88, 0x81, 0xee, 0xae, 0x3f, 0x2c, 0xb8, 0xa6, 0xa2, 0x95, 0x09,
+  0x5a, 0x0b, 0xae, 0x1c, 0xf0, 0x2b, 0xe1, 0xe4, 0x3c, 0xa4, 0x65, 0xf3, 0xe6, 0xe6, 0x26, 0xd2,
+  0x86, 0xd6, 0xe5, 0x93, 0x20, 0xfc, 0x81, 0x6d, 0xdb, 0xf7, 0x0c, 0x26, 0x28, 0xb3, 0xaf, 0x60,
+  0xf7, 0xf4, 0xd8, 0x28, 0x3e, 0x77, 0xbf, 0x3d, 0x94, 0x4b, 0xd0, 0xef, 0x2b, 0x57, 0x73, 0x44,
+  0xe4, 0x24, 0x42, 0x42, 0x2f, 0xe2, 0x0c, 0x23, 0xa5, 0x52, 0x14, 0x87, 0x10, 0x3f, 0x25, 0x61,
+  0x2c, 0x71, 0x73, 0xb4, 0x05, 0x1d, 0x06, 0xc3, 0x88, 0xf7, 0xb7, 0xad, 0x5a, 0x6c, 0x8c, 0x44,
+  0xa2, 0x75, 0x70, 0xb9, 0x6d, 0xbd, 0xc0, 0x72, 0xd3, 0xbf, 0x9c, 0xa3, 0xdd, 0x74, 0xaa, 0x56,
+  0xd7, 0x3c, 0xe8, 0xd4, 0x58, 0x57, 0x3b, 0xf2, 0x9b, 0x69, 0xce, 0xa3, 0x31, 0x60, 0x24, 0x4d,
+  0xc2, 0x9c, 0xec, 0x0e, 0xd2, 0x13, 0xf8, 0x03, 0x8c, 0xec, 0x3c, 0x84, 0xc6, 0x16, 0x15, 0xdf,
+  0x6a, 0x0d, 0x3f, 0xe1, 0x18, 0x4d, 0x12, 0x39, 0x0c, 0x22, 0xf1, 0x89, 0x0a, 0x1b, 0xf0, 0xec,
+  0xec, 0xa4, 0x2c, 0x70, 0x14, 0x5a, 0xb6, 0x62, 0xd4, 0xd3, 0xbb, 0x18, 0x1f, 0x86, 0x26, 0x66,
+  0xfc, 0x46, 0x81, 0xa4, 0x0d, 0x0d, 0x69, 0xce, 0x63, 0x08, 0xdb, 0xb3, 0xc8, 0x33, 0x91, 0x7a,
+  0xc6, 0x69, 0xf2, 0x0e, 0xe1, 0x21, 0xf6, 0x08, 0x63, 0xdc, 0x5b, 0x55, 0xea, 0xd8, 0xd2, 0x5a,
+  0x59, 0xc5, 0x48, 0xd9, 0xa6, 0x8a, 0x4b, 0xcb, 0x6e, 0x46, 0x10, 0xcd, 0x82, 0x20, 0x7e, 0x26,
+  0x62, 0x54, 0x25, 0x5a, 0x2d, 0x91, 0x0d, 0xac, 0x87, 0x5d, 0xe9, 0x4a, 0x26, 0x19, 0xfc, 0x88,
+  0x27, 0x3e, 0x12, 0x15, 0xa3, 0x86, 0xe9, 0xd2, 0xd1, 0xb3, 0x93, 0x13, 0x2a, 0xee, 0x45, 0x44,
+  0xb9, 0x9d, 0x9e, 0x60, 0xc2, 0x0f, 0xc6, 0x5a, 0x72, 0x3a, 0xfb, 0x9f, 0x15, 0x4f, 0x2b, 0xf9,
+  0x53, 0x27, 0xc0, 0x8e, 0x89, 0x4b, 0x8d, 0x68, 0x12, 0x24, 0x80, 0xe6, 0x90, 0x81, 0xe2, 0x2e,
+  0xe6, 0x9e, 0xea, 0x4c, 0x05, 0x51, 0x9e, 0xc6, 0xd2, 0x27, 0x28, 0xcc, 0x99, 0x44, 0x36, 0x94,
+  0x32, 0x8c, 0xb7, 0x6a, 0x35, 0xa3, 0x1d, 0x1b, 0x31, 0xd6, 0x76, 0x1c, 0x4c, 0x23, 0xdb, 0xbb,
+  0x3f, 0xdd, 0x6f, 0x34, 0x5b, 0x6b, 0xeb, 0x1b, 0x8f, 0x36, 0x1f, 0xd7, 0xd1, 0x2d, 0x32, 0xf1,
+  0x9b, 0x96, 0x79, 0x4d, 0xb5, 0xcc, 0x96, 0xc1, 0x7b, 0xa7, 0xbc, 0x97, 0xf4, 0x46, 0x42, 0xa6,
+  0xbc, 0x22, 0x4b, 0x79, 0xee, 0xb8, 0x96, 0x11, 0x73, 0x28, 0xca, 0xbb, 0x1c, 0x7e, 0xac, 0xcc,
+  0xe2, 0x22, 0xb8, 0xe4, 0x7e, 0x31, 0x8c, 0x86, 0x29, 0xfe, 0x62, 0x03, 0xdd, 0x54, 0xf3, 0xa2,
+  0x29, 0x5f, 0x5e, 0x52, 0x55, 0xdd, 0x85, 0xc0, 0x88, 0xba, 0xdb, 0xa7, 0x2c, 0xad, 0xb0, 0xa3,
+  0x7d, 0xe4, 0x2a, 0x42, 0x92, 0x52, 0xeb, 0x5f, 0x21, 0xb1, 0x5a, 0x18, 0x2e, 0x7b, 0x7c, 0x5a,
+  0xb0, 0xc0, 0x50, 0x85, 0x03, 0x52, 0x03, 0x93, 0x30, 0xa2, 0x19, 0x13, 0xc4, 0x94, 0xa7, 0x99,
+  0x0f, 0x3c, 0x8a, 0x82, 0xc8, 0x86, 0xa5, 0x0b, 0x3c, 0xb2, 0x62, 0xf0, 0x83, 0x68, 0xc4, 0xbc,
+  0xb7, 0xe0, 0xbd, 0x04, 0xd3, 0xad, 0x13, 0x84, 0x13, 0xa5, 0xba, 0xc3, 0xa7, 0x17, 0xc7, 0x67,
+  0x87, 0x4a, 0x71, 0xfd, 0x28, 0x18, 0x11, 0x9a, 0x08, 0x0d, 0x2d, 0x18, 0xc7, 0x18, 0xf5, 0x30,
+  0xff, 0xba, 0x6e, 0xc4, 0xe3, 0x18, 0x8d, 0x35, 0x52, 0x01, 0x42, 0xeb, 0x1c, 0xcd, 0x4a, 0x99,
+  0x93, 0xbd, 0xa4, 0xad, 0x23, 0x75, 0x04, 0xa3, 0x9d, 0xff, 0x55, 0xf2, 0xd8, 0x27, 0x09, 0x81,
+  0x55, 0xf4, 0x46, 0x8b, 0x44, 0x80, 0x61, 0x05, 0xcb, 0xdb, 0x98, 0xe2, 0xc3, 0x9d, 0xc3, 0xe1,
+  0x13, 0xe1, 0x44, 0x41, 0x1c, 0xf4, 0x51, 0x83, 0xaa, 0x84, 0x3c, 0xc6, 0x4a, 0x69, 0x10, 0xa9,
+  0x78, 0x51, 0xde, 0x94, 0x14, 0xb3, 0xeb, 0x7c, 0x7b, 0xf4, 0x76, 0xbd, 0xfe, 0x68, 0xd3, 0x5d,
+  0x6b, 0x17, 0xcc, 0x68, 0x2c, 0x7c, 0x37, 0x18, 0xdb, 0x58, 0xe4, 0x2a, 0xa8, 0xb6, 0x0a, 0x9a,
+  0xcb, 0xb5, 0x51, 0x8c, 0x68, 0xc2, 0xe1, 0x0b, 0xd2, 0xf2, 0xb2, 0x89, 0x2f, 0xbb, 0x99, 0xc6,
+  0x15, 0x31, 0x53, 0xd6, 0xa4, 0xcb, 0x3b, 0xdc, 0xa5, 0x4b, 0x59, 0x0a, 0x20, 0xb6, 0x67, 0x59,
+  0xc8, 0x2b, 0x3c, 0xad, 0xc5, 0x10, 0x35, 0xc7, 0x7d, 0x87, 0x9b, 0x74, 0x6b, 0x4f, 0xc5, 0xdc,
+  0xd8, 0x89, 0x44, 0x88, 0x05, 0x6d, 0xad, 0x06, 0x17, 0x68, 0x06, 0xca, 0x86, 0x84, 0xc4, 0x32,
+  0xb7, 0x0f, 0x22, 0x56, 0x2f, 0x84, 0xd3, 0x86, 0x1a, 0xbf, 0xc2, 0xee, 0x14, 0xd7, 0xdc, 0x77,
+  0x63, 0x65, 0x2f, 0xae, 0xce, 0x4f, 0xb1, 0x49, 0x0d, 0x01, 0xc1, 0x27, 0x21, 0x69, 0xb2, 0x56,
+  0x08, 0x9e, 0x8a, 0x2b, 0x81, 0xef, 0x4d, 0xb0, 0x67, 0x44, 0xa3, 0x74, 0x86, 0xcc, 0x1f, 0xf0,
+  0xd8, 0x86, 0x43, 0x82, 0x75, 0x8e, 0x94, 0x39, 0x64, 0xc3, 0xe6, 0x05, 0x9a, 0xd6, 0xc4, 0x20,
+  0xb6, 0x97, 0x30, 0x86, 0x60, 0x51, 0xd0, 0x17, 0xb0, 0x0d, 0x96, 0xd5, 0x5e, 0xea, 0x27, 0xbe,
+  0x1e, 0x12, 0x91, 0x45, 0x93, 0x51, 0xf1, 0x8a, 0xc2, 0x5a, 0x85, 0x97, 0x4b, 0x00, 0xa2, 0x0f,
+  0x95, 0xb4, 0xfd, 0x00, 0xe1, 0x83, 0x39, 0x72, 0x03, 0x27, 0x19, 0x21, 0x22, 0x1b, 0xf7, 0x0f,
+  0x3d, 0x4e, 0x1f, 0xf7, 0x26, 0xc7, 0x6e, 0x76, 0xb5, 0x6a, 0xab, 0x6a, 0x1f, 0x51, 0xa8, 0x07,
+  0x66, 0x1e, 0xd4, 0x4e, 0x01, 0x9a, 0x60, 0xf4, 0x66, 0x70, 0x79, 0xc9, 0x3d, 0x0b, 0x91, 0x4e,
+  0x52, 0x78, 0x7a, 0xa7, 0x90, 0x53, 0x94, 0x9a, 0x5d, 0xcd, 0x01, 0x2c, 0x86, 0x3e, 0xed, 0x49,
+  0x55, 0x5b, 0xa0, 0xb0, 0xa2, 0x77, 0x2f, 0x9e, 0x9c, 0x90, 0x68, 0x5e, 0xff, 0xf9, 0x97, 0x59,
+  0x56, 0x44, 0x65, 0x65, 0xf1, 0xc2, 0xb5, 0xe1, 0x8c, 0x63, 0x35, 0xa5, 0x83, 0x3e, 0x3a, 0x6a,
+  0x18, 0x6b, 0x3f, 0x55, 0x4e, 0x32, 0x16, 0xd2, 0x19, 0x02, 0x73, 0x1c, 0x34, 0x58, 0x19, 0xdb,
+  0x16, 0x91, 0x78, 0x33, 0x45, 0x66, 0x66, 0x66, 0x77, 0x24, 0x32, 0x37, 0xcb, 0x12, 0x02, 0xb5,
+  0x4d, 0x4e, 0x93, 0x57, 0x82, 0x73, 0x5c, 0xa8, 0x78, 0x8f, 0xfd, 0x7e, 0x70, 0x8b, 0xc4, 0x8b,
+  0x85, 0xe9, 0x34, 0xc2, 0x72, 0x50, 0xed, 0xdc, 0x48, 0xfa, 0xa2, 0xa8, 0x53, 0x63, 0x62, 0xa9,
+  0xfe, 0xfb, 0xa2, 0xbd, 0x74, 0x93, 0x1b, 0x9b, 0x31, 0x4c, 0x65, 0xad, 0x58, 0x2e, 0x2b, 0x21,
+  0xe0, 0x1e, 0x06, 0x4d, 0xe3, 0x0c, 0xdb, 0xe0, 0xf3, 0x71, 0xd1, 0x9a, 0x2b, 0x96, 0xf1, 0x13,
+  0xab, 0xda, 0xce, 0x2e, 0x23, 0xa4, 0x6d, 0xa8, 0xf8, 0x6c, 0x84, 0x99, 0x16, 0x3d, 0xc0, 0xf5,
+  0x78, 0x54, 0x85, 0xed, 0xae, 0x01, 0x62, 0x63, 0x04, 0x54, 0x10, 0x4e, 0x04, 0xea, 0x09, 0x39,
+  0x31, 0x37, 0x39, 0x5d, 0x31, 0xd7, 0x2b, 0xef, 0x9d, 0xbf, 0xff, 0xd4, 0x0e, 0x59, 0x14, 0xf3,
+  0x0a, 0xb7, 0x5d, 0x26, 0x59, 0xb5, 0xaa, 0x10, 0x04, 0x3e, 0x1a, 0x08, 0x11, 0x6f, 0xad, 0xe4,
+  0xae, 0x91, 0x9d, 0x18, 0x31, 0xe0, 0xd9, 0x98, 0x80, 0xbd, 0x41, 0x87, 0xc5, 0x22, 0xb7, 0xaa,
+  0x4c, 0x97, 0x46, 0x93, 0x78, 0x8c, 0xd4, 0x8f, 0xc9, 0xb0, 0x85, 0x0b, 0x3b, 0x0a, 0x04, 0x80,
+  0x95, 0x15, 0xc1, 0x16, 0xbc, 0x03, 0x79, 0x68, 0xc3, 0x85, 0x65, 0xb6, 0x68, 0x76, 0xca, 0x31,
+  0x8c, 0x26, 0x11, 0xa7, 0xdd, 0x7f, 0xff, 0x63, 0xc5, 0x1c, 0x64, 0x3d, 0x1d, 0x6d, 0xa7, 0x9b,
+  0xc3, 0x64, 0x24, 0x70, 0x77, 0x42, 0x7b, 0x3f, 0x82, 0x74, 0x85, 0x84, 0x63, 0xe8, 0x34, 0x57,
+  0xd4, 0xc7, 0xad, 0x39, 0x02, 0x7c, 0x8c, 0x75, 0x28, 0x10, 0x98, 0xa0, 0x47, 0x2b, 0xa3, 0xca,
+  0x05, 0x63, 0x4a, 0x71, 0xac, 0x6f, 0xee, 0xc8, 0x7e, 0x5a, 0xbc, 0xcf, 0xb2, 0x2f, 0x67, 0xd9,
+  0xcf, 0x8a, 0x7b, 0x22, 0xad, 0x22, 0x6d, 0x0a, 0xb5, 0x94, 0xb0, 0x77, 0xd0, 0xe2, 0xff, 0xf0,
+  0x35, 0xee, 0xe2, 0xc9, 0xeb, 0x57, 0xdf, 0x80, 0x55, 0xc5, 0x73, 0x69, 0x53, 0xad, 0x70, 0xa9,
+  0x64, 0xb3, 0xaa, 0x5e, 0x48, 0x1b, 0xd3, 0x14, 0xaa, 0x3b, 0x67, 0x27, 0x03, 0xe8, 0x07, 0x72,
+  0x48, 0x90, 0x0c, 0xc4, 0x19, 0x96, 0x94, 0x9f, 0xdd, 0x83, 0x21, 0xdd, 0x66, 0xcc, 0xb2, 0x63,
+  0x99, 0xb6, 0x43, 0x93, 0x62, 0x5a, 0x30, 0xc5, 0x87, 0xcb, 0x25, 0x13, 0x5e, 0x4c, 0x7c, 0xa0,
+  0xb7, 0xa8, 0xe3, 0x74, 0x0b, 0xa9, 0xaf, 0x2a, 0xbe, 0xb4, 0x69, 0xe7, 0x34, 0x8d, 0xb8, 0x8c,
+  0x84, 0x43, 0x54, 0x8d, 0xee, 0x48, 0x95, 0xe9, 0x6c, 0xe6, 0xc8, 0x7a, 0x2e, 0x8e, 0x84, 0x56,
+  0x36, 0xb9, 0xe5, 0x3b, 0x29, 0x0d, 0x23, 0x3b, 0x8a, 0x63, 0xbd, 0x76, 0xf7, 0x46, 0x55, 0x6d,
+  0x32, 0x23, 0xbb, 0x1f, 0x2a, 0xa2, 0xe0, 0xe8, 0xf4, 0x5c, 0xdd, 0x33, 0xa2, 0x1c, 0xd9, 0xe4,
+  0x08, 0xfe, 0x91, 0x39, 0x55, 0x8b, 0xfc, 0x4d, 0xc4, 0xf9, 0xbb, 0x9c, 0x85, 0xea, 0xa8, 0x37,
+  0x91, 0x3c, 0x06, 0xda, 0x5a, 0xc1, 0xa6, 0x46, 0xdd, 0x78, 0x82, 0x46, 0x65, 0xab, 0x3c, 0x5e,
+  0x19, 0xd9, 0x49, 0x28, 0xc5, 0x88, 0x3f, 0x89, 0xa1, 0x86, 0xd5, 0x49, 0xbd, 0x5e, 0xd5, 0xf0,
+  0x0a, 0x1a, 0x31, 0x0e, 0x1c, 0xf8, 0xaa, 0xbe, 0x22, 0x27, 0x57, 0x7e, 0xfd, 0xf2, 0x61, 0xdc,
+  0x9f, 0xa5, 0x89, 0x50, 0x37, 0x75, 0x56, 0x1b, 0x6e, 0xa6, 0xa2, 0x51, 0x36, 0x66, 0x55, 0xd5,
+  0xe3, 0xb1, 0xef, 0xf2, 0xeb, 0x2a, 0x7d, 0x65, 0xca, 0x31, 0x98, 0x63, 0xdc, 0x51, 0xbb, 0x3b,
+  0xce, 0x36, 0xb1, 0x51, 0xb8, 0x41, 0x5f, 0x47, 0x14, 0x41, 0x64, 0x83, 0xd3, 0xc2, 0xd3, 0x50,
+  0xef, 0x59, 0x73, 0x97, 0xcd, 0x58, 0xb4, 0x70, 0x55, 0xcd, 0x4f, 0x67, 0x2e, 0x4e, 0x0f, 0x3c,
+  0x8b, 0x24, 0xd1, 0xc1, 0x3c, 0xd4, 0x74, 0x9c, 0x59, 0xa4, 0x40, 0x6d, 0x95, 0x10, 0xa0, 0xa6,
+  0x4e, 0xea, 0x0b, 0x5d, 0x8a, 0xa4, 0x6a, 0x7c, 0xb5, 0x7d, 0x8f, 0x4c, 0xdc, 0xce, 0x09, 0xc7,
+  0xa3, 0x1d, 0xac, 0xb8, 0x94, 0x7c, 0xb0, 0x16, 0xc2, 0xba, 0xfd, 0xd9, 0xd9, 0xf1, 0x3e, 0xb6,
+  0x2b, 0xa8, 0x3e, 0x5f, 0x56, 0xe8, 0xbc, 0x3a, 0x87, 0x3f, 0x9d, 0xde, 0x65, 0x14, 0x8c, 0x6f,
+  0x43, 0x3f, 0x5d, 0x57, 0xe4, 0xb8, 0xf5, 0xfe, 0xce, 0x58, 0xe1, 0x1e, 0x4f, 0x23, 0x29, 0x9b,
+  0x4f, 0x21, 0x36, 0xb4, 0xae, 0xec, 0xb5, 0x3e, 0x7b, 0xa1, 0x92, 0xde, 0x0b, 0x2c, 0x5b, 0xd1,
+  0x72, 0xb0, 0xae, 0xaa, 0x44, 0x64, 0x6b, 0x91, 0xb2, 0xa2, 0x4a, 0xd5, 0xec, 0xa9, 0x48, 0xf8,
+  0x66, 0x27, 0x5c, 0x9c, 0x3f, 0x09, 0x40, 0x6a, 0xe0, 0x05, 0x2a, 0x4b, 0x87, 0x52, 0xb7, 0x92,
+  0xd9, 0xef, 0xff, 0x10, 0x74, 0xce, 0x0f, 0xe5, 0x6e, 0x23, 0x92, 0x6e, 0xff, 0x10, 0x54, 0xce,
+  0x4f, 0xe2, 0x6e, 0xa3, 0x32, 0x4e, 0x21, 0xff, 0xdf, 0xe9, 0x9c, 0x1a, 0x80, 0x28, 0xe8, 0x29,
+  0x85, 0xe6, 0x44, 0xb5, 0x2e, 0x77, 0xa7, 0x4c, 0xbb, 0x50, 0x12, 0x79, 0x06, 0x25, 0x56, 0xc3,
+  0x9e, 0x90, 0x95, 0x34, 0xf9, 0x65, 0xad, 0x1c, 0x26, 0x99, 0xea, 0x87, 0x8d, 0x8f, 0xd3, 0xe3,
+  0x8f, 0xd0, 0xe4, 0x3f, 0xac, 0x7f, 0xdc, 0xbe, 0x9d, 0xbb, 0x99, 0xd1, 0xcb, 0x34, 0x83, 0x69,
+  0x9a, 0x4d, 0x27, 0x56, 0xcb, 0xe4, 0x89, 0x44, 0x08, 0x86, 0xf4, 0xe5, 0x74, 0x6a, 0xb5, 0xac,
+  0xa7, 0x56, 0xcb, 0xa6, 0xa9, 0x5b, 0x4e, 0xbb, 0xf4, 0xf4, 0x9b, 0x7e, 0xe2, 0x6c, 0xd5, 0xc5,
+  0x28, 0x6d, 0x9a, 0x43, 0xfd, 0x07, 0x21, 0xcb, 0xd4, 0xb8, 0xfd, 0x11, 0x74, 0x47, 0x4a, 0xb3,
+  0x4b, 0xd5, 0x8a, 0x67, 0x6d, 0x5c, 0xf6, 0x0d, 0x02, 0x53, 0x73, 0x87, 0x4e, 0x3c, 0xa2, 0xf9,
+  0xf6, 0x0c, 0x06, 0x9a, 0x03, 0x2c, 0x77, 0x0b, 0x34, 0x75, 0x6a, 0xea, 0x5e, 0xd7, 0x6a, 0x3f,
+  0xbc, 0x39, 0x48, 0x79, 0x6e, 0xd8, 0x86, 0x38, 0x6a, 0x05, 0x3c, 0xe1, 0x5f, 0xe6, 0x9d, 0x40,
+  0x46, 0x26, 0x91, 0xd6, 0xc4, 0x7b, 0xe9, 0x2c, 0x20, 0x1b, 0xe3, 0x14, 0xa7, 0x40, 0x74, 0xa9,
+  0x65, 0xc3, 0x69, 0xda, 0xf8, 0x63, 0x19, 0x4d, 0x77, 0x55, 0x50, 0xee, 0x05, 0xd7, 0x7a, 0x48,
+  0x64, 0xe5, 0x76, 0x64, 0x1a, 0x4a, 0xdd, 0x27, 0x02, 0xf3, 0xe3, 0x31, 0x8f, 0x62, 0x03, 0xde,
+  0x45, 0xd0, 0x6a, 0x44, 0xc1, 0xc6, 0xd8, 0xa4, 0xd2, 0x3c, 0x81, 0x5f, 0x9b, 0xf6, 0xb0, 0x00,
+  0x3a, 0x6f, 0xab, 0x73, 0xa3, 0x1c, 0x33, 0x21, 0x8f, 0x82, 0x48, 0x4f, 0x5b, 0x2a, 0x61, 0x14,
+  0x5c, 0x09, 0x97, 0x47, 0x2b, 0x28, 0x23, 0x9f, 0x4f, 0x1b, 0xa9, 0xa4, 0x2b, 0xc6, 0x7d, 0x76,
+  0xd2, 0x8b, 0x2a, 0x06, 0xa7, 0x8b, 0x5b, 0x2c, 0x17, 0x3b, 0xe6, 0xc4, 0x2b, 0x94, 0x59, 0xe9,
+  0xda, 0x7c, 0xc0, 0x92, 0x4e, 0x8c, 0x2a, 0x55, 0xad, 0x1e, 0x6a, 0x2d, 0xd2, 0x73, 0x4c, 0xe4,
+  0x21, 0xb6, 0xc8, 0x54, 0xba, 0x55, 0x55, 0x06, 0xc3, 0x12, 0x22, 0x48, 0x64, 0x45, 0x97, 0x06,
+  0xb7, 0x12, 0xbf, 0xa2, 0xcb, 0x0c, 0x0d, 0x13, 0xd3, 0x21, 0x57, 0xdb, 0x06, 0x72, 0xb5, 0xcc,
+  0x3f, 0xe7, 0xc7, 0x53, 0x85, 0x1e, 0xc5, 0xf8, 0xd9, 0x22, 0xd3, 0x29, 0x4e, 0xd8, 0x4c, 0xc6,
+  0x2a, 0x30, 0x45, 0x2c, 0x21, 0x80, 0xb4, 0xf1, 0x33, 0x4b, 0xb4, 0x2f, 0xc7, 0x4b, 0x5c, 0x1e,
+  0x57, 0x2c, 0x35, 0x71, 0xb3, 0xaa, 0xe9, 0x85, 0x87, 0x36, 0xb0, 0x66, 0x8e, 0x46, 0x15, 0xaf,
+  0x32, 0x8a, 0x82, 0x25, 0xd0, 0x5e, 0x1f, 0xcb, 0x2a, 0xa5, 0xc6, 0x58, 0x55, 0x44, 0x06, 0xd5,
+  0x6c, 0x14, 0x42, 0xca, 0x76, 0xf0, 0x67, 0x51, 0x6a, 0x27, 0x3e, 0xaa, 0xe6, 0x29, 0xc0, 0x5d,
+  0x83, 0xd5, 0x77, 0xe0, 0x4a, 0xc5, 0xb6, 0x88, 0xab, 0xb1, 0x65, 0xa5, 0xf6, 0x91, 0x5f, 0x1b,
+  0x60, 0xfd, 0x49, 0xde, 0x63, 0x55, 0xdb, 0x05, 0xd8, 0x24, 0x54, 0x1d, 0x06, 0x69, 0x6a, 0x15,
+  0x3f, 0x17, 0x18, 0x66, 0x51, 0x20, 0x29, 0xf3, 0x24, 0xdc, 0x69, 0x7b, 0x29, 0x74, 0x34, 0xb3,
+  0xe6, 0x59, 0x84, 0x59, 0x30, 0xc5, 0x00, 0x6b, 0xb5, 0x99, 0x1b, 0x70, 0x2f, 0x93, 0x30, 0xf3,
+  0x97, 0x3b, 0x02, 0x78, 0xe3, 0xac, 0x22, 0x9b, 0x50, 0xd3, 0x84, 0x2e, 0x8b, 0x32, 0x6f, 0xc1,
+  0x07, 0x41, 0x02, 0x0e, 0xc3, 0xfc, 0x1d, 0x8c, 0x21, 0x89, 0xf5, 0x28, 0x39, 0xcd, 0x0a, 0xba,
+  0x7a, 0xb2, 0xb3, 0x69, 0xf6, 0x0c, 0x39, 0x37, 0xda, 0x55, 0x5e, 0x7e, 0x3f, 0x34, 0x7e, 0xf1,
+  0x29, 0x1c, 0x61, 0xbb, 0xa3, 0x07, 0xaa, 0x69, 0x48, 0x9a, 0xf9, 0x12, 0x41, 0x19, 0x6a, 0xc1,
+  0x32, 0xd5, 0x10, 0x38, 0x06, 0x86, 0xa1, 0x3f, 0x46, 0xbd, 0x79, 0x7c, 0x95, 0x58, 0xd0, 0x96,
+  0x1c, 0xa2, 0x40, 0xe1, 0xe7, 0x09, 0x86, 0x5f, 0x0f, 0xbb, 0xd9, 0xb8, 0x98, 0x19, 0xd8, 0x80,
+  0x09, 0xdf, 0x9e, 0xe5, 0xa6, 0xb0, 0xba, 0x29, 0x58, 0x4b, 0xfa, 0x79, 0x86, 0xdb, 0xef, 0x92,
+  0x18, 0x40, 0xb3, 0x7b, 0x48, 0xbd, 0xcb, 0x96, 0x8a, 0xd4, 0x34, 0xfa, 0xc5, 0x7e, 0x29, 0xf1,
+  0x5c, 0x0a, 0x21, 0xd8, 0xf6, 0xf9, 0xb0, 0xac, 0xfc, 0x7c, 0x19, 0xa3, 0x3e, 0xd6, 0xf2, 0x88,
+  0x78, 0xc4, 0x2e, 0x91, 0x4b, 0xea, 0xe9, 0x27, 0x41, 0xf2, 0x11, 0x5a, 0x8c, 0x9a, 0x03, 0x93,
+  0xab, 0x92, 0xca, 0xfa, 0x09, 0xe6, 0xb6, 0xa9, 0x2f, 0x0e, 0xd4, 0x24, 0xd9, 0x68, 0x32, 0xe5,
+  0x95, 0x78, 0x9c, 0xe2, 0xe3, 0x61, 0xba, 0x32, 0x14, 0xe5, 0xdf, 0x3d, 0x2c, 0x44, 0x6c, 0x86,
+  0x4d, 0x37, 0x4b, 0x33, 0x03, 0x9d, 0x36, 0x7d, 0x9d, 0x6f, 0xa6, 0x9f, 0x9d, 0x9a, 0xf9, 0x13,
+  0xad, 0x9a, 0xfe, 0x0b, 0xd6, 0xff, 0x02, 0x1a, 0x86, 0x24, 0x16, 0xd9, 0x2a, 0x00, 0x00,
+};
+
+// msgraph_auth.html: 3143 bytes, 1377 gzipped
+static const uint8_t asset_msgraph_auth_html[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xa5, 0x57, 0xdb, 0x6e, 0xdb, 0x46,
+  0x10, 0x7d, 0xd7, 0x57, 0x4c, 0x60, 0xb4, 0x94, 0x01, 0x8b, 0x92, 0xe5, 0x4b, 0x0d, 0xea, 0x52,
+  0x38, 0x4e, 0x5a, 0x18, 0x48, 0xd0, 0x20, 0x71, 0x5a, 0x04, 0x45, 0x61, 0xac, 0xb8, 0x4b, 0x71,
+  0xa1, 0xe5, 0x2e, 0xb1, 0xbb, 0xb4, 0xac, 0x18, 0xfa, 0x8a, 0xbe, 0xf6, 0xeb, 0xfa, 0x25, 0x9d,
+  0x59, 0x92, 0xba, 0xc4, 0xae, 0x13, 0x20, 0x30, 0x2c, 0xca, 0x7b, 0x99, 0x39, 0x33, 0x73, 0xce,
+  0x0c, 0x3d, 0x7e, 0xf1, 0xea, 0xb7, 0xab, 0x9b, 0x4f, 0xef, 0x5e, 0x43, 0xee, 0x0b, 0x35, 0xed,
+  0x8c, 0xc3, 0x63, 0x9c, 0x0b, 0xc6, 0xa7, 0x63, 0x2f, 0xbd, 0x12, 0xd3, 0xb7, 0x32, 0xb5, 0xc6,
+  0x99, 0xcc, 0xc3, 0xaf, 0x96, 0x95, 0x39, 0x5c, 0x56, 0x3e, 0x37, 0x56, 0x7e, 0x66, 0x5e, 0x1a,
+  0x3d, 0xee, 0xd7, 0x87, 0x3a, 0x63, 0xe7, 0x57, 0xf4, 0x9c, 0x19, 0xbe, 0x7a, 0xc8, 0x8c, 0xf6,
+  0xbd, 0x8c, 0x15, 0x52, 0xad, 0x92, 0x4b, 0x2b, 0x99, 0x3a, 0x72, 0x4c, 0xbb, 0x9e, 0x13, 0x56,
+  0x66, 0xa3, 0x82, 0xd9, 0xb9, 0xd4, 0xc9, 0x70, 0x50, 0xde, 0x8f, 0x66, 0x2c, 0x5d, 0xcc, 0xad,
+  0xa9, 0x34, 0x4f, 0x0e, 0x86, 0xc3, 0xe1, 0x28, 0x35, 0xca, 0xd8, 0xe4, 0x20, 0xcb, 0xb2, 0x91,
+  0x92, 0x5a, 0xf4, 0x72, 0x21, 0xe7, 0xb9, 0x4f, 0x8e, 0xe3, 0xb3, 0xd1, 0xba, 0x93, 0x1f, 0x1f,
+  0xe5, 0xc3, 0x87, 0xe6, 0xc8, 0x60, 0xf0, 0xd3, 0x05, 0x3f, 0x1d, 0xad, 0x81, 0x3d, 0x5a, 0x89,
+  0x67, 0x5e, 0x3f, 0xec, 0x5a, 0x6e, 0x76, 0x76, 0x8c, 0x97, 0x8c, 0x73, 0xa9, 0xe7, 0xc9, 0x31,
+  0x82, 0x80, 0x1a, 0x89, 0xb1, 0x5c, 0xd8, 0x44, 0x1b, 0x2d, 0x9a, 0xef, 0x3d, 0xcb, 0xb8, 0xac,
+  0x5c, 0x72, 0x8a, 0xbb, 0x5e, 0xdc, 0xfb, 0x1e, 0x17, 0xa9, 0xb1, 0x21, 0xea, 0xfa, 0x18, 0x97,
+  0xae, 0x54, 0x6c, 0x95, 0x48, 0x1d, 0xb0, 0xce, 0x94, 0x49, 0x17, 0x6d, 0x74, 0xc1, 0xf0, 0x00,
+  0x41, 0xc7, 0x29, 0xe6, 0x82, 0xe1, 0xbe, 0x7d, 0x28, 0xd8, 0x7d, 0x6f, 0x29, 0xb9, 0xcf, 0x93,
+  0x8b, 0x01, 0xb9, 0x6c, 0x8e, 0x0e, 0x80, 0x55, 0xde, 0xec, 0xa5, 0xe2, 0xe4, 0xe4, 0x64, 0x03,
+  0x71, 0x07, 0x5d, 0x8b, 0xe8, 0x22, 0xac, 0xdc, 0xf7, 0x5c, 0xce, 0xb8, 0x59, 0xa2, 0x81, 0x01,
+  0x04, 0x7f, 0x76, 0x3e, 0x63, 0xdd, 0xc1, 0x51, 0xf8, 0x89, 0xcf, 0x0e, 0x6b, 0xef, 0x1c, 0x91,
+  0x99, 0xfb, 0xbd, 0x7c, 0x9c, 0x9e, 0x9e, 0xb6, 0xf1, 0x1e, 0xe3, 0x35, 0x67, 0x94, 0xe4, 0x70,
+  0x70, 0x7e, 0x7e, 0xbe, 0xcd, 0xcb, 0xd9, 0x16, 0x5f, 0x13, 0xca, 0xe3, 0xa4, 0x2c, 0x71, 0xa5,
+  0x37, 0xb3, 0x82, 0x2d, 0x92, 0xf0, 0xd9, 0x63, 0x4a, 0x8d, 0x76, 0x4b, 0x5f, 0x18, 0x6d, 0x5c,
+  0xc9, 0x52, 0xd1, 0xa6, 0xfe, 0xf4, 0xea, 0xf2, 0x97, 0xb3, 0x90, 0x15, 0xe7, 0x45, 0xf9, 0x50,
+  0x3b, 0x40, 0x78, 0xde, 0x9b, 0x62, 0x2f, 0x50, 0x25, 0x32, 0x4f, 0x3e, 0x5a, 0x6c, 0x4d, 0x05,
+  0x1b, 0x78, 0xf5, 0x76, 0xc0, 0xb8, 0xee, 0x48, 0x5d, 0x56, 0xfe, 0x4f, 0xbf, 0x2a, 0xc5, 0x84,
+  0xaa, 0xf4, 0xd7, 0xa3, 0x48, 0x9f, 0x28, 0xfb, 0xc5, 0xb6, 0xe0, 0x5f, 0x24, 0xa0, 0xad, 0xcf,
+  0x0f, 0x4f, 0xc4, 0xbb, 0xee, 0x8c, 0xfb, 0x0d, 0xcb, 0xc7, 0x2e, 0xb5, 0xb2, 0xf4, 0xd3, 0x4e,
+  0xbf, 0x0f, 0x37, 0xb9, 0x00, 0x27, 0xe7, 0xba, 0x27, 0x35, 0x20, 0x11, 0x16, 0x90, 0x32, 0x6b,
+  0xa5, 0x70, 0xe0, 0x71, 0x83, 0x95, 0x65, 0xe4, 0x20, 0x55, 0x52, 0x68, 0x0f, 0x92, 0x1f, 0xa1,
+  0xaf, 0xb0, 0xce, 0xc5, 0x9d, 0x4c, 0x05, 0x64, 0x52, 0x29, 0x07, 0x12, 0xb7, 0x74, 0x27, 0xab,
+  0x74, 0x4a, 0xe4, 0x02, 0x65, 0x18, 0x27, 0x91, 0x7d, 0x7c, 0xff, 0xa6, 0x7b, 0x08, 0x0f, 0x1d,
+  0x80, 0x4c, 0xf8, 0x34, 0xef, 0x46, 0xfd, 0xc2, 0xcd, 0x49, 0x82, 0xb7, 0x48, 0x98, 0xfc, 0xb6,
+  0xb2, 0x2a, 0x3a, 0x8c, 0xd1, 0x98, 0xee, 0x5a, 0x98, 0x4c, 0xc1, 0xc6, 0x14, 0x7f, 0xf7, 0xb0,
+  0x59, 0xc3, 0x6d, 0x5a, 0xa5, 0xeb, 0x00, 0xdc, 0xa4, 0x55, 0x81, 0x10, 0xe2, 0xb9, 0xf0, 0xaf,
+  0x95, 0xa0, 0xaf, 0x2f, 0x57, 0xd7, 0xbc, 0x1b, 0x11, 0xf0, 0x6b, 0x8d, 0x76, 0x72, 0x2b, 0x32,
+  0x98, 0x00, 0xde, 0x8a, 0xbd, 0x95, 0x45, 0xf7, 0x70, 0x84, 0x17, 0xd7, 0xf8, 0xb9, 0xde, 0x02,
+  0x43, 0xf3, 0x96, 0xa5, 0xfe, 0x52, 0xf3, 0x0f, 0xd5, 0xac, 0x90, 0xbe, 0x41, 0x87, 0x0c, 0x77,
+  0x1e, 0x82, 0x3f, 0xd0, 0x62, 0x09, 0x84, 0x7b, 0x29, 0x35, 0x52, 0x33, 0x46, 0x49, 0x04, 0xc1,
+  0x04, 0xf3, 0xc1, 0x64, 0x7d, 0x98, 0x68, 0xd9, 0x78, 0x73, 0x82, 0xd9, 0x34, 0x7f, 0xc7, 0x2c,
+  0x2b, 0x1c, 0xc1, 0xeb, 0x46, 0xb4, 0x19, 0x85, 0xc3, 0x32, 0x83, 0x2e, 0xfd, 0x75, 0xf8, 0xb5,
+  0x30, 0xe8, 0xd0, 0xef, 0x4c, 0x55, 0x78, 0x2f, 0x96, 0x1a, 0xc5, 0x76, 0x83, 0x58, 0xd1, 0x01,
+  0xad, 0x8f, 0x9e, 0xbf, 0xda, 0x04, 0x25, 0xf8, 0x55, 0x70, 0x1b, 0x87, 0x0a, 0xc7, 0x8d, 0xb6,
+  0xd1, 0x44, 0x14, 0x74, 0x1d, 0x8d, 0xbe, 0x0e, 0xe0, 0x9a, 0x98, 0x88, 0x16, 0xee, 0x08, 0xc8,
+  0xb7, 0x39, 0x27, 0xe5, 0xd7, 0xb9, 0x7c, 0xde, 0xf3, 0xba, 0x13, 0xc8, 0xd7, 0x90, 0x6e, 0xdc,
+  0xaf, 0xfb, 0x33, 0xf5, 0x5a, 0x30, 0x9a, 0xf8, 0x32, 0x89, 0xf6, 0x58, 0x33, 0x7a, 0xa2, 0x56,
+  0x11, 0x5e, 0xe4, 0xf2, 0x0e, 0xc9, 0xc8, 0x9c, 0x9b, 0x44, 0x9b, 0xbe, 0x44, 0xeb, 0xf9, 0xf1,
+  0x4e, 0x9b, 0xbf, 0x11, 0x58, 0x0a, 0x78, 0x67, 0x85, 0x13, 0x1a, 0x39, 0xfa, 0x45, 0xbf, 0xc7,
+  0xa3, 0x7b, 0x76, 0x48, 0xc9, 0xc1, 0xc4, 0x70, 0xfa, 0x01, 0xbf, 0xc2, 0x71, 0x02, 0x1f, 0x90,
+  0x54, 0xc8, 0x68, 0x58, 0x4a, 0x9f, 0xc3, 0xc6, 0x2e, 0x5e, 0x1d, 0xe2, 0xb9, 0x72, 0x7a, 0xa5,
+  0x64, 0xba, 0x08, 0x2a, 0x98, 0x55, 0xa8, 0x7c, 0x0d, 0x33, 0xa1, 0xcc, 0x12, 0xbc, 0x09, 0x32,
+  0xda, 0x5c, 0x5c, 0x99, 0xca, 0x6e, 0x6f, 0x03, 0x4b, 0x53, 0xd4, 0x34, 0x3e, 0x35, 0xa7, 0x86,
+  0x19, 0x20, 0x09, 0x5a, 0x15, 0xce, 0xd1, 0xdd, 0x70, 0xbc, 0x86, 0x5e, 0x36, 0xd0, 0x93, 0x71,
+  0xbf, 0x44, 0x8f, 0x0c, 0x85, 0x37, 0x69, 0x99, 0x0e, 0xc4, 0xc4, 0x49, 0x74, 0x10, 0x81, 0xc7,
+  0xee, 0x23, 0xfc, 0x24, 0xba, 0x9d, 0x29, 0xa6, 0x17, 0x51, 0x1b, 0x0f, 0x0e, 0x8f, 0x68, 0xfa,
+  0x7f, 0x11, 0x30, 0x4a, 0x3e, 0x06, 0xff, 0x7c, 0x0a, 0x86, 0x09, 0x5c, 0x66, 0x5e, 0xd8, 0x0d,
+  0xce, 0x36, 0x75, 0x75, 0xfc, 0xf5, 0x1e, 0xe1, 0xc1, 0x5e, 0x84, 0x5e, 0x8e, 0x08, 0x7b, 0xa4,
+  0x14, 0xe6, 0x01, 0xac, 0xe0, 0xd2, 0x0a, 0xa2, 0x23, 0xc5, 0xc4, 0x00, 0xc7, 0xaa, 0x35, 0x7a,
+  0x3e, 0x0d, 0x18, 0xa1, 0x64, 0x73, 0x41, 0x3d, 0x28, 0x2c, 0xd5, 0xe0, 0x18, 0xc9, 0x0d, 0x93,
+  0xc9, 0x48, 0x54, 0xa1, 0xa2, 0xae, 0x4e, 0xc5, 0x9e, 0xef, 0xc0, 0xc5, 0xb8, 0x4e, 0x47, 0x39,
+  0x7d, 0x63, 0xcc, 0x02, 0xf0, 0x42, 0x38, 0x37, 0xb3, 0x66, 0x89, 0x83, 0x19, 0xbb, 0x14, 0x36,
+  0x47, 0x4b, 0xc9, 0x9c, 0x31, 0x0b, 0x3d, 0x6a, 0x4a, 0x2e, 0x37, 0x95, 0xe2, 0xd8, 0x8f, 0xf0,
+  0xb8, 0x33, 0x85, 0xf0, 0x39, 0x01, 0x56, 0x72, 0x21, 0xd0, 0xa1, 0x74, 0x4d, 0x7a, 0xf7, 0x38,
+  0x55, 0x4f, 0x9b, 0x68, 0x9a, 0x7b, 0x5f, 0xba, 0xa4, 0xdf, 0x57, 0x06, 0x3b, 0x7c, 0x5c, 0xb4,
+  0x19, 0x34, 0x61, 0x54, 0xe2, 0x54, 0x2a, 0xfa, 0xf8, 0x8b, 0xf3, 0xa1, 0x6f, 0x08, 0xe7, 0xb0,
+  0xaf, 0x11, 0xe6, 0x9d, 0xa8, 0xfb, 0xe4, 0xcf, 0x6d, 0xd0, 0x64, 0x6e, 0xf2, 0x36, 0x7e, 0x7f,
+  0x72, 0xfb, 0xf2, 0xf2, 0x53, 0x1c, 0xc7, 0x9b, 0xd0, 0x7f, 0x74, 0x9e, 0x79, 0x31, 0x39, 0x1e,
+  0x9e, 0x9c, 0x9e, 0xb5, 0xf5, 0xd8, 0x29, 0x0b, 0x95, 0x7b, 0x5f, 0xd6, 0x10, 0xb4, 0x35, 0x89,
+  0xda, 0x91, 0x1d, 0xe6, 0x77, 0xf4, 0x44, 0xfd, 0xfe, 0xfd, 0xe7, 0x6f, 0xa0, 0x1b, 0xd8, 0xa0,
+  0x7d, 0x28, 0xc3, 0x8b, 0x4d, 0xd9, 0xfe, 0x10, 0xd1, 0xdd, 0x76, 0x1d, 0x79, 0xf8, 0x44, 0x8a,
+  0x89, 0x33, 0x21, 0xab, 0x69, 0x65, 0x2d, 0xb5, 0x7c, 0x2c, 0xce, 0x33, 0x69, 0x0a, 0x48, 0xb7,
+  0xbd, 0x6b, 0xda, 0x06, 0x51, 0x86, 0x8d, 0x9d, 0xe6, 0xf0, 0x8c, 0x66, 0x2a, 0x57, 0x57, 0x23,
+  0xf8, 0x6f, 0x7c, 0x65, 0xc6, 0x16, 0x28, 0x0d, 0x82, 0x35, 0xd9, 0x4e, 0x8d, 0xd0, 0x57, 0x81,
+  0xca, 0x68, 0xd0, 0x3a, 0x72, 0x9f, 0x62, 0x0e, 0xe3, 0x13, 0xc2, 0xf8, 0x8c, 0x72, 0xc9, 0xb9,
+  0xd0, 0x5b, 0x54, 0x75, 0x43, 0x03, 0xcd, 0x0a, 0x51, 0x2f, 0x7c, 0x79, 0xc1, 0xd5, 0xe8, 0x20,
+  0x74, 0xbc, 0x49, 0xf4, 0x71, 0x17, 0xca, 0xbe, 0xa0, 0xb0, 0x3e, 0x04, 0xea, 0x9b, 0xe4, 0x73,
+  0x92, 0xc0, 0x5b, 0xa6, 0x2b, 0xa6, 0x00, 0x33, 0x68, 0x57, 0x9b, 0x02, 0x5c, 0x67, 0xe1, 0x4d,
+  0xa9, 0xc0, 0x74, 0xa7, 0x4d, 0x1d, 0x28, 0xef, 0xdc, 0x08, 0xa7, 0x23, 0x0f, 0xf8, 0x3a, 0xb2,
+  0x38, 0x42, 0xd7, 0xe5, 0x2a, 0xe4, 0xa9, 0x25, 0x11, 0xda, 0x40, 0x45, 0x51, 0x21, 0xb6, 0xca,
+  0xc9, 0xac, 0x29, 0x9e, 0x63, 0x3f, 0x7b, 0xac, 0xde, 0xef, 0xcb, 0x2c, 0x4d, 0xe6, 0x36, 0x91,
+  0x34, 0xb7, 0x51, 0xfd, 0x9f, 0xf1, 0xeb, 0xf9, 0x20, 0x02, 0xe4, 0x63, 0x2a, 0x72, 0xa3, 0xf0,
+  0x65, 0x03, 0x2b, 0xf0, 0x3d, 0xb2, 0x09, 0x72, 0x41, 0x99, 0x7c, 0xa5, 0x4a, 0x0d, 0xa5, 0x76,
+  0xcb, 0xd3, 0xca, 0xa3, 0x79, 0x21, 0xab, 0x5f, 0xaf, 0xe8, 0x75, 0xec, 0x89, 0xc2, 0xb5, 0x0f,
+  0x1a, 0x3e, 0x48, 0xd8, 0xfa, 0xdf, 0x86, 0xff, 0x00, 0xd8, 0xcc, 0xe2, 0x2d, 0x47, 0x0c, 0x00,
+  0x00,
+};
+
+// msgraph_code.html: 2949 bytes, 1335 gzipped
+static const uint8_t asset_msgraph_code_html[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xb5, 0x56, 0x4d, 0x8f, 0xdb, 0x36,
+  0x10, 0xbd, 0xfb, 0x57, 0x4c, 0x90, 0x83, 0x6c, 0x60, 0x2d, 0xdb, 0xbb, 0x9b, 0x34, 0x90, 0x3f,
+  0x82, 0xed, 0x36, 0x1b, 0x14, 0x68, 0x9b, 0x45, 0xe2, 0xa0, 0xc8, 0x29, 0xa0, 0xc5, 0x91, 0x45,
+  0x98, 0x22, 0x55, 0x92, 0x5a, 0xad, 0xbb, 0xf0, 0xaf, 0xe8, 0xa1, 0x97, 0xfe, 0xba, 0xfe, 0x92,
+  0x0e, 0x29, 0xc9, 0x6b, 0x6f, 0x8c, 0x04, 0x39, 0xf4, 0xb2, 0x5a, 0x8b, 0x9c, 0xc7, 0x37, 0x6f,
+  0x66, 0x1e, 0x35, 0x7b, 0xf6, 0xd3, 0xbb, 0xeb, 0xe5, 0xa7, 0xdb, 0x37, 0x90, 0xbb, 0x42, 0x2e,
+  0x7a, 0xb3, 0xf0, 0x98, 0xe5, 0xc8, 0xf8, 0x62, 0xe6, 0x84, 0x93, 0xb8, 0xf8, 0x55, 0xa4, 0x46,
+  0x5b, 0x9d, 0x39, 0x78, 0x6b, 0x58, 0x99, 0xc3, 0x55, 0xe5, 0x72, 0x6d, 0xc4, 0x9f, 0xcc, 0x09,
+  0xad, 0x66, 0xa3, 0x66, 0x53, 0x6f, 0x66, 0xdd, 0xd6, 0x3f, 0x57, 0x9a, 0x6f, 0x1f, 0x32, 0xad,
+  0xdc, 0x30, 0x63, 0x85, 0x90, 0xdb, 0xe4, 0xca, 0x08, 0x26, 0xcf, 0x2c, 0x53, 0x76, 0x68, 0xd1,
+  0x88, 0x6c, 0x5a, 0x30, 0xb3, 0x16, 0x2a, 0x39, 0x1f, 0x97, 0xf7, 0xd3, 0x15, 0x4b, 0x37, 0x6b,
+  0xa3, 0x2b, 0xc5, 0x93, 0xe7, 0xe7, 0xe7, 0xe7, 0xd3, 0x54, 0x4b, 0x6d, 0x92, 0xe7, 0x59, 0x96,
+  0x4d, 0xa5, 0x50, 0x38, 0xcc, 0x51, 0xac, 0x73, 0x97, 0x4c, 0xe2, 0x17, 0xd3, 0x5d, 0x2f, 0x9f,
+  0x3c, 0xb4, 0xeb, 0xe3, 0xf1, 0x0f, 0xaf, 0xf8, 0xe5, 0x74, 0x07, 0x71, 0x4a, 0x27, 0x31, 0xda,
+  0x69, 0x1e, 0x0a, 0x76, 0x3f, 0xac, 0x05, 0x77, 0x79, 0xf2, 0x72, 0xec, 0xa1, 0xdb, 0x63, 0xc6,
+  0xc0, 0x2a, 0xa7, 0x8f, 0x0e, 0xba, 0xb8, 0xb8, 0x98, 0x96, 0x8c, 0x73, 0xa1, 0xd6, 0x2d, 0x0b,
+  0x6d, 0x38, 0x9a, 0xa1, 0x61, 0x5c, 0x54, 0x36, 0x79, 0x45, 0x6f, 0x76, 0xbd, 0xd8, 0x56, 0x69,
+  0x8a, 0xd6, 0x76, 0x47, 0x5e, 0x5e, 0x5f, 0xdd, 0xbc, 0x18, 0x4f, 0x43, 0x66, 0x75, 0xc3, 0x6a,
+  0xa5, 0x25, 0xf7, 0x1c, 0xd0, 0x18, 0x6d, 0xba, 0x7d, 0x37, 0x97, 0x97, 0x17, 0x17, 0x2f, 0x4f,
+  0xec, 0xeb, 0xc5, 0x2b, 0xa7, 0x1e, 0x0e, 0x79, 0xb4, 0x59, 0x1c, 0xe4, 0xdc, 0xb1, 0x9a, 0x10,
+  0x2b, 0x08, 0xd4, 0x1c, 0xde, 0xbb, 0x21, 0xc7, 0x54, 0x9b, 0x20, 0x77, 0xa2, 0xb4, 0xc2, 0x29,
+  0x17, 0xb6, 0x94, 0x6c, 0x9b, 0x08, 0x15, 0x44, 0x5a, 0x49, 0x9d, 0x6e, 0x9e, 0x24, 0x71, 0xb9,
+  0x57, 0x60, 0xe8, 0x74, 0x99, 0x4c, 0x5e, 0x34, 0x49, 0x11, 0x85, 0x61, 0x97, 0xd8, 0x21, 0x95,
+  0x36, 0x3b, 0x4a, 0xc6, 0xef, 0x68, 0x12, 0x3a, 0x5c, 0x6f, 0xb3, 0xda, 0xf5, 0x66, 0xa3, 0xb6,
+  0xce, 0x33, 0x9b, 0x1a, 0x51, 0xba, 0x45, 0x6f, 0x34, 0x82, 0x65, 0x8e, 0x90, 0x6a, 0x8e, 0xd0,
+  0xd7, 0x06, 0x1c, 0xfd, 0x28, 0x99, 0x75, 0xc8, 0xc1, 0x20, 0x17, 0x06, 0x53, 0x07, 0x1f, 0xdf,
+  0xff, 0x32, 0x00, 0x66, 0x8c, 0xb8, 0x43, 0x0b, 0x42, 0xd1, 0x1e, 0x61, 0x69, 0xd3, 0x1a, 0x23,
+  0x0b, 0x7f, 0x54, 0x68, 0xb6, 0x53, 0x1f, 0xe6, 0xa1, 0x38, 0xde, 0x89, 0x14, 0xc1, 0x3a, 0x66,
+  0x9c, 0x05, 0xbc, 0x4f, 0x73, 0xa6, 0x28, 0x89, 0x35, 0x08, 0x07, 0x75, 0x8e, 0xca, 0x3f, 0x7d,
+  0xac, 0x0e, 0x07, 0x78, 0x8a, 0x67, 0xc0, 0x14, 0x87, 0x91, 0xd3, 0x1b, 0x54, 0x9f, 0x29, 0xce,
+  0x55, 0x16, 0x2c, 0xdb, 0x5a, 0x8f, 0x56, 0xe7, 0x22, 0xcd, 0x89, 0x86, 0xad, 0xa4, 0x03, 0xa7,
+  0xc1, 0xe6, 0xba, 0x06, 0xad, 0xe8, 0x80, 0xc7, 0xa6, 0xce, 0x99, 0x25, 0x04, 0x5b, 0x23, 0xb1,
+  0xed, 0x65, 0x95, 0x4a, 0xbd, 0xce, 0x61, 0xe7, 0xfb, 0x10, 0xd7, 0x6f, 0xc2, 0x07, 0xf0, 0xd0,
+  0x03, 0xe0, 0x3a, 0xad, 0x0a, 0x54, 0x2e, 0x5e, 0xa3, 0x7b, 0x23, 0xd1, 0xff, 0xfb, 0xe3, 0xf6,
+  0x67, 0xde, 0x8f, 0x6a, 0x6d, 0x36, 0x44, 0x33, 0x1a, 0xc4, 0x41, 0x9f, 0xb8, 0x2d, 0x11, 0xcc,
+  0x21, 0xf2, 0x25, 0x8b, 0xa6, 0x5f, 0x09, 0x6e, 0x0f, 0xf8, 0x32, 0x32, 0x14, 0x96, 0x42, 0x77,
+  0x8f, 0xbc, 0x6a, 0x26, 0xdc, 0x8d, 0x36, 0x4b, 0x9f, 0xad, 0xed, 0x37, 0xa4, 0x32, 0x74, 0x69,
+  0xde, 0x8f, 0x8e, 0x24, 0x78, 0x5d, 0x1a, 0x7d, 0x27, 0xa8, 0x21, 0xe6, 0x85, 0x5d, 0xfb, 0xb1,
+  0x25, 0x66, 0x24, 0xb1, 0xea, 0x1b, 0x98, 0x2f, 0xc0, 0xc4, 0xbe, 0xaf, 0xfa, 0x83, 0xee, 0x5d,
+  0x23, 0x10, 0x2d, 0x78, 0x38, 0xe8, 0x04, 0x9b, 0xb7, 0xff, 0xc4, 0xce, 0x88, 0xa2, 0x3f, 0x98,
+  0x86, 0x35, 0x91, 0xc1, 0x7e, 0x3f, 0x51, 0x2c, 0x51, 0xf1, 0x90, 0x37, 0x58, 0x74, 0x4b, 0x51,
+  0xa0, 0xae, 0x5c, 0xff, 0x88, 0xe4, 0x19, 0x4c, 0xc6, 0xe3, 0x71, 0x1b, 0x8d, 0xd2, 0xe2, 0x97,
+  0xda, 0x06, 0x24, 0xbd, 0x89, 0xe0, 0x75, 0xf3, 0x48, 0x20, 0xca, 0x98, 0x90, 0xc8, 0xa3, 0x10,
+  0xb6, 0x1b, 0x1c, 0x49, 0xd0, 0x36, 0x05, 0x5e, 0x53, 0xc7, 0x3d, 0x51, 0xa0, 0xcd, 0xf5, 0xb3,
+  0x6f, 0xc6, 0xe8, 0xac, 0xcd, 0xa6, 0x40, 0xf2, 0x2b, 0x4e, 0x98, 0xb7, 0xef, 0x3e, 0x2c, 0xa3,
+  0xb3, 0xf0, 0xce, 0xfb, 0x1b, 0x1a, 0x9b, 0xc0, 0x43, 0x74, 0x4d, 0x93, 0x4a, 0x95, 0x18, 0x2e,
+  0xb7, 0x25, 0x46, 0xb4, 0x8b, 0x95, 0xa5, 0x14, 0x69, 0x98, 0xb6, 0x11, 0x39, 0x4a, 0x5d, 0x0f,
+  0x33, 0x6d, 0x8a, 0x61, 0x65, 0x24, 0x2a, 0x8f, 0xcb, 0xa3, 0x5d, 0x83, 0xe1, 0x9d, 0x2e, 0x81,
+  0x5a, 0x28, 0xae, 0xeb, 0x98, 0x2a, 0x15, 0x42, 0x62, 0x8b, 0xcc, 0xa4, 0x39, 0xb9, 0xc7, 0xca,
+  0x92, 0x6c, 0x6a, 0xdd, 0x9f, 0x0c, 0x42, 0x0a, 0xff, 0xb3, 0xfa, 0x4f, 0xfa, 0xe2, 0x6b, 0x6a,
+  0x1f, 0x68, 0x4a, 0xd3, 0xdc, 0x4e, 0xf1, 0x6c, 0xd4, 0x58, 0xbe, 0x4f, 0x8a, 0x26, 0x44, 0x6a,
+  0xc6, 0xe7, 0xd1, 0xb1, 0xd2, 0x11, 0xed, 0xe2, 0xe2, 0x0e, 0x52, 0xc9, 0xac, 0x9d, 0x47, 0x7b,
+  0xe7, 0xf5, 0xef, 0xf3, 0xc9, 0xb7, 0xae, 0x09, 0xda, 0xd1, 0x9b, 0x95, 0x20, 0x08, 0xb6, 0x9b,
+  0x95, 0xc5, 0x9b, 0xc7, 0xf1, 0xf6, 0xae, 0xc1, 0x0e, 0x23, 0x1a, 0x43, 0xa9, 0x85, 0xcb, 0x1f,
+  0x67, 0x35, 0x8e, 0xe3, 0xd9, 0xa8, 0x6c, 0x69, 0x78, 0x24, 0xdf, 0x2c, 0x61, 0x6a, 0xe6, 0x51,
+  0xe7, 0x89, 0xc1, 0x20, 0xa3, 0x70, 0x56, 0x4b, 0xb4, 0xf5, 0xbb, 0x68, 0xf1, 0xef, 0x3f, 0x7f,
+  0xc1, 0x87, 0xe6, 0xc7, 0x33, 0x78, 0x4a, 0x37, 0x0c, 0x8f, 0x05, 0xbd, 0x0a, 0x49, 0xf1, 0xf6,
+  0xa0, 0x72, 0xf1, 0x49, 0x57, 0x90, 0x32, 0x05, 0x8a, 0x9c, 0xa3, 0x22, 0x39, 0x3d, 0xd1, 0x25,
+  0xb2, 0xc2, 0x12, 0x37, 0x4e, 0x83, 0xec, 0x6d, 0xa5, 0x1b, 0xd9, 0xad, 0xae, 0x0c, 0x94, 0xa4,
+  0x32, 0xaa, 0xc6, 0xc3, 0x68, 0x10, 0xf7, 0x40, 0xde, 0x24, 0x15, 0xd5, 0x1d, 0x1c, 0x4d, 0x49,
+  0xb3, 0xb5, 0x35, 0xbb, 0x34, 0xc7, 0x74, 0x63, 0x81, 0xda, 0xac, 0x45, 0xee, 0x20, 0xce, 0x82,
+  0xeb, 0x09, 0x29, 0x8f, 0x4f, 0x38, 0x02, 0x66, 0x90, 0x1b, 0xcc, 0xe6, 0xd1, 0x28, 0xea, 0xf2,
+  0x25, 0x07, 0x87, 0x03, 0x9f, 0x8f, 0x16, 0xef, 0xd1, 0x55, 0x46, 0x79, 0xa2, 0xbe, 0xd7, 0x8d,
+  0x96, 0x70, 0xcb, 0x14, 0xca, 0xd9, 0x88, 0xf9, 0xba, 0x93, 0x96, 0x07, 0x8a, 0xb6, 0x73, 0xf7,
+  0x6d, 0x55, 0xc3, 0x1d, 0xe1, 0x35, 0xfd, 0x1b, 0x6e, 0x42, 0x8c, 0xc7, 0xef, 0x1a, 0xe6, 0x54,
+  0x29, 0x7d, 0x7a, 0x8d, 0xc8, 0x07, 0x92, 0x90, 0x95, 0x17, 0xfe, 0x8e, 0x24, 0x17, 0x2e, 0x4b,
+  0xef, 0xee, 0x59, 0xd2, 0x2c, 0x56, 0xfe, 0x5b, 0x44, 0x8a, 0xa0, 0xda, 0x09, 0x30, 0x6f, 0xda,
+  0x78, 0x5f, 0xd2, 0xed, 0xc2, 0xa1, 0x4f, 0x25, 0xd9, 0x46, 0x06, 0x7d, 0xdb, 0x6e, 0xe1, 0x8e,
+  0x49, 0xc1, 0xc3, 0x61, 0xcc, 0xb7, 0xbe, 0x69, 0xf4, 0x1e, 0xcc, 0x46, 0x04, 0xb6, 0x47, 0x6c,
+  0x7a, 0xcb, 0x1b, 0xbf, 0x34, 0xd4, 0xf6, 0x5b, 0x5f, 0x59, 0xde, 0x5c, 0x0c, 0x7d, 0xbf, 0x46,
+  0x0b, 0x84, 0x67, 0xa9, 0x31, 0x25, 0x0e, 0x7d, 0xd5, 0x3d, 0xf4, 0x31, 0x86, 0x69, 0x01, 0xa8,
+  0xa6, 0xce, 0x37, 0x34, 0x04, 0x41, 0x9a, 0x3b, 0x2a, 0x8c, 0x06, 0x99, 0x15, 0xf5, 0xf5, 0xbe,
+  0xcd, 0xe8, 0xa6, 0xa3, 0xcf, 0x9f, 0x3b, 0x32, 0x9d, 0x16, 0x66, 0x14, 0x52, 0xdc, 0x97, 0xaf,
+  0xb3, 0x2e, 0x9f, 0xec, 0x17, 0xa5, 0x6c, 0xc5, 0x5e, 0x9a, 0x2d, 0x5c, 0xad, 0xa9, 0x3f, 0x4f,
+  0x96, 0x4e, 0xe9, 0xc6, 0xf7, 0xbe, 0xab, 0x76, 0xbf, 0xe9, 0xd3, 0xb5, 0xa2, 0x5b, 0x7f, 0x5f,
+  0xa6, 0xdf, 0xbd, 0x60, 0x95, 0xe4, 0x2a, 0x72, 0x90, 0x91, 0xdd, 0x51, 0xd2, 0x8d, 0xca, 0x27,
+  0x22, 0xe9, 0x72, 0x0f, 0x3d, 0x6a, 0x90, 0xee, 0x75, 0xeb, 0xf6, 0x18, 0xb7, 0x12, 0x19, 0xe9,
+  0x58, 0xb0, 0x0d, 0xe9, 0x5a, 0x99, 0x30, 0x00, 0xbe, 0x66, 0x48, 0x03, 0x8e, 0xe6, 0x49, 0xd1,
+  0x3f, 0xda, 0x03, 0x4b, 0xd0, 0x05, 0xc1, 0xa7, 0x0d, 0x3a, 0x47, 0x87, 0xcd, 0x25, 0xa0, 0xd5,
+  0x09, 0xcb, 0xf0, 0x5f, 0x14, 0x8f, 0x45, 0xba, 0xa5, 0x8f, 0x90, 0x0e, 0x27, 0xd5, 0x45, 0x29,
+  0x29, 0xd8, 0x7f, 0x89, 0x40, 0x66, 0x74, 0xd1, 0xb0, 0x5c, 0x19, 0x5d, 0x53, 0x55, 0x80, 0x65,
+  0xce, 0xff, 0x6d, 0xc1, 0x28, 0xe8, 0xfb, 0x6a, 0x74, 0x38, 0x62, 0x47, 0xb6, 0x47, 0x83, 0xe6,
+  0x19, 0x1d, 0x14, 0xab, 0x7b, 0x78, 0x9f, 0x5d, 0x90, 0x2b, 0x86, 0x8f, 0xee, 0xff, 0x00, 0x32,
+  0x0e, 0xe6, 0x09, 0x85, 0x0b, 0x00, 0x00,
+};
+
+const WebAsset webAssets[WEB_ASSET_COUNT] = {
+  {"/", "text/html; charset=UTF-8", "\"e4bb6d99d3db0c13\"", asset_index_html, sizeof(asset_index_html)},
+  {"/msgraph_auth", "text/html; charset=UTF-8", "\"3ecc8dc47b44315b\"", asset_msgraph_auth_html, sizeof(asset_msgraph_auth_html)},
+  {"/msgraph_code", "text/html; charset=UTF-8", "\"e44d9667ec83cb0f\"", asset_msgraph_code_html, sizeof(asset_msgraph_code_html)},
+};
@@ -0,0 +1,29 @@
+// Generated by web/gen_web_assets.py - edit the script, not this file
+
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// Static pages of the control UI, gzipped at build time from web/. Sent as
+// stored, with Content-Encoding: gzip.
+
+struct WebAsset {
+  const char *path;
+  const char *contentType;
+  const char *etag;             // Quoted, from the uncompressed page
+  const uint8_t *data;
+  uint32_t length;
+};
+
+// Index into webAssets
+enum WebAssetId {
+  WEB_ASSET_INDEX,
+  WEB_ASSET_MSGRAPH_AUTH,
+  WEB_ASSET_MSGRAPH_CODE,
+  WEB_ASSET_COUNT
+};
+
+extern const WebAsset webAssets[WEB_ASSET_COUNT];
+
+#endif
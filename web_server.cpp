@@ -1,6 +1,17 @@
 #include "web_server.h"
 #include "matrix_display.h"
 #include "wifi_manager.h"
+#include "profiler.h"
+#include "http_pool.h"
+#include "json_arena.h"
+#include "fetch_scheduler.h"
+#include "upstream_health.h"
+#include "token_manager.h"
+#include "flash_store.h"
+#include "web_assets.h"
+#include "event_stream.h"
+#include "frame_stream.h"
+#include "pixel_receiver.h"
 
 void initializeWebServer()
 {
@@ -8,55 +19,213 @@ void initializeWebServer()
     Serial.println("Web server ready");
 }
 
-void handleWebClients()
+// Browsers open a second connection (favicon, parallel fetches) while the
+// first is still being read, so a few are parsed side by side. A connection
+// that hasn't sent a whole request by its deadline is answered with 408.
+#define WEB_MAX_CONNECTIONS 3
+#define WEB_REQUEST_TIMEOUT_MS 3000
+
+struct WebConnection
 {
-    if (wifiStatus == WL_CONNECTED)
+    bool active;
+    WiFiClient client;
+    uint32_t deadline;
+    HttpRequestParser parser;
+};
+
+static WebConnection connections[WEB_MAX_CONNECTIONS];
+
+static const char *statusReason(int status)
+{
+    switch (status)
     {
-        WiFiClient client = server.available();
-        if (client)
-        {
-            handleWebClient(client);
-        }
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 413: return "Content Too Large";
+        case 414: return "URI Too Long";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Error";
     }
 }
 
-void handleWebClient(WiFiClient client)
+static void sendError(WiFiClient &client, int status, const char *allow = nullptr)
 {
-    Serial.println("Client connected");
-    String request = "";
-    String currentLine = "";
+    String reason = statusReason(status);
+    client.println("HTTP/1.1 " + String(status) + " " + reason);
+    if (allow) client.println("Allow: " + String(allow));
+    client.println("Content-Type: text/plain");
+    client.println("Connection: close");
+    client.println();
+    client.println(reason);
+}
+
+// Each write to the NINA module is an SPI transaction and usually a TCP
+// segment of its own, so responses go out in as few writes as possible
+#define WEB_WRITE_CHUNK 2048
+
+static uint8_t writeBuffer[WEB_WRITE_CHUNK];
 
-    while (client.connected())
+// Sends the header with as much of the body as fits in the same write, then
+// the rest of the body straight from flash
+static void sendResponse(WiFiClient &client, const char *header, const uint8_t *body, size_t length)
+{
+    size_t used = strlen(header);
+    memcpy(writeBuffer, header, used);
+    size_t first = min(length, sizeof(writeBuffer) - used);
+    if (first > 0) memcpy(writeBuffer + used, body, first);
+    client.write(writeBuffer, used + first);
+
+    for (size_t offset = first; offset < length; offset += WEB_WRITE_CHUNK)
+    {
+        client.write(body + offset, min((size_t)WEB_WRITE_CHUNK, length - offset));
+    }
+}
+
+static void sendWebAsset(WiFiClient &client, const HttpRequest &request, const WebAsset &asset)
+{
+    char header[320];
+
+    // Revalidation is a few hundred bytes instead of the page
+    String ifNoneMatch = request.header("If-None-Match").toString();
+    if (ifNoneMatch.indexOf(asset.etag) >= 0 || ifNoneMatch == "*")
     {
-        if (client.available())
+        snprintf(header, sizeof(header),
+                 "HTTP/1.1 304 Not Modified\r\nETag: %s\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n",
+                 asset.etag);
+        sendResponse(client, header, nullptr, 0);
+        return;
+    }
+
+    // Only the gzipped copy is stored, and it goes out whatever Accept-Encoding
+    // says: every browser decodes gzip, and a page it can render beats a 406
+    snprintf(header, sizeof(header),
+             "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Encoding: gzip\r\nContent-Length: %lu\r\n"
+             "ETag: %s\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n",
+             asset.contentType, (unsigned long)asset.length, asset.etag);
+    sendResponse(client, header, asset.data, asset.length);
+}
+
+// What the static control page needs to show the device's current settings
+static void sendState(WiFiClient &client)
+{
+    String json = liveStateJson();
+
+    char header[160];
+    snprintf(header, sizeof(header),
+             "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %u\r\n"
+             "Cache-Control: no-store\r\nConnection: close\r\n\r\n",
+             json.length());
+    sendResponse(client, header, (const uint8_t *)json.c_str(), json.length());
+}
+
+static void closeConnection(WebConnection &connection)
+{
+    connection.client.stop();
+    connection.active = false;
+}
+
+static void acceptWebClient()
+{
+    WiFiClient client = server.available();
+    if (!client) return;
+
+    // available() hands back a socket again for as long as it has unread data
+    for (WebConnection &connection : connections)
+    {
+        if (connection.active && connection.client == client) return;
+    }
+    if (eventStreamOwns(client)) return;
+
+    for (WebConnection &connection : connections)
+    {
+        if (connection.active) continue;
+        connection.active = true;
+        connection.client = client;
+        connection.deadline = millis() + WEB_REQUEST_TIMEOUT_MS;
+        connection.parser.reset();
+        return;
+    }
+
+    sendError(client, 503);
+    client.stop();
+}
+
+// Reads whatever has arrived without waiting for more; answers and closes
+// once the request is complete, malformed or out of time
+static void serviceConnection(WebConnection &connection)
+{
+    WiFiClient &client = connection.client;
+    HttpRequestParser &parser = connection.parser;
+    HttpParseResult result = parser.result();
+
+    int available = client.available();
+    while (available > 0 && result == HTTP_PARSE_INCOMPLETE)
+    {
+        int count = client.read((uint8_t *)parser.writePointer(), min((size_t)available, parser.room()));
+        if (count <= 0) break;
+        result = parser.advance(count);
+        available = client.available();
+    }
+
+    if (result == HTTP_PARSE_COMPLETE)
+    {
+        ProfileScope requestScope(PROFILE_WEB_REQUEST);
+        processRequest(client, parser.request());
+
+        // /events keeps the socket open; the event stream has it now
+        if (eventStreamOwns(client))
         {
-            char c = client.read();
-
-            if (c == '\n')
-            {
-                if (currentLine.length() == 0)
-                {
-                    processRequest(client, request);
-                    break;
-                }
-                else
-                {
-                    if (currentLine.startsWith("GET "))
-                    {
-                        request = currentLine;
-                    }
-                    currentLine = "";
-                }
-            }
-            else if (c != '\r')
-            {
-                currentLine += c;
-            }
+            connection.active = false;
+            return;
         }
     }
+    else if (result == HTTP_PARSE_ERROR)
+    {
+        Serial.println("Rejected web request: " + String(parser.errorStatus()));
+        sendError(client, parser.errorStatus());
+    }
+    else if (!client.connected())
+    {
+        // Gone before finishing the request
+    }
+    else if ((int32_t)(millis() - connection.deadline) >= 0)
+    {
+        sendError(client, 408);
+    }
+    else
+    {
+        return;
+    }
+    closeConnection(connection);
+}
 
-    client.stop();
-    Serial.println("Client disconnected");
+void handleWebClients()
+{
+    if (wifiStatus == WL_CONNECTED)
+    {
+        acceptWebClient();
+    }
+
+    for (WebConnection &connection : connections)
+    {
+        if (connection.active) serviceConnection(connection);
+    }
+
+    serviceEventStreams();
+}
+
+bool webClientsPending()
+{
+    for (const WebConnection &connection : connections)
+    {
+        if (connection.active) return true;
+    }
+    return false;
 }
 
 // Convert IPAddress to String (since toString isn't available)
@@ -64,6 +233,9 @@ String ipAddressToString(IPAddress ip) {
     return String(ip[0]) + "." + String(ip[1]) + "." + String(ip[2]) + "." + String(ip[3]);
 }
 
+// Values are decoded here before use; the network task is the only caller
+static char paramBuffer[HTTP_REQUEST_BUFFER];
+
 // helper function to extract a parameter value from the request
 String extractCodeFromURL(String url) {
     // Handle both full URLs and just the code parameter
@@ -77,13 +249,13 @@ String extractCodeFromURL(String url) {
     }
 
     if (codeStart >= 0) {
-        // Found the code parameter, extract it
-        codeStart += (url.charAt(codeStart) == '?') ? 6 : 6; // Skip "?code=" or "&code="
-        int codeEnd = url.indexOf('&', codeStart);
-        if (codeEnd == -1) {
-            codeEnd = url.length();
+        // Found the code parameter. It is still percent-encoded the way the
+        // redirect carried it, so decode it here; the token request encodes it again
+        int queryStart = url.indexOf('?') + 1;
+        HttpSpan query = {url.c_str() + queryStart, (uint16_t)(url.length() - queryStart)};
+        if (httpQueryParam(query, "code", paramBuffer, sizeof(paramBuffer)) > 0) {
+            code = paramBuffer;
         }
-        code = url.substring(codeStart, codeEnd);
 
         Serial.println("Extracted code from URL: " + code);
         return code;
@@ -101,491 +273,363 @@ String extractCodeFromURL(String url) {
     return "";
 }
 
-void processRequest(WiFiClient client, String request)
-{
-    Serial.println("DEBUG: Received request: " + request);
+// ---- Routes ----
+// Every handler writes its whole response. params is the query string of a
+// GET, or the form-encoded body of a POST.
+
+typedef void (*RouteHandler)(WiFiClient &client, const HttpRequest &request, const HttpSpan &params);
 
-    // Send headers
+static void sendTextHeader(WiFiClient &client)
+{
     client.println("HTTP/1.1 200 OK");
     client.println("Content-Type: text/html; charset=UTF-8");
     client.println("Connection: close");
     client.println();
+}
+
+// Decoded value of a parameter as a String, empty when it's missing
+static String paramString(const HttpSpan &params, const char *name)
+{
+    return httpQueryParam(params, name, paramBuffer, sizeof(paramBuffer)) >= 0 ? String(paramBuffer) : String();
+}
+
+static void handleIndexPage(WiFiClient &client, const HttpRequest &request, const HttpSpan &)
+{
+    sendWebAsset(client, request, webAssets[WEB_ASSET_INDEX]);
+}
+
+static void handleMsGraphAuthPage(WiFiClient &client, const HttpRequest &request, const HttpSpan &)
+{
+    sendWebAsset(client, request, webAssets[WEB_ASSET_MSGRAPH_AUTH]);
+}
+
+static void handleMsGraphCodePage(WiFiClient &client, const HttpRequest &request, const HttpSpan &)
+{
+    sendWebAsset(client, request, webAssets[WEB_ASSET_MSGRAPH_CODE]);
+}
+
+static void handleState(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    sendState(client);
+}
 
-    // Route requests
-    if (request.indexOf("GET / ") >= 0)
+// Live updates for the control page; see event_stream.h
+static void handleEvents(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    if (!openEventStream(client))
     {
-        sendControlPage(client);
+        sendError(client, 503);
     }
-    else if (request.indexOf("GET /color?c=") >= 0)
+}
+
+static void handleColor(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    long colorIndex;
+    if (!httpQueryInt(params, "c", colorIndex))
     {
-        int colorIndex = extractParameter(request, "c=");
-        setAnimationColor(colorIndex);
-        client.println("Color changed");
+        sendError(client, 400);
+        return;
     }
-    else if (request.indexOf("GET /pattern") >= 0)
+    setAnimationColor(colorIndex);
+    sendTextHeader(client);
+    client.println("Color changed");
+}
+
+static void handlePattern(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    setAnimationPattern();
+    sendTextHeader(client);
+    client.println("Pattern activated");
+}
+
+static void handleTruck(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    setTruckAnimation();
+    sendTextHeader(client);
+    client.println("Truck animation activated");
+}
+
+static void handleText(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    if (httpQueryParam(params, "msg", paramBuffer, sizeof(paramBuffer)) < 0)
     {
-        setAnimationPattern();
-        client.println("Pattern activated");
+        sendError(client, 400);
+        return;
     }
-    else if (request.indexOf("GET /truck") >= 0)
+    String message = paramBuffer;
+    setAnimationText(message);
+    sendTextHeader(client);
+    client.println("Text set: " + message);
+}
+
+static void handlePixels(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    setPixelAnimation();
+    sendTextHeader(client);
+    client.println("Listening for DDP on port " + String(DDP_PORT) + " and E1.31 on port " + String(E131_PORT));
+}
+
+static void handleClear(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    clearAnimationZone();
+    sendTextHeader(client);
+    client.println("Display cleared");
+}
+
+static void handleWidget(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    long widgetType;
+    if (!httpQueryInt(params, "w", widgetType) || widgetType < WIDGET_NONE || widgetType > WIDGET_TEMPERATURE)
     {
-        setTruckAnimation();
-        client.println("Truck animation activated");
+        sendError(client, 400);
+        return;
     }
-    else if (request.indexOf("GET /text?msg=") >= 0)
+    setWidget((WidgetType)widgetType);
+    sendTextHeader(client);
+    client.println("Widget changed");
+}
+
+static void handleWeatherDebugOn(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    setWeatherDebugMode(true);
+    sendTextHeader(client);
+    client.println("Weather debug mode enabled - cycling through conditions");
+}
+
+static void handleWeatherDebugOff(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    setWeatherDebugMode(false);
+    sendTextHeader(client);
+    client.println("Weather debug mode disabled");
+}
+
+static void handleWeatherDebugNext(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    advanceDebugWeather();
+    sendTextHeader(client);
+    client.println("Advanced to next debug weather condition");
+}
+
+static void handleWeatherDebugStatus(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    sendTextHeader(client);
+    client.println(getDebugWeatherInfo());
+}
+
+// Stage timings since boot, one line per stage
+static void handleMetrics(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    sendTextHeader(client);
+    printProfileMetrics(client);
+    printConnectionPoolMetrics(client);
+    printFetchSchedule(client);
+    client.print("json_arena_peak_bytes ");
+    client.println((unsigned long)jsonArenaHighWater());
+    printFlashStoreMetrics(client);
+    printFrameStreamMetrics(client);
+    printPixelReceiverMetrics(client);
+    client.print("uptime_ms ");
+    client.println(millis());
+}
+
+// Circuit breaker state of every upstream API, token lifetimes, then when each source fetches next
+static void handleStatus(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    sendTextHeader(client);
+    printUpstreamHealth(client);
+    printTokenStatus(client);
+    printFetchSchedule(client);
+}
+
+static void handleSpotifyAuth(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    String authURL = getSpotifyAuthURL();
+    sendTextHeader(client);
+    client.println("Spotify Auth URL: " + authURL);
+    client.println("Visit this URL to authorize the app, then use /spotify_token to set tokens");
+}
+
+static void handleSpotifyToken(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    String accessToken = paramString(params, "access");
+    String refreshToken = paramString(params, "refresh");
+    if (accessToken.length() == 0)
     {
-        String message = extractString(request, "msg=");
-        setAnimationText(message);
-        client.println("Text set: " + message);
+        sendError(client, 400);
+        return;
     }
-    else if (request.indexOf("GET /clear") >= 0)
+    setSpotifyTokens(accessToken, refreshToken);
+    sendTextHeader(client);
+    client.println("Spotify tokens set successfully");
+}
+
+static void handleSpotifyUrl(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    if (httpQueryParam(params, "url", paramBuffer, sizeof(paramBuffer)) < 0)
     {
-        clearAnimationZone();
-        client.println("Display cleared");
+        sendError(client, 400);
+        return;
     }
-    else if (request.indexOf("GET /widget?w=") >= 0)
+    String authCode = extractCodeFromURL(paramBuffer);
+
+    sendTextHeader(client);
+    if (authCode.length() > 0)
     {
-        int widgetType = extractParameter(request, "w=");
-        setWidget((WidgetType)widgetType);
-        client.println("Widget changed");
-    }
-        // Weather debug routes
-    else if (request.indexOf("GET /weather_debug_on") >= 0) {
-        setWeatherDebugMode(true);
-        client.println("Weather debug mode enabled - cycling through conditions");
-    }
-    else if (request.indexOf("GET /weather_debug_off") >= 0) {
-        setWeatherDebugMode(false);
-        client.println("Weather debug mode disabled");
-    }
-    else if (request.indexOf("GET /weather_debug_next") >= 0) {
-        advanceDebugWeather();
-        client.println("Advanced to next debug weather condition");
-    }
-    else if (request.indexOf("GET /weather_debug_status") >= 0) {
-        client.println(getDebugWeatherInfo());
-    }
-        // Spotify routes
-    else if (request.indexOf("GET /spotify_auth") >= 0) {
-        String authURL = getSpotifyAuthURL();
-        client.println("Spotify Auth URL: " + authURL);
-        client.println("Visit this URL to authorize the app, then use /spotify_token to set tokens");
-    }
-    else if (request.indexOf("GET /spotify_token?access=") >= 0) {
-        String accessToken = extractString(request, "access=");
-        String refreshToken = extractString(request, "refresh=");
-        setSpotifyTokens(accessToken, refreshToken);
-        client.println("Spotify tokens set successfully");
-    }
-//    else if (request.indexOf("GET /spotify_code?code=") >= 0) {
-//        String authCode = extractString(request, "code=");
-//        Serial.println("Received authorization code: " + authCode);
-//
-//        if (exchangeCodeForTokens(authCode)) {
-//            client.println("Success! Spotify tokens obtained and saved.");
-//            client.println("You can now select the Spotify widget.");
-//        } else {
-//            client.println("Failed to exchange authorization code for tokens.");
-//        }
-//    }
-    else if (request.indexOf("GET /spotify_url?url=") >= 0) {
-        String fullURL = extractString(request, "url=");
-
-        // URL decode the input
-        fullURL.replace("%3A", ":");
-        fullURL.replace("%2F", "/");
-        fullURL.replace("%3F", "?");
-        fullURL.replace("%3D", "=");
-        fullURL.replace("%26", "&");
-
-        String authCode = extractCodeFromURL(fullURL);
-
-        if (authCode.length() > 0) {
-            Serial.println("Processing extracted authorization code: " + authCode);
-
-            if (exchangeCodeForTokens(authCode)) {
-                client.println("Success! Spotify tokens obtained from URL.");
-                client.println("Code extracted: " + authCode.substring(0, 10) + "...");
-                client.println("You can now select the Spotify widget.");
-            } else {
-                client.println("Failed to exchange authorization code for tokens.");
-                client.println("Extracted code: " + authCode.substring(0, 10) + "...");
-            }
-        } else {
-            client.println("Error: Could not extract authorization code from URL.");
-            client.println("Please make sure you're pasting the full redirect URL that contains '?code='");
-            client.println("Example: https://spotify.com/?code=AQC1234567890...");
-        }
-    }
-    // Microsoft Graph (Teams) authorization endpoint
-    else if (request.indexOf("GET /msgraph_auth") >= 0) {
-        String authURL = getMsGraphAuthURL();
-        client.println("<!DOCTYPE html>");
-        client.println("<html><head><title>Microsoft Graph Authorization</title>");
-        client.println("<style>");
-        client.println("body{font-family:Arial,sans-serif;margin:20px;background:#222;color:#fff;line-height:1.5;}");
-        client.println("h1,h2{color:#0078d4;} a{color:#0078d4;} .btn{background:#0078d4;color:#fff;padding:10px 20px;border:none;border-radius:4px;text-decoration:none;display:inline-block;margin:10px 0;}");
-        client.println(".container{max-width:800px;margin:0 auto;background:#333;padding:20px;border-radius:8px;box-shadow:0 0 10px rgba(0,0,0,0.5);}");
-        client.println(".code-box{background:#444;border:1px solid #666;padding:15px;margin:10px 0;border-radius:4px;word-break:break-all;font-family:monospace;color:#4CAF50;}");
-        client.println(".step{margin-bottom:20px;border-left:4px solid #0078d4;padding-left:15px;}");
-        client.println("input[type=text]{background:#444;color:#fff;padding:8px;border:1px solid #666;width:80%;border-radius:4px;}");
-        client.println("</style>");
-        client.println("<script>");
-        client.println("function extractAndSubmit() {");
-        client.println("  const url = new URL(window.location.href);");
-        client.println("  const code = url.searchParams.get('code');");
-        client.println("  if (code) {");
-        client.println("    document.getElementById('codeValue').innerText = code;");
-        client.println("    document.getElementById('extractedCode').style.display = 'block';");
-        client.println("    document.getElementById('codeInput').value = code;");
-        client.println("    document.getElementById('autoSubmit').style.display = 'block';");
-        client.println("  }");
-        client.println("}");
-        client.println("</script>");
-        client.println("</head><body onload='extractAndSubmit()'>");
-        client.println("<div class='container'>");
-        client.println("<h1>Microsoft Teams Presence Authorization</h1>");
-
-        client.println("<div class='step'>");
-        client.println("<h2>Step 1: Sign in with Microsoft</h2>");
-        client.println("<p>Click the button below to sign in with your Microsoft account and authorize access to your Teams presence:</p>");
-        client.println("<a href='" + authURL + "' target='_blank' class='btn'>Sign in with Microsoft</a>");
-        client.println("</div>");
-
-        client.println("<div class='step'>");
-        client.println("<h2>Step 2: After authorization</h2>");
-        client.println("<p>After signing in, you'll be redirected to a <strong>blank page</strong> with a URL that contains your authorization code.</p>");
-        client.println("<p>Look at your browser's address bar - it should look something like this:</p>");
-        client.println("<div class='code-box'>https://login.microsoftonline.com/common/oauth2/nativeclient?<strong>code=M.R3_BAY...</strong>&state=12345</div>");
-        client.println("</div>");
-
-        client.println("<div id='extractedCode' style='display:none;' class='step'>");
-        client.println("<h2>✓ Code detected!</h2>");
-        client.println("<p>We've detected an authorization code in your current URL:</p>");
-        client.println("<div class='code-box' id='codeValue'></div>");
-        client.println("<p id='autoSubmit'>Click the button below to use this code:</p>");
-        client.println("<form action='/msgraph_code' method='get'>");
-        client.println("<input type='hidden' id='codeInput' name='code'>");
-        client.println("<input type='submit' value='Use this code' class='btn'>");
-        client.println("</form>");
-        client.println("</div>");
-
-        client.println("<div class='step'>");
-        client.println("<h2>Step 3: Manual entry</h2>");
-        client.println("<p>If automatic detection doesn't work, copy the <strong>entire URL</strong> from your browser's address bar after authorization:</p>");
-        client.println("<form action='/msgraph_code' method='get'>");
-        client.println("<input type='text' name='url' size='60' placeholder='https://login.microsoftonline.com/common/oauth2/nativeclient?code=...'>");
-        client.println("<input type='submit' value='Submit' class='btn' style='margin-left:10px;'>");
-        client.println("</form>");
-        client.println("</div>");
-
-        client.println("</div>");
-        client.println("</body></html>");
-    }
-    // Handle Microsoft Graph authorization code
-    else if (request.indexOf("GET /msgraph_code") >= 0) {
-        String authCode = "";
-
-        // Check if code was provided directly
-        if (request.indexOf("?code=") >= 0) {
-            authCode = extractString(request, "code=");
-            Serial.println("Direct code parameter found: " + authCode.substring(0, 10) + "...");
+        Serial.println("Processing extracted authorization code: " + authCode);
+
+        // The page polls /token_status for the result
+        if (exchangeCodeForTokens(authCode))
+        {
+            client.println("Exchanging code for tokens...");
+            client.println("Code extracted: " + authCode.substring(0, 10) + "...");
         }
-        // Otherwise, try to extract from URL parameter 
-        else if (request.indexOf("?url=") >= 0) {
-            String fullURL = extractString(request, "url=");
-
-            // URL decode the input
-            fullURL.replace("%3A", ":");
-            fullURL.replace("%2F", "/");
-            fullURL.replace("%3F", "?");
-            fullURL.replace("%3D", "=");
-            fullURL.replace("%26", "&");
-
-            authCode = extractCodeFromURL(fullURL);
-            Serial.println("Extracted code from URL: " + authCode.substring(0, 10) + "...");
+        else
+        {
+            client.println("Spotify can't be reached right now, try again in a minute.");
+            client.println("Extracted code: " + authCode.substring(0, 10) + "...");
         }
+    }
+    else
+    {
+        client.println("Error: Could not extract authorization code from URL.");
+        client.println("Please make sure you're pasting the full redirect URL that contains '?code='");
+        client.println("Example: https://spotify.com/?code=AQC1234567890...");
+    }
+}
 
-        client.println("<!DOCTYPE html>");
-        client.println("<html><head><title>Microsoft Graph Authorization</title>");
-        client.println("<style>");
-        client.println("body{font-family:Arial,sans-serif;margin:20px;background:#222;color:#fff;line-height:1.5;}");
-        client.println("h1{color:#0078d4;} .container{max-width:600px;margin:0 auto;background:#333;padding:20px;border-radius:8px;}");
-        client.println(".success{color:#4CAF50;font-weight:bold;} .error{color:#F44336;font-weight:bold;}");
-        client.println(".btn{background:#0078d4;color:#fff;padding:10px 20px;text-decoration:none;display:inline-block;border-radius:4px;margin-top:15px;}");
-        client.println(".btn-success{background:#4CAF50;} .btn-error{background:#F44336;}");
-        client.println("</style>");
-        client.println("</head><body>");
-        client.println("<div class='container'>");
-        client.println("<h1>Microsoft Graph Authorization</h1>");
-
-        if (authCode.length() > 0) {
-            Serial.println("Processing MS Graph authorization code: " + authCode.substring(0, 10) + "...");
-
-            if (exchangeMsGraphCodeForTokens(authCode)) {
-                client.println("<p class='success'>✓ Success! Microsoft Graph tokens obtained.</p>");
-                client.println("<p>You can now use the Teams widget to display your presence status.</p>");
-                client.println("<p>The next time your device checks for Teams presence, it will display your status.</p>");
-                client.println("<a href='/' class='btn btn-success'>Return to Control Panel</a>");
-            } else {
-                client.println("<p class='error'>✗ Failed to exchange authorization code for tokens.</p>");
-                client.println("<p>This might happen if:</p>");
-                client.println("<ul>");
-                client.println("<li>The authorization code has expired (they're only valid for a short time)</li>");
-                client.println("<li>The code was already used once (codes are single-use only)</li>");
-                client.println("<li>There was a network error when contacting Microsoft's servers</li>");
-                client.println("</ul>");
-                client.println("<a href='/msgraph_auth' class='btn btn-error'>Try Again</a>");
-            }
-        } else {
-            client.println("<p class='error'>✗ No authorization code found.</p>");
-            client.println("<p>We couldn't find a valid authorization code in your request.</p>");
-            client.println("<p>Please make sure you're either:</p>");
-            client.println("<ul>");
-            client.println("<li>Using the automatic code detection on the authorization page</li>");
-            client.println("<li>Pasting the complete URL from your browser after authorizing</li>");
-            client.println("</ul>");
-            client.println("<a href='/msgraph_auth' class='btn'>Return to Authorization Page</a>");
-        }
-        client.println("</div>");
-        client.println("</body></html>");
-    }
-    else {
-        Serial.println("DEBUG: Unknown command: " + request);
-        client.println("Unknown command");
-    }
-}
-
-void sendControlPage(WiFiClient client)
-{
-    client.println("<!DOCTYPE html>");
-    client.println("<html>");
-    client.println("<head>");
-    client.println("<title>LED Matrix Control</title>");
-    client.println("<style>");
-    client.println("body { font-family: Arial; margin: 20px; background: #222; color: #fff; }");
-    client.println("h1 { color: #4CAF50; }");
-    client.println("button { padding: 10px 20px; margin: 5px; font-size: 16px; border: none; border-radius: 5px; cursor: pointer; }");
-    client.println(".color-btn { width: 50px; height: 50px; margin: 3px; border: 2px solid #666; }");
-    client.println(".control-btn { background: #4CAF50; color: white; }");
-    client.println(".control-btn:hover { background: #45a049; }");
-    client.println(".truck-btn { background: #FF6B35; color: white; }");
-    client.println(".truck-btn:hover { background: #E55A2B; }");
-    client.println(".widget-btn { background: #2196F3; color: white; }");
-    client.println(".widget-btn:hover { background: #1976D2; }");
-    client.println(".debug-btn { background: #9C27B0; color: white; }");
-    client.println(".debug-btn:hover { background: #7B1FA2; }");
-    client.println(".spotify-btn { background: #1DB954; color: white; }");
-    client.println(".spotify-btn:hover { background: #1AAE4C; }");
-    client.println("input[type='text'] { padding: 8px; font-size: 16px; width: 200px; border: 1px solid #666; border-radius: 4px; background: #444; color: #fff; }");
-    client.println("select { padding: 8px; font-size: 16px; border: 1px solid #666; border-radius: 4px; background: #444; color: #fff; }");
-    client.println(".section { margin: 20px 0; padding: 15px; background: #333; border-radius: 8px; box-shadow: 0 2px 4px rgba(0,0,0,0.3); }");
-    client.println(".widget-grid { display: grid; grid-template-columns: 1fr 1fr; gap: 10px; margin: 10px 0; }");
-    client.println("</style>");
-    client.println("</head>");
-    client.println("<body>");
-
-    client.println("<h1>🎨 LED Matrix Control Panel</h1>");
-
-    client.println("<div class='section'>");
-    client.println("<h3>Colors:</h3>");
-    client.println("<button class='color-btn' style='background: black' onclick='setColor(0)'></button>");
-    client.println("<button class='color-btn' style='background: red' onclick='setColor(1)'></button>");
-    client.println("<button class='color-btn' style='background: green' onclick='setColor(2)'></button>");
-    client.println("<button class='color-btn' style='background: blue' onclick='setColor(3)'></button>");
-    client.println("<button class='color-btn' style='background: yellow' onclick='setColor(4)'></button>");
-    client.println("<button class='color-btn' style='background: magenta' onclick='setColor(5)'></button>");
-    client.println("<button class='color-btn' style='background: cyan' onclick='setColor(6)'></button>");
-    client.println("<button class='color-btn' style='background: white' onclick='setColor(7)'></button>");
-    client.println("</div>");
-
-    // Animation Selection Section
-    client.println("<div class='section'>");
-    client.println("<h3>Display Modes:</h3>");
-    client.println("<button class='control-btn' onclick='setPattern()'>🌈 Rainbow Pattern</button>");
-    client.println("<button class='truck-btn' onclick='setTruck()'>🚛 Truck Animation</button>");
-    client.println("<button class='control-btn' onclick='clearDisplay()'>⚫ Clear Display</button>");
-    client.println("</div>");
-
-    // Widget Selector Section
-    client.println("<div class='section'>");
-    client.println("<h3>Smart Widgets:</h3>");
-    client.println("<div class='widget-grid'>");
-    client.println("<div>");
-    client.println("<label>Widget:</label><br>");
-    client.println("<select id='widget'>");
-    client.println("<option value='0'>None</option>");
-    client.println("<option value='1' selected>Clock</option>");
-    client.println("<option value='2'>Weather</option>");
-    client.println("<option value='3'>Teams Status</option>");
-    client.println("<option value='4'>Stock Ticker</option>");
-    client.println("<option value='5'>🎵 Spotify</option>");
-    client.println("</select>");
-    client.println("<button class='widget-btn' onclick='setWidget()'>Set</button>");
-    client.println("</div>");
-    client.println("</div>");
-    client.println("</div>");
-
-    // Text Section
-    client.println("<div class='section'>");
-    client.println("<h3>Text Display:</h3>");
-    client.println("<input type='text' id='textInput' placeholder='Enter text to display' value='Hello Matrix!'>");
-    client.println("<button class='control-btn' onclick='setText()'>📝 Show Text</button>");
-    client.println("</div>");
-
-    // Weather Debug Section
-    client.println("<div class='section'>");
-    client.println("<h3>🌤️ Weather Debug Mode:</h3>");
-    client.println("<p>Test all weather conditions and animations:</p>");
-    client.println("<button class='debug-btn' onclick='enableWeatherDebug()'>🔄 Enable Auto-Cycle</button>");
-    client.println("<button class='debug-btn' onclick='nextWeatherDebug()'>⏭️ Next Condition</button>");
-    client.println("<button class='control-btn' onclick='disableWeatherDebug()'>⏹️ Disable Debug</button>");
-    client.println("<button class='widget-btn' onclick='checkDebugStatus()'>📊 Status</button>");
-    client.println("<div id='debugStatus' style='margin-top: 10px; padding: 10px; background: #444; border-radius: 4px;'>");
-    client.println("Debug status will appear here");
-    client.println("</div>");
-    client.println("</div>");
-
-    // Spotify Setup Section - UPDATED
-    client.println("<div class='section'>");
-    client.println("<h3>🎵 Spotify Setup:</h3>");
-    client.println("<p><strong>Step 1:</strong> Get authorization URL</p>");
-    client.println("<button class='spotify-btn' onclick='spotifyAuth()'>🔑 Get Auth URL</button>");
-    client.println("<div id='authUrlDisplay' style='margin: 10px 0; padding: 10px; background: #444; border-radius: 4px; word-break: break-all;'></div>");
-
-    client.println("<p><strong>Step 2:</strong> Visit the URL above, authorize, then paste the FULL redirect URL below</p>");
-    client.println("<label>Redirect URL (paste the complete URL you get redirected to):</label><br>");
-    client.println("<input type='text' id='redirectUrl' placeholder='https://spotify.com/?code=AQC1234567890...' style='width: 400px;'><br>");
-    client.println("<button class='control-btn' onclick='submitRedirectURL()'>🔄 Extract Code & Get Tokens</button>");
-
-    client.println("<p style='font-size: 12px; color: #888;'>");
-    client.println("💡 Tip: After clicking authorize on Spotify, you'll be redirected to a page that might show an error. ");
-    client.println("That's normal! Just copy the ENTIRE URL from your browser's address bar and paste it above.");
-    client.println("</p>");
-
-    client.println("<div id='spotifyStatus' style='margin-top: 10px; padding: 10px; background: #444; border-radius: 4px;'>");
-    client.println("Click 'Get Auth URL' to start setup");
-    client.println("</div>");
-
-    // Microsoft Teams Auth Section
-    client.println("<div class='section'>");
-    client.println("<h3>Microsoft Teams Integration:</h3>");
-    client.println("<button class='widget-btn' style='background:#0078d4;' onclick='window.location.href=\"/msgraph_auth\"'>🔑 Authorize Teams</button>");
-    client.println("<p>Connect to Microsoft Teams to display your presence status.</p>");
-    client.println("</div>");
-    client.println("</div>");
-
-
-    client.println("<script>");
-    client.println("function setColor(colorIndex) { fetch('/color?c=' + colorIndex); }");
-    client.println("function setPattern() { fetch('/pattern'); }");
-    client.println("function setTruck() { fetch('/truck'); }");
-    client.println("function clearDisplay() { fetch('/clear'); }");
-    client.println("function setText() { const text = document.getElementById('textInput').value; fetch('/text?msg=' + encodeURIComponent(text)); }");
-    client.println("function setWidget() { const w = document.getElementById('widget').value; fetch('/widget?w=' + w); }");
-
-    // Weather debug functions
-    client.println("function enableWeatherDebug() { ");
-    client.println("  fetch('/weather_debug_on').then(r => r.text()).then(data => {");
-    client.println("    document.getElementById('debugStatus').innerHTML = data;");
-    client.println("    setTimeout(checkDebugStatus, 1000);");
-    client.println("  });");
-    client.println("}");
-
-    client.println("function disableWeatherDebug() { ");
-    client.println("  fetch('/weather_debug_off').then(r => r.text()).then(data => {");
-    client.println("    document.getElementById('debugStatus').innerHTML = data;");
-    client.println("  });");
-    client.println("}");
-
-    client.println("function nextWeatherDebug() { ");
-    client.println("  fetch('/weather_debug_next').then(r => r.text()).then(data => {");
-    client.println("    document.getElementById('debugStatus').innerHTML = data;");
-    client.println("    setTimeout(checkDebugStatus, 500);");
-    client.println("  });");
-    client.println("}");
-
-    client.println("function checkDebugStatus() { ");
-    client.println("  fetch('/weather_debug_status').then(r => r.text()).then(data => {");
-    client.println("    document.getElementById('debugStatus').innerHTML = data;");
-    client.println("  });");
-    client.println("}");
-
-    // Spotify functions
-
-    client.println("function spotifyAuth() {");
-    client.println("  fetch('/spotify_auth').then(r => r.text()).then(data => {");
-    client.println("    const url = data.split('Spotify Auth URL: ')[1].split('\\n')[0];");
-    client.println("    document.getElementById('authUrlDisplay').innerHTML = ");
-    client.println("      '<a href=\"' + url + '\" target=\"_blank\" style=\"color: #1DB954; text-decoration: none;\">🔗 Click here to authorize Spotify</a><br><small style=\"color: #888;\">' + url + '</small>';");
-    client.println("    document.getElementById('spotifyStatus').innerHTML = ");
-    client.println("      '1. Click the link above to authorize<br>2. Copy the complete redirect URL<br>3. Paste it in the text box below';");
-    client.println("  });");
-    client.println("}");
-
-    client.println("function submitRedirectURL() {");
-    client.println("  const url = document.getElementById('redirectUrl').value.trim();");
-    client.println("  if (url) {");
-    client.println("    if (url.includes('code=')) {");
-    client.println("      document.getElementById('spotifyStatus').innerHTML = 'Extracting code and exchanging for tokens...';");
-    client.println("      fetch('/spotify_url?url=' + encodeURIComponent(url))");
-    client.println("        .then(r => r.text()).then(data => {");
-    client.println("          document.getElementById('spotifyStatus').innerHTML = data.replace(/\\n/g, '<br>');");
-    client.println("          if (data.includes('Success!')) {");
-    client.println("            document.getElementById('redirectUrl').value = '';");
-    client.println("            document.getElementById('spotifyStatus').innerHTML += '<br><br>✅ <strong>Setup complete! You can now use the Spotify widget.</strong>';");
-    client.println("          }");
-    client.println("        });");
-    client.println("    } else {");
-    client.println("      document.getElementById('spotifyStatus').innerHTML = ");
-    client.println("        '❌ Error: The URL should contain \"code=\". Please make sure you\\'re pasting the full redirect URL from Spotify.';");
-    client.println("    }");
-    client.println("  } else {");
-    client.println("    document.getElementById('spotifyStatus').innerHTML = 'Please paste the redirect URL from Spotify';");
-    client.println("  }");
-    client.println("}");
-
-
-    client.println("// Auto-refresh debug status every 3 seconds when in debug mode");
-    client.println("setInterval(() => {");
-    client.println("  if (document.getElementById('debugStatus').innerHTML.includes('Debug:')) {");
-    client.println("    checkDebugStatus();");
-    client.println("  }");
-    client.println("}, 3000);");
-
-    client.println("</script>");
-
-    client.println("</body>");
-    client.println("</html>");
-}
-
-int extractParameter(String request, String param)
-{
-    int start = request.indexOf(param);
-    if (start >= 0)
+// Sign-in link for the static /msgraph_auth page
+static void handleMsGraphAuthUrl(WiFiClient &client, const HttpRequest &, const HttpSpan &)
+{
+    sendTextHeader(client);
+    client.println(getMsGraphAuthURL());
+}
+
+// Authorization code posted back by the /msgraph_code page, either as it came
+// in the redirect or inside a pasted redirect URL. The page shows the result
+// named here, or polls /token_status while it is pending.
+static void handleMsGraphCode(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
+{
+    String authCode = paramString(params, "code");
+    if (authCode.length() > 0)
+    {
+        Serial.println("Direct code parameter found: " + authCode.substring(0, 10) + "...");
+    }
+    else if (httpQueryParam(params, "url", paramBuffer, sizeof(paramBuffer)) >= 0)
+    {
+        authCode = extractCodeFromURL(paramBuffer);
+        Serial.println("Extracted code from URL: " + authCode.substring(0, 10) + "...");
+    }
+
+    sendTextHeader(client);
+    if (authCode.length() > 0)
+    {
+        Serial.println("Processing MS Graph authorization code: " + authCode.substring(0, 10) + "...");
+        client.println(exchangeMsGraphCodeForTokens(authCode) ? "pending" : "failed");
+    }
+    else
     {
-        start += param.length();
-        int end = request.indexOf(' ', start);
-        if (end < 0) end = request.indexOf('&', start);
-        if (end < 0) end = request.length();
-        return request.substring(start, end).toInt();
+        client.println("no_code");
     }
-    return 0;
 }
 
-String extractString(String request, String param)
+// Result of the last authorization code exchange for ?provider=spotify or
+// msgraph: idle, pending, ok or failed
+static void handleTokenStatus(WiFiClient &client, const HttpRequest &, const HttpSpan &params)
 {
-    int start = request.indexOf(param);
-    if (start >= 0)
+    static const char *const results[] = {"idle", "pending", "ok", "failed"};
+
+    TokenProvider provider;
+    if (httpQueryParam(params, "provider", paramBuffer, sizeof(paramBuffer)) < 0 ||
+        !findTokenProvider(paramBuffer, provider))
     {
-        start += param.length();
-        int end = request.indexOf(' ', start);
-        if (end < 0) end = request.indexOf('&', start);
-        if (end < 0) end = request.length();
-        String value = request.substring(start, end);
-        value.replace("%20", " ");
-        value.replace("+", " ");
-        return value;
+        sendError(client, 400);
+        return;
     }
-    return "";
-}
\ No newline at end of file
+    sendTextHeader(client);
+    client.println(results[tokenExchangeState(provider)]);
+}
+
+// FNV-1a of a path. The constexpr form gives the case labels below, so the
+// compiler turns the route list into a jump table or binary search over
+// constants, and refuses to build if two paths ever hash alike.
+constexpr uint32_t routeHash(const char *path, uint32_t hash = 2166136261u)
+{
+    return *path ? routeHash(path + 1, (hash ^ (uint8_t)*path) * 16777619u) : hash;
+}
+
+static uint32_t routeHash(const HttpSpan &path)
+{
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < path.length; i++)
+    {
+        hash = (hash ^ (uint8_t)path.data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+struct Route
+{
+    const char *path;
+    RouteHandler get;           // nullptr: method not allowed
+    RouteHandler post;
+};
+
+#define ROUTE(path, get, post) case routeHash(path): { Route route = {path, get, post}; return route; }
+
+// One hash of the path and one string compare, however many routes there are
+static Route findRoute(const HttpSpan &path)
+{
+    switch (routeHash(path))
+    {
+        ROUTE("/", handleIndexPage, nullptr)
+        ROUTE("/state.json", handleState, nullptr)
+        ROUTE("/events", handleEvents, nullptr)
+        ROUTE("/color", handleColor, handleColor)
+        ROUTE("/pattern", handlePattern, handlePattern)
+        ROUTE("/truck", handleTruck, handleTruck)
+        ROUTE("/text", handleText, handleText)
+        ROUTE("/pixels", handlePixels, handlePixels)
+        ROUTE("/clear", handleClear, handleClear)
+        ROUTE("/widget", handleWidget, handleWidget)
+        ROUTE("/weather_debug_on", handleWeatherDebugOn, handleWeatherDebugOn)
+        ROUTE("/weather_debug_off", handleWeatherDebugOff, handleWeatherDebugOff)
+        ROUTE("/weather_debug_next", handleWeatherDebugNext, handleWeatherDebugNext)
+        ROUTE("/weather_debug_status", handleWeatherDebugStatus, nullptr)
+        ROUTE("/metrics", handleMetrics, nullptr)
+        ROUTE("/status", handleStatus, nullptr)
+        ROUTE("/spotify_auth", handleSpotifyAuth, nullptr)
+        ROUTE("/spotify_token", handleSpotifyToken, handleSpotifyToken)
+        ROUTE("/spotify_url", handleSpotifyUrl, handleSpotifyUrl)
+        ROUTE("/msgraph_auth", handleMsGraphAuthPage, nullptr)
+        ROUTE("/msgraph_auth_url", handleMsGraphAuthUrl, nullptr)
+        ROUTE("/msgraph_code", handleMsGraphCodePage, handleMsGraphCode)
+        ROUTE("/token_status", handleTokenStatus, nullptr)
+    }
+    Route none = {nullptr, nullptr, nullptr};
+    return none;
+}
+
+#undef ROUTE
+
+void processRequest(WiFiClient &client, const HttpRequest &request)
+{
+    Serial.println("DEBUG: Received request: " + request.method.toString() + " " + request.path.toString());
+
+    // Another path with the same hash isn't a match
+    Route route = findRoute(request.path);
+    if (!route.path || !request.path.equals(route.path))
+    {
+        sendError(client, 404);
+        return;
+    }
+
+    bool post = request.method.equals("POST");
+    RouteHandler handler = post ? route.post : request.method.equals("GET") ? route.get : nullptr;
+    if (!handler)
+    {
+        sendError(client, 405, route.post ? "GET, POST" : "GET");
+        return;
+    }
+
+    handler(client, request, post ? request.body : request.query);
+}
@@ -4,18 +4,16 @@
 #include <WiFiNINA.h>
 #include "display_modes.h"
 #include "widgets.h"
+#include "http_request.h"
 
 // Web server object
 extern WiFiServer server;
 
 // Web server functions
 void initializeWebServer();
-void handleWebClients();
-void handleWebClient(WiFiClient client);
-void processRequest(WiFiClient client, String request);
-void sendControlPage(WiFiClient client);
-int extractParameter(String request, String param);
-String extractString(String request, String param);
+void handleWebClients();          // Never blocks: reads what has arrived and answers complete requests
+bool webClientsPending();         // A connection is open with its request still arriving
+void processRequest(WiFiClient &client, const HttpRequest &request);
 
 // Helper function for URL extraction (used for auth codes)
 String extractCodeFromURL(String url);
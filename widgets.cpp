@@ -1,23 +1,28 @@
 #include "config.h"
 #include "widgets.h"
 #include "matrix_display.h"
+#include "fetch_scheduler.h"
+#include "event_stream.h"
 
 // Widget state variables
 WidgetType currentWidget = WIDGET_WEATHER;
 
 // Widget data
-WeatherData currentWeather = {"Memphis", "TN", "US", 70, true, "Sunny", "Sun", 100, 20, "NW", 0, false};
+WeatherData currentWeather = {"Memphis", "TN", "US", 70, true, "Sunny", "Sun", 100, 20, "NW", 0, false, 1000, WeatherScene()};
 TeamsData currentTeams = {"Available", "", 0x07E0, 0}; // Green
 StockData currentStock = {"AAPL", 150.25, 2.50, true, 0};
-SpotifyTrackData currentSpotifyTrack = {"No Track", "No Artist", "", 0, 0, false, "", false, 0};
+SpotifyTrackData currentSpotifyTrack = {"No Track", "No Artist", "", 0, 0, 0, false, "", false, 0};
+
+// What the display task draws from
+Snapshot<WeatherData> weatherSnapshot;
+Snapshot<TeamsData> teamsSnapshot;
+Snapshot<SpotifyTrackData> spotifySnapshot;
 
 // Spotify widget state variables
-uint32_t lastSpotifyUpdate = 0;
 uint32_t lastSpotifyScroll = 0;
 int spotifyTitleScroll = 0;
 int spotifyArtistScroll = 0;
 bool spotifyScrollDirection = true;
-uint32_t lastSpotifyProgress = 0;
 
 void initializeWidgets()
 {
@@ -26,7 +31,11 @@ void initializeWidgets()
     currentWeather.lastUpdate = 0;
     currentTeams.lastUpdate = 0;
     currentStock.lastUpdate = 0;
-    lastSpotifyUpdate = 0;
+    classifyWeather(currentWeather);    // Scene for the placeholder data until the first fetch
+
+    weatherSnapshot.publish(currentWeather);
+    teamsSnapshot.publish(currentTeams);
+    spotifySnapshot.publish(currentSpotifyTrack);
 
     Serial.println("Widgets initialized");
 }
@@ -64,45 +73,76 @@ void drawWidget(WidgetType widget, int x, int y, int width, int height)
     }
 }
 
-void updateWidgets()
+// Advance the selected widget's animation state. Data updates from the network
+// task invalidate the widget zone themselves, so only time-driven changes show up here.
+bool tickWidget(WidgetType widget)
 {
-    uint32_t now = millis();
+    switch (widget)
+    {
+        case WIDGET_CLOCK:
+            return tickClockWidget();
+        case WIDGET_WEATHER:
+            return tickWeatherWidget();
+        case WIDGET_SPOTIFY:
+            return tickSpotifyWidget();
+        case WIDGET_TEAMS:
+        case WIDGET_STOCKS:
+        case WIDGET_NONE:
+        default:
+            return false;
+    }
+}
 
-    // Only update weather data if weather widget is selected
+// Sources are prefetched in the background, so these only redraw the widget
+// zone when the data is on screen. Open /events streams get it either way.
+void publishWeatherData()
+{
+    weatherSnapshot.publish(currentWeather);
+    markEventTopic(EVENT_TOPIC_WEATHER);
     if (currentWidget == WIDGET_WEATHER)
     {
-        if (now - currentWeather.lastUpdate > 600000 || currentWeather.lastUpdate == 0)
-        {
-            updateWeatherData();
-        }
+        invalidateWidgetZone();
     }
+}
 
-    // Only update teams data if teams widget is selected
+void publishTeamsData()
+{
+    teamsSnapshot.publish(currentTeams);
+    markEventTopic(EVENT_TOPIC_TEAMS);
     if (currentWidget == WIDGET_TEAMS)
     {
-        if (now - currentTeams.lastUpdate > 30000)
-        {
-            updateTeamsData();
-        }
+        invalidateWidgetZone();
     }
+}
 
-    // Only update stock data if stock widget is selected
-    if (currentWidget == WIDGET_STOCKS)
+void publishSpotifyData()
+{
+    spotifySnapshot.publish(currentSpotifyTrack);
+    markEventTopic(EVENT_TOPIC_SPOTIFY);
+    if (currentWidget == WIDGET_SPOTIFY)
     {
-        if (now - currentStock.lastUpdate > 60000)
-        {
-            updateStockData();
-        }
+        invalidateWidgetZone();
     }
+}
 
-    // Only update Spotify data if Spotify widget is selected
-    if (currentWidget == WIDGET_SPOTIFY)
+void updateWidgets()
+{
+    // Every configured source is kept warm, the selected widget's first;
+    // see fetch_scheduler.cpp for the intervals
+    runFetchScheduler(currentWidget);
+}
+
+bool tickClockWidget()
+{
+    // The clock only shows minutes
+    static uint32_t lastMinute = 0xFFFFFFFF;
+    uint32_t minute = millis() / 60000;
+    if (minute != lastMinute)
     {
-        if (now - lastSpotifyUpdate > 10000 || lastSpotifyUpdate == 0)
-        {
-            updateSpotifyData();
-        }
+        lastMinute = minute;
+        return true;
     }
+    return false;
 }
 
 void drawClockWidget(int x, int y, int width, int height)
@@ -114,11 +154,14 @@ void drawClockWidget(int x, int y, int width, int height)
     matrix.setTextColor(0x001F); // Blue
     matrix.setTextSize(1);
 
-    String timeStr = formatTime(false); // 12-hour format
+    char timeStr[8];
+    formatTime(timeStr, sizeof(timeStr), false); // 12-hour format
     matrix.print(timeStr);
 }
 
-String formatTime(bool is24Hour)
+// Writes e.g. "9:05A" (or "21:05") into buffer; formatted in place so the
+// clock draw doesn't touch the heap
+void formatTime(char *buffer, size_t size, bool is24Hour)
 {
     // Placeholder implementation
     uint32_t now = millis();
@@ -130,11 +173,11 @@ String formatTime(bool is24Hour)
         bool isPM = hours >= 12;
         if (hours > 12) hours -= 12;
         if (hours == 0) hours = 12;
-        return String(hours) + ":" + (minutes < 10 ? "0" : "") + String(minutes) + (isPM ? "P" : "A");
+        snprintf(buffer, size, "%d:%02d%c", hours, minutes, isPM ? 'P' : 'A');
     }
     else
     {
-        return String(hours) + ":" + (minutes < 10 ? "0" : "") + String(minutes);
+        snprintf(buffer, size, "%d:%02d", hours, minutes);
     }
 }
 
@@ -151,7 +194,8 @@ void drawStocksWidget(int x, int y, int width, int height)
 
     // Show price on second line
     matrix.setCursor(x, y + 12);
-    matrix.print("$" + String(currentStock.price, 1));
+    matrix.print("$");
+    matrix.print(currentStock.price, 1);
 }
 
 void resetWidgetZone(int x, int y, int width, int height)
@@ -166,7 +210,7 @@ void resetWidgetZone(int x, int y, int width, int height)
 
 // Status color function is now in teams_widget.cpp
 
-void updateStockData()
+bool updateStockData()
 {
     // Simulate stock data update
     currentStock.change = random(-500, 500) / 100.0; // -5.00 to +5.00
@@ -174,11 +218,19 @@ void updateStockData()
     currentStock.price += currentStock.change;
     if (currentStock.price < 50) currentStock.price = 50; // Minimum price
     currentStock.lastUpdate = millis();
+    if (currentWidget == WIDGET_STOCKS)
+    {
+        invalidateWidgetZone();
+    }
     Serial.println("Stock data updated");
+    fetchSchedulerFetched(WIDGET_STOCKS);     // Simulated, so it's fresh right away
+    return true;
 }
 
 void setWidget(WidgetType widget)
 {
     currentWidget = widget;
+    fetchSchedulerShowWidget(widget);
+    invalidateWidgetZone();
     Serial.println("Widget set to: " + String(widget));
 }
\ No newline at end of file
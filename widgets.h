@@ -2,6 +2,7 @@
 #define WIDGETS_H
 
 #include "hardware_config.h"
+#include "snapshot.h"
 
 // Widget types for upper quadrants
 enum WidgetType
@@ -19,6 +20,42 @@ enum WidgetType
 
 extern WidgetType currentWidget;
 
+// What the weather widget draws, worked out once when the weather is parsed
+enum WeatherCelestial : uint8_t
+{
+    CELESTIAL_NONE,
+    CELESTIAL_OPEN_SKY,         // Sun or moon on its own
+    CELESTIAL_BEHIND_CLOUDS     // Sun or moon further left, with light clouds
+};
+
+enum WeatherClouds : uint8_t
+{
+    CLOUDS_NONE,
+    CLOUDS_LIGHT,
+    CLOUDS_HEAVY
+};
+
+enum WeatherPrecipitation : uint8_t
+{
+    PRECIPITATION_NONE,
+    PRECIPITATION_RAIN,
+    PRECIPITATION_SNOW
+};
+
+struct WeatherScene
+{
+    WeatherCelestial celestial;
+    WeatherClouds clouds;
+    WeatherPrecipitation precipitation;
+    bool thunder;
+    bool stars;
+    uint8_t skyTopRows;         // Height of the band at the top of the sky
+    uint16_t skyColor;
+    uint16_t skyTopColor;
+    uint16_t temperatureColor;
+    uint16_t locationColor;
+};
+
 // Widget data structures
 struct WeatherData
 {
@@ -34,6 +71,8 @@ struct WeatherData
     String windDirection;
     uint32_t lastUpdate;
     bool dataValid;
+    int conditionCode;          // WeatherAPI condition.code, 0 if unknown
+    WeatherScene scene;         // Filled in by classifyWeather()
 };
 
 struct TeamsData
@@ -60,29 +99,43 @@ struct SpotifyTrackData {
     String albumName;
     int durationMs;
     int progressMs;
+    uint32_t progressAnchor;    // millis() at which progressMs was current
     bool isPlaying;
     String deviceName;
     bool dataValid;
     uint32_t lastUpdate;
 };
 
+// Working copies, owned by the network task. The display task only reads the
+// published snapshots below; call the matching publish function after a change.
 extern WeatherData currentWeather;
 extern TeamsData currentTeams;
 extern StockData currentStock;
 extern SpotifyTrackData currentSpotifyTrack;
 
+extern Snapshot<WeatherData> weatherSnapshot;
+extern Snapshot<TeamsData> teamsSnapshot;
+extern Snapshot<SpotifyTrackData> spotifySnapshot;
+
+// Publish the working copy to the display task and redraw the widget zone
+void publishWeatherData();
+void publishTeamsData();
+void publishSpotifyData();
+
 // Spotify widget timing variables
-extern uint32_t lastSpotifyUpdate;
 extern uint32_t lastSpotifyScroll;
 extern int spotifyTitleScroll;
 extern int spotifyArtistScroll;
 extern bool spotifyScrollDirection;
-extern uint32_t lastSpotifyProgress;
 
 // Widget functions
 void initializeWidgets();
 void updateWidgets();
 void drawWidget(WidgetType widget, int x, int y, int width, int height);
+bool tickWidget(WidgetType widget);     // Advance animation timers; true if the widget needs a redraw
+bool tickClockWidget();
+bool tickWeatherWidget();
+bool tickSpotifyWidget();
 void drawClockWidget(int x, int y, int width, int height);
 void drawWeatherWidget(int x, int y, int width, int height);
 void drawTeamsWidget(int x, int y, int width, int height);
@@ -94,36 +147,33 @@ bool exchangeCodeForTokens(String authCode);
 // Widget setter
 void setWidget(WidgetType widget);
 
-// Data update functions
-void updateWeatherData();
-void updateTeamsData();
-void updateStockData();
-void updateSpotifyData();
+// Data update functions, run by the fetch scheduler. They return false when
+// no request could be started
+bool updateWeatherData();
+bool updateTeamsData();
+bool updateStockData();
+bool updateSpotifyData();
 
 // Spotify specific functions
 void setSpotifyTokens(String accessToken, String refreshToken);
+bool isSpotifyConfigured();
 String getSpotifyAuthURL();
 bool exchangeCodeForTokens(String authCode);
-bool refreshSpotifyToken();
 
 // Microsoft Graph specific functions
 String getMsGraphAuthURL();
 bool exchangeMsGraphCodeForTokens(String authCode);
-bool refreshMsGraphToken();
-bool isMsGraphTokenValid();
-void setMsGraphTokens(String accessToken, String refreshToken, unsigned long expiryTime);
 
 void drawSpotifyLogo(int x, int y);
 void drawPlayingBars(int x, int y, uint16_t color);
 void drawSpotifyProgressBar(int x, int y, int width, int progress, int total);
-String base64Encode(String input);
 
 
 
 // weather animations
-void drawWeatherBackground(int x, int y, int width, int height);
-void drawWeatherElements(int x, int y, int width, int height);
-void drawWeatherText(int x, int y, int width, int height);
+void drawWeatherBackground(const WeatherData &weather, int x, int y, int width, int height);
+void drawWeatherElements(const WeatherData &weather, int x, int y, int width, int height);
+void drawWeatherText(const WeatherData &weather, int x, int y, int width, int height);
 void drawStars(int x, int y, int width, int height);
 void drawAnimatedSun(int x, int y);
 void drawMoon(int x, int y);
@@ -132,15 +182,20 @@ void drawCloudShape(int x, int y, uint16_t color);
 void drawAnimatedRain(int x, int y, int width, int height);
 void drawAnimatedSnow(int x, int y, int width, int height);
 void drawLightning(int x, int y, int width, int height);
-void drawWeatherWidgetCore(int x, int y, int width, int height);
+void drawWeatherWidgetCore(const WeatherData &weather, int x, int y, int width, int height);
+void classifyWeather(WeatherData &weather);
 
 // weather animation DEBUG mode
 void setWeatherDebugMode(bool enabled);
+bool isWeatherDebugMode();
 void advanceDebugWeather();
+void selectDebugWeather(int index);
+int getDebugWeatherCount();
+String getDebugWeatherDescription(int index);
 String getDebugWeatherInfo();
 
 // Helper functions
-String formatTime(bool is24Hour);
+void formatTime(char *buffer, size_t size, bool is24Hour);
 // Use getTeamsStatusColor from teams_widget.h instead of getStatusColor
 
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "wifi_manager.h"
 #include "matrix_display.h"
+#include "overlay.h"
 #include "credentials.h"
 
 // WiFi status tracking
@@ -97,12 +98,104 @@ bool isWiFiConnected() {
     return wifiStatus == WL_CONNECTED;
 }
 
+// Reconnection is a state machine the network task advances a step per tick,
+// so its waits never hold up HTTP, the web server or the display
+enum ReconnectState {
+    RECONNECT_IDLE,
+    RECONNECT_DISCONNECTING,    // Letting the module settle after disconnect()
+    RECONNECT_JOINING           // WiFi.begin() issued, polling the status
+};
+
+#define WIFI_CHECK_INTERVAL_MS 10000
+#define RECONNECT_RETRY_MS 30000        // After a failed reconnection
+#define DISCONNECT_SETTLE_MS 1000
+#define JOIN_TIMEOUT_MS 10000           // Per WiFi.begin()
+#define JOIN_ATTEMPTS 3                 // Per network
+
+static ReconnectState reconnectState = RECONNECT_IDLE;
+static uint32_t reconnectStateSince = 0;
+static bool joiningBackup = false;
+static int joinAttempt = 0;
+
+static void beginJoin() {
+    char *network = joiningBackup ? ssid2 : ssid;
+    joinAttempt++;
+    Serial.println("Connecting to: " + String(network) + " (attempt " + String(joinAttempt) + ")");
+
+    // Otherwise begin() itself waits up to 10 s for the association
+    WiFi.setTimeout(0);
+    wifiStatus = WiFi.begin(network, wifiPass);
+    reconnectState = RECONNECT_JOINING;
+    reconnectStateSince = millis();
+}
+
+static void finishReconnection() {
+    reconnectState = RECONNECT_IDLE;
+    reconnectionInProgress = false;
+    lastReconnectAttempt = millis();
+
+    if (wifiStatus == WL_CONNECTED) {
+        Serial.println("WiFi reconnection successful!");
+        printWiFiStatus();
+
+        // Restart the web server
+//        server.begin();
+        Serial.println("Web server restarted");
+
+        // The display task shows it on its next frame
+        postOverlay("WiFi OK", matrix.color565(0, 64, 0), 2000);
+    } else {
+        Serial.println("WiFi reconnection failed - will retry later");
+    }
+}
+
+static void stepReconnection(uint32_t now) {
+    switch (reconnectState) {
+        case RECONNECT_DISCONNECTING:
+            if (now - reconnectStateSince >= DISCONNECT_SETTLE_MS) {
+                Serial.println("Attempting to reconnect to primary network...");
+                beginJoin();
+            }
+            break;
+
+        case RECONNECT_JOINING:
+            wifiStatus = WiFi.status();
+            if (wifiStatus == WL_CONNECTED) {
+                Serial.println("Connected!");
+                finishReconnection();
+            } else if (now - reconnectStateSince >= JOIN_TIMEOUT_MS) {
+                Serial.println("Connection failed: " + getWiFiStatusString(wifiStatus));
+                if (joinAttempt < JOIN_ATTEMPTS) {
+                    beginJoin();
+                } else if (!joiningBackup && ssid2[0] != '\0') {
+                    // If primary fails and we have a backup SSID, try that
+                    Serial.println("Primary failed, trying backup network...");
+                    joiningBackup = true;
+                    joinAttempt = 0;
+                    beginJoin();
+                } else {
+                    finishReconnection();
+                }
+            }
+            break;
+
+        case RECONNECT_IDLE:
+        default:
+            break;
+    }
+}
+
+// Called on every network task tick
 void handleWiFiReconnection() {
-    Serial.println("Handling WiFi reconnection...");
     uint32_t now = millis();
 
+    if (reconnectionInProgress) {
+        stepReconnection(now);
+        return;
+    }
+
     // Check WiFi status every 10 seconds
-    if (now - lastWiFiCheck > 10000) {
+    if (now - lastWiFiCheck > WIFI_CHECK_INTERVAL_MS) {
         int currentStatus = WiFi.status();
 
         // Update our tracked status
@@ -114,66 +207,25 @@ void handleWiFiReconnection() {
 
         lastWiFiCheck = now;
 
-        // If we're not connected and not already trying to reconnect
-        if (wifiStatus != WL_CONNECTED && !reconnectionInProgress) {
-            // Don't attempt reconnection too frequently (wait at least 30 seconds between attempts)
-            if (now - lastReconnectAttempt > 30000) {
-                Serial.println("WiFi disconnected, attempting reconnection...");
-                attemptReconnection();
-                lastReconnectAttempt = now;
-            }
+        // Don't attempt reconnection too frequently (wait at least 30 seconds after a failed one)
+        if (wifiStatus != WL_CONNECTED && now - lastReconnectAttempt > RECONNECT_RETRY_MS) {
+            Serial.println("WiFi disconnected, attempting reconnection...");
+            attemptReconnection();
         }
     }
 }
 
+// Starts a reconnection; handleWiFiReconnection() carries it through
 void attemptReconnection() {
     reconnectionInProgress = true;
     Serial.println("Starting WiFi reconnection process...");
 
     // Try to disconnect cleanly first
     WiFi.disconnect();
-    delay(1000);
-
-    // Try primary SSID first
-    Serial.println("Attempting to reconnect to primary network...");
-    connectToWiFi(ssid, wifiPass);
-
-    // If primary fails and we have a backup SSID, try that
-    if (wifiStatus != WL_CONNECTED && ssid2[0] != '\0') {
-        Serial.println("Primary failed, trying backup network...");
-        connectToWiFi(ssid2, wifiPass);
-    }
-
-    if (wifiStatus == WL_CONNECTED) {
-        Serial.println("WiFi reconnection successful!");
-        printWiFiStatus();
-
-        // Restart the web server
-//        server.begin();
-        Serial.println("Web server restarted");
-
-        // Optionally show IP on matrix briefly
-        showReconnectionSuccess();
-    } else {
-        Serial.println("WiFi reconnection failed - will retry later");
-    }
-
-    reconnectionInProgress = false;
-}
-
-void showReconnectionSuccess() {
-    // Briefly flash a reconnection indicator on the matrix
-    matrix.fillRect(0, 0, 64, 8, matrix.color565(0, 64, 0)); // Green bar
-    matrix.setCursor(2, 1);
-    matrix.setTextColor(matrix.color565(255, 255, 255));
-    matrix.setTextSize(1);
-    matrix.print("WiFi OK");
-    matrix.show();
-    delay(2000);
-
-    // Clear the indicator
-    matrix.fillRect(0, 0, 64, 8, 0);
-    matrix.show();
+    joiningBackup = false;
+    joinAttempt = 0;
+    reconnectState = RECONNECT_DISCONNECTING;
+    reconnectStateSince = millis();
 }
 
 String getWiFiStatusString(int status) {
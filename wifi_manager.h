@@ -16,9 +16,8 @@ void initializeWiFi();
 void connectToWiFi(char *ssid, char *pass);
 void printWiFiStatus();
 bool isWiFiConnected();
-void handleWiFiReconnection();
+void handleWiFiReconnection();     // Network task, every tick: never waits
 void attemptReconnection();
-void showReconnectionSuccess();
 void scanNetworks();
 String getWiFiStatusString(int status);
 